@@ -0,0 +1,112 @@
+#include "messages/Message.hpp"
+#include "messages/search/AuthorPredicate.hpp"
+#include "messages/search/BadgePredicate.hpp"
+#include "messages/search/ChannelPredicate.hpp"
+#include "messages/search/MessageFlagsPredicate.hpp"
+#include "messages/search/SubtierPredicate.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+/// The number of messages a search worker checks at once
+constexpr size_t BATCH_SIZE = 512;
+
+std::vector<MessagePtr> makeMessages(size_t count)
+{
+    std::vector<MessagePtr> messages;
+    messages.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto message = std::make_shared<Message>();
+        // Roughly 100 chatters in two channels
+        message->loginName = QString("chatter%1").arg(i * 7919 % 100);
+        message->displayName = message->loginName;
+        message->channelName = i % 3 == 0 ? "pajlada" : "forsen";
+        message->badges.emplace_back("subscriber", i % 2 == 0 ? "3012" : "6");
+        if (i % 10 == 0)
+        {
+            message->badges.emplace_back("moderator", "1");
+        }
+        if (i % 50 == 0)
+        {
+            message->flags.set(MessageFlag::System);
+        }
+        messages.push_back(std::move(message));
+    }
+    return messages;
+}
+
+std::vector<std::unique_ptr<MessagePredicate>> makePredicates()
+{
+    std::vector<std::unique_ptr<MessagePredicate>> predicates;
+    predicates.push_back(std::make_unique<MessageFlagsPredicate>("system", true));
+    predicates.push_back(std::make_unique<ChannelPredicate>("forsen", false));
+    predicates.push_back(
+        std::make_unique<AuthorPredicate>("chatter1,chatter2,chatter3", true));
+    predicates.push_back(std::make_unique<BadgePredicate>("vip,mod", true));
+    predicates.push_back(std::make_unique<SubtierPredicate>("1,2", false));
+    return predicates;
+}
+
+}  // namespace
+
+static void BM_MessagePredicates_AppliesTo(benchmark::State &state)
+{
+    auto messages = makeMessages(static_cast<size_t>(state.range(0)));
+    auto predicates = makePredicates();
+
+    for (auto _ : state)
+    {
+        size_t accepted = 0;
+        for (const auto &message : messages)
+        {
+            accepted += std::all_of(predicates.begin(), predicates.end(),
+                                    [&](const auto &predicate) {
+                                        return predicate->appliesTo(*message);
+                                    })
+                            ? 1
+                            : 0;
+        }
+        benchmark::DoNotOptimize(accepted);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_MessagePredicates_Filter(benchmark::State &state)
+{
+    auto messages = makeMessages(static_cast<size_t>(state.range(0)));
+    auto predicates = makePredicates();
+
+    for (auto _ : state)
+    {
+        size_t accepted = 0;
+        for (size_t begin = 0; begin < messages.size(); begin += BATCH_SIZE)
+        {
+            std::span<const MessagePtr> batch(
+                messages.data() + begin,
+                std::min(BATCH_SIZE, messages.size() - begin));
+            MessageMask mask(batch.size());
+            for (const auto &predicate : predicates)
+            {
+                predicate->filter(batch, mask);
+            }
+            mask.forEachSet([&](size_t) {
+                accepted++;
+            });
+        }
+        benchmark::DoNotOptimize(accepted);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_MessagePredicates_AppliesTo)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_MessagePredicates_Filter)->Arg(1000)->Arg(10000);
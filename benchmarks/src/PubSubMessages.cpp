@@ -0,0 +1,52 @@
+#include "providers/twitch/pubsubmessages/Base.hpp"
+#include "providers/twitch/pubsubmessages/Message.hpp"
+#include "util/SampleData.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+#include <string>
+
+using namespace chatterino;
+
+/// The frame parsed as before: converted to a QString and back to UTF-8, with
+/// the nested message parsed from another conversion
+static void BM_PubSubMessage_QJsonDocument(benchmark::State &state)
+{
+    auto frame = getSampleChannelRewardMessage().toStdString();
+
+    for (auto _ : state)
+    {
+        auto payload = QString::fromStdString(frame);
+        auto outer = QJsonDocument::fromJson(payload.toUtf8()).object();
+        auto data = outer.value("data").toObject();
+        auto inner = QJsonDocument::fromJson(
+            data.value("message").toString().toUtf8());
+        benchmark::DoNotOptimize(outer.value("type").toString());
+        benchmark::DoNotOptimize(inner.object());
+    }
+}
+
+static void BM_PubSubMessage_JsonFrame(benchmark::State &state)
+{
+    auto original = getSampleChannelRewardMessage().toStdString();
+
+    for (auto _ : state)
+    {
+        // The frame is parsed in place, so every iteration needs a fresh one
+        // (like a new message from the websocket)
+        state.PauseTiming();
+        auto frame = original;
+        state.ResumeTiming();
+
+        auto message = parsePubSubBaseMessage(frame);
+        auto inner = message->toInner<PubSubMessageMessage>();
+        benchmark::DoNotOptimize(message->typeString);
+        benchmark::DoNotOptimize(inner->messageObject);
+    }
+}
+
+BENCHMARK(BM_PubSubMessage_QJsonDocument);
+BENCHMARK(BM_PubSubMessage_JsonFrame);
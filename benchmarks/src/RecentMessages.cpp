@@ -1,5 +1,6 @@
 #include "common/Literals.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/filters/lang/Filter.hpp"
 #include "controllers/highlights/HighlightController.hpp"
 #include "messages/Emote.hpp"
 #include "mocks/BaseApplication.hpp"
@@ -18,6 +19,7 @@
 #include "providers/seventv/SeventvEmotes.hpp"
 #include "providers/twitch/TwitchBadges.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
+#include "providers/twitch/TwitchIrcTags.hpp"
 #include "singletons/Resources.hpp"
 
 #include <benchmark/benchmark.h>
@@ -256,6 +258,141 @@ public:
     }
 };
 
+class ReadRecentMessageTags : public RecentMessages
+{
+public:
+    explicit ReadRecentMessageTags(const QString &name_)
+        : RecentMessages(name_)
+        , parsed(recentmessages::detail::parseRecentMessages(
+              this->messages.object()))
+    {
+    }
+
+    ~ReadRecentMessageTags()
+    {
+        qDeleteAll(this->parsed);
+    }
+
+    ReadRecentMessageTags(const ReadRecentMessageTags &) = delete;
+    ReadRecentMessageTags &operator=(const ReadRecentMessageTags &) = delete;
+    ReadRecentMessageTags(ReadRecentMessageTags &&) = delete;
+    ReadRecentMessageTags &operator=(ReadRecentMessageTags &&) = delete;
+
+    /// Reads the tags the message builder needs through Communi's tag map
+    void runVariantMap(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            qsizetype length = 0;
+            for (const auto *message : this->parsed)
+            {
+                const auto tags = message->tags();
+                for (const auto *key :
+                     {"user-id", "color", "badges", "badge-info", "emotes",
+                      "id", "room-id", "display-name", "tmi-sent-ts"})
+                {
+                    length += tags.value(key).toString().length();
+                }
+                length += tags.value("badges")
+                              .toString()
+                              .split(',', Qt::SkipEmptyParts)
+                              .size();
+            }
+            benchmark::DoNotOptimize(length);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                                static_cast<int64_t>(this->parsed.size()));
+    }
+
+    /// Reads the same tags through TwitchIrcTags
+    void runTwitchIrcTags(benchmark::State &state)
+    {
+        using Tag = TwitchIrcTags::Tag;
+
+        for (auto _ : state)
+        {
+            qsizetype length = 0;
+            for (const auto *message : this->parsed)
+            {
+                auto tags = TwitchIrcTags::fromMessage(message);
+                for (auto tag :
+                     {Tag::UserId, Tag::Color, Tag::Badges, Tag::BadgeInfo,
+                      Tag::Emotes, Tag::Id, Tag::RoomId, Tag::DisplayName,
+                      Tag::TmiSentTs})
+                {
+                    length += tags.value(tag).length();
+                }
+                for (auto badge : tags.value(Tag::Badges)
+                                      .tokenize(u',', Qt::SkipEmptyParts))
+                {
+                    length += badge.isEmpty() ? 0 : 1;
+                }
+            }
+            benchmark::DoNotOptimize(length);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                                static_cast<int64_t>(this->parsed.size()));
+    }
+
+private:
+    std::vector<Communi::IrcMessage *> parsed;
+};
+
+class FilterRecentMessages : public RecentMessages
+{
+public:
+    explicit FilterRecentMessages(const QString &name_)
+        : RecentMessages(name_)
+    {
+        auto parsed = recentmessages::detail::parseRecentMessages(
+            this->messages.object());
+        this->built =
+            recentmessages::detail::buildRecentMessages(parsed, &this->chan);
+
+        auto result = filters::Filter::fromString(
+            uR".(!flags.system_message && (author.subbed || author.badges contains "vip") && !(message.content match ri"^!\w+") && message.length > 3)."_s);
+        this->filter.emplace(std::move(std::get<filters::Filter>(result)));
+    }
+
+    /// Evaluates the filter with the variables read on demand
+    void run(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            size_t passed = 0;
+            for (const auto &message : this->built)
+            {
+                filters::MessageContext context(*message, &this->chan);
+                passed += this->filter->execute(context).toBool() ? 1 : 0;
+            }
+            benchmark::DoNotOptimize(passed);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                                static_cast<int64_t>(this->built.size()));
+    }
+
+    /// Evaluates the filter with a map of all variables for each message
+    void runWithContextMap(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            size_t passed = 0;
+            for (const auto &message : this->built)
+            {
+                auto context = filters::buildContextMap(message, &this->chan);
+                passed += this->filter->execute(context).toBool() ? 1 : 0;
+            }
+            benchmark::DoNotOptimize(passed);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                                static_cast<int64_t>(this->built.size()));
+    }
+
+private:
+    std::vector<MessagePtr> built;
+    std::optional<filters::Filter> filter;
+};
+
 void BM_ParseRecentMessages(benchmark::State &state, const QString &name)
 {
     ParseRecentMessages bench(name);
@@ -268,7 +405,37 @@ void BM_BuildRecentMessages(benchmark::State &state, const QString &name)
     bench.run(state);
 }
 
+void BM_ReadRecentMessageTags(benchmark::State &state, const QString &name)
+{
+    ReadRecentMessageTags bench(name);
+    bench.runVariantMap(state);
+}
+
+void BM_ReadRecentMessageTagsTwitchIrcTags(benchmark::State &state,
+                                           const QString &name)
+{
+    ReadRecentMessageTags bench(name);
+    bench.runTwitchIrcTags(state);
+}
+
+void BM_FilterRecentMessages(benchmark::State &state, const QString &name)
+{
+    FilterRecentMessages bench(name);
+    bench.run(state);
+}
+
+void BM_FilterRecentMessagesContextMap(benchmark::State &state,
+                                       const QString &name)
+{
+    FilterRecentMessages bench(name);
+    bench.runWithContextMap(state);
+}
+
 }  // namespace
 
 BENCHMARK_CAPTURE(BM_ParseRecentMessages, nymn, u"nymn"_s);
 BENCHMARK_CAPTURE(BM_BuildRecentMessages, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_ReadRecentMessageTags, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_ReadRecentMessageTagsTwitchIrcTags, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_FilterRecentMessages, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_FilterRecentMessagesContextMap, nymn, u"nymn"_s);
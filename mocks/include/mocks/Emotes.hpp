@@ -1,5 +1,6 @@
 #pragma once
 
+#include "controllers/completion/sources/EmoteIndex.hpp"
 #include "singletons/Emotes.hpp"
 
 namespace chatterino::mock {
@@ -28,11 +29,18 @@ public:
         return this->gifTimer;
     }
 
+    completion::EmoteIndexCache &getEmoteIndexCache() override
+    {
+        return this->emoteIndexCache;
+    }
+
 private:
     TwitchEmotes twitch;
     Emojis emojis;
 
     GIFTimer gifTimer;
+
+    completion::EmoteIndexCache emoteIndexCache;
 };
 
 }  // namespace chatterino::mock
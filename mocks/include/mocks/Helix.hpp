@@ -360,6 +360,17 @@ public:
          (FailureCallback<HelixGetChattersError, QString> failureCallback)),
         (override));  // getChatters
 
+    // streamChatters
+    // The extra parenthesis around the failure callback is because its type
+    // contains a comma
+    MOCK_METHOD(
+        void, streamChatters,
+        (QString broadcasterID, QString moderatorID, size_t maxChattersToFetch,
+         ResultCallback<HelixChatters> pageCallback,
+         ResultCallback<> finishedCallback,
+         (FailureCallback<HelixGetChattersError, QString> failureCallback)),
+        (override));  // streamChatters
+
     // /vips
     // The extra parenthesis around the failure callback is because its type
     // contains a comma
@@ -446,6 +457,8 @@ public:
                  (FailureCallback<QString> failureCallback)),
                 (override));
 
+    MOCK_METHOD(HelixRatelimit::State, getRatelimit, (), (const, override));
+
     MOCK_METHOD(void, update, (QString clientId, QString oauthToken),
                 (override));
 
@@ -192,7 +192,7 @@ Application::Application(Settings &_settings, const Paths &paths,
     , seventvEventAPI(makeSeventvEventAPI(_settings))
     , linkResolver(new LinkResolver)
     , streamerMode(new StreamerMode)
-    , twitchUsers(new TwitchUsers)
+    , twitchUsers(new TwitchUsers(paths))
     , pronouns(new pronouns::Pronouns)
 #ifdef CHATTERINO_HAVE_PLUGINS
     , plugins(new PluginController(paths))
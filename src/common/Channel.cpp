@@ -1,9 +1,11 @@
 #include "common/Channel.hpp"
 
 #include "Application.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageSimilarity.hpp"
+#include "messages/search/MessageSearchIndex.hpp"
 #include "singletons/Logging.hpp"
 #include "singletons/Settings.hpp"
 #include "util/ChannelHelpers.hpp"
@@ -56,6 +58,11 @@ const QString &Channel::getLocalizedName() const
     return this->getName();
 }
 
+const QString &Channel::getPlatform() const
+{
+    return this->platform_;
+}
+
 bool Channel::isTwitchChannel() const
 {
     return this->type_ >= Type::Twitch && this->type_ < Type::TwitchEnd;
@@ -76,6 +83,18 @@ LimitedQueueSnapshot<MessagePtr> Channel::getMessageSnapshot()
     return this->messages_.getSnapshot();
 }
 
+MessageSearchIndex &Channel::searchIndex()
+{
+    assertInGuiThread();
+
+    if (!this->searchIndex_)
+    {
+        this->searchIndex_ = std::make_unique<MessageSearchIndex>();
+        this->searchIndex_->rebuild(this->messages_.getSnapshot());
+    }
+    return *this->searchIndex_;
+}
+
 void Channel::addMessage(MessagePtr message, MessageContext context,
                          std::optional<MessageFlags> overridingFlags)
 {
@@ -100,8 +119,16 @@ void Channel::addMessage(MessagePtr message, MessageContext context,
 
     if (this->messages_.pushBack(message, deleted))
     {
+        if (this->searchIndex_)
+        {
+            this->searchIndex_->remove(deleted);
+        }
         this->messageRemovedFromStart(deleted);
     }
+    if (this->searchIndex_)
+    {
+        this->searchIndex_->add(message);
+    }
 
     this->messageAppended.invoke(message, overridingFlags);
 }
@@ -162,6 +189,13 @@ void Channel::addMessagesAtStart(const std::vector<MessagePtr> &_messages)
 
     if (addedMessages.size() != 0)
     {
+        if (this->searchIndex_)
+        {
+            for (const auto &message : addedMessages)
+            {
+                this->searchIndex_->add(message);
+            }
+        }
         this->messagesAddedAtStart.invoke(addedMessages);
     }
 }
@@ -179,6 +213,10 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
         // There are no messages in this channel yet so we can just insert them
         // at the front in order
         this->messages_.pushFront(messages);
+        if (this->searchIndex_)
+        {
+            this->searchIndex_->rebuild(this->messages_.getSnapshot());
+        }
         this->filledInMessages.invoke(messages);
         return;
     }
@@ -247,6 +285,13 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
 
     if (anyInserted)
     {
+        if (this->searchIndex_)
+        {
+            // Inserting into a full queue drops messages from the start
+            // without telling us which ones
+            this->searchIndex_->rebuild(this->messages_.getSnapshot());
+        }
+
         // We only invoke a signal once at the end of filling all messages to
         // prevent doing any unnecessary repaints.
         this->filledInMessages.invoke(messages);
@@ -260,6 +305,11 @@ void Channel::replaceMessage(const MessagePtr &message,
 
     if (index >= 0)
     {
+        if (this->searchIndex_)
+        {
+            this->searchIndex_->remove(message);
+            this->searchIndex_->add(replacement);
+        }
         this->messageReplaced.invoke((size_t)index, message, replacement);
     }
 }
@@ -269,6 +319,11 @@ void Channel::replaceMessage(size_t index, const MessagePtr &replacement)
     MessagePtr prev;
     if (this->messages_.replaceItem(index, replacement, &prev))
     {
+        if (this->searchIndex_)
+        {
+            this->searchIndex_->remove(prev);
+            this->searchIndex_->add(replacement);
+        }
         this->messageReplaced.invoke(index, prev, replacement);
     }
 }
@@ -279,6 +334,11 @@ void Channel::replaceMessage(size_t hint, const MessagePtr &message,
     auto index = this->messages_.replaceItem(hint, message, replacement);
     if (index >= 0)
     {
+        if (this->searchIndex_)
+        {
+            this->searchIndex_->remove(message);
+            this->searchIndex_->add(replacement);
+        }
         this->messageReplaced.invoke(hint, message, replacement);
     }
 }
@@ -295,6 +355,10 @@ void Channel::disableMessage(const QString &messageID)
 void Channel::clearMessages()
 {
     this->messages_.clear();
+    if (this->searchIndex_)
+    {
+        this->searchIndex_->clear();
+    }
     this->messagesCleared.invoke();
 }
 
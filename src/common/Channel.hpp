@@ -19,6 +19,7 @@ namespace chatterino {
 
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
+class MessageSearchIndex;
 
 enum class TimeoutStackStyle : int {
     StackHard = 0,
@@ -73,6 +74,8 @@ public:
     const QString &getName() const;
     virtual const QString &getDisplayName() const;
     virtual const QString &getLocalizedName() const;
+    /// Returns the platform this channel is logged under
+    const QString &getPlatform() const;
     bool isTwitchChannel() const;
     virtual bool isEmpty() const;
     LimitedQueueSnapshot<MessagePtr> getMessageSnapshot();
@@ -108,6 +111,12 @@ public:
 
     bool hasMessages() const;
 
+    /// @brief Returns the search index over the messages of this channel
+    ///
+    /// The index is created on first use and kept up to date afterwards.
+    /// This must only be called from the GUI thread.
+    MessageSearchIndex &searchIndex();
+
     void applySimilarityFilters(const MessagePtr &message) const final;
 
     MessageSinkTraits sinkTraits() const final;
@@ -140,6 +149,7 @@ protected:
 private:
     const QString name_;
     LimitedQueue<MessagePtr> messages_;
+    std::unique_ptr<MessageSearchIndex> searchIndex_;
     Type type_;
     bool anythingLogged_ = false;
     QTimer clearCompletionModelTimer_;
@@ -3,6 +3,7 @@
 #include "common/Channel.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
+#include "singletons/Settings.hpp"
 
 #include <QColor>
 
@@ -10,6 +11,8 @@ namespace chatterino {
 
 ChannelChatters::ChannelChatters(Channel &channel)
     : channel_(channel)
+    , chatters_(ChatterSet(static_cast<size_t>(
+          std::max(0, getSettings()->chatterCompletionLimit.getValue()))))
     , chatterColors_(ChannelChatters::maxChatterColorCount)
 {
 }
@@ -82,6 +85,25 @@ void ChannelChatters::updateOnlineChatters(
     chatters->updateOnlineChatters(usernames);
 }
 
+void ChannelChatters::beginOnlineChattersUpdate()
+{
+    auto chatters = this->chatters_.access();
+    chatters->beginOnlineChattersUpdate();
+}
+
+void ChannelChatters::addOnlineChatters(
+    const std::unordered_set<QString> &usernames, size_t total)
+{
+    auto chatters = this->chatters_.access();
+    chatters->addOnlineChatters(usernames, total);
+}
+
+void ChannelChatters::finishOnlineChattersUpdate()
+{
+    auto chatters = this->chatters_.access();
+    chatters->finishOnlineChattersUpdate();
+}
+
 size_t ChannelChatters::colorsSize() const
 {
     auto size = this->chatterColors_.access()->size();
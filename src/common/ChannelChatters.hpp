@@ -27,6 +27,13 @@ public:
     const QColor getUserColor(const QString &user);
     void setUserColor(const QString &user, const QColor &color);
     void updateOnlineChatters(const std::unordered_set<QString> &usernames);
+    /// @see ChatterSet::beginOnlineChattersUpdate()
+    void beginOnlineChattersUpdate();
+    /// @see ChatterSet::addOnlineChatters()
+    void addOnlineChatters(const std::unordered_set<QString> &usernames,
+                           size_t total);
+    /// @see ChatterSet::finishOnlineChattersUpdate()
+    void finishOnlineChattersUpdate();
 
     // colorsSize returns the amount of colors stored in `chatterColors_`
     // NOTE: This function is only meant to be used in tests and benchmarks
@@ -2,16 +2,42 @@
 
 #include "debug/Benchmark.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace chatterino {
 
 ChatterSet::ChatterSet()
-    : items(ChatterSet::CHATTER_LIMIT)
+    : ChatterSet(ChatterSet::CHATTER_LIMIT)
+{
+}
+
+ChatterSet::ChatterSet(size_t limit)
+    : limit_(std::clamp<size_t>(limit, 1, ChatterSet::MAX_CHATTER_LIMIT))
+    , items(this->limit_)
 {
 }
 
+size_t ChatterSet::limit() const
+{
+    return this->limit_;
+}
+
 void ChatterSet::addRecentChatter(const QString &userName)
 {
-    this->items.put(userName.toLower(), userName);
+    auto lowerName = userName.toLower();
+
+    if (!this->items.exists(lowerName) && this->items.size() >= this->limit_)
+    {
+        // The least recent chatter is evicted from the cache
+        this->index_.erase(std::prev(this->items.end())->first);
+    }
+
+    this->items.put(lowerName, userName);
+    this->index_[lowerName] = {
+        .userName = userName,
+        .lastSeen = ++this->clock_,
+    };
 }
 
 void ChatterSet::updateOnlineChatters(
@@ -20,7 +46,7 @@ void ChatterSet::updateOnlineChatters(
     BenchmarkGuard bench("update online chatters");
 
     // Create a new lru cache without the users that are not present anymore.
-    cache::lru_cache<QString, QString> tmp(ChatterSet::CHATTER_LIMIT);
+    cache::lru_cache<QString, QString> tmp(this->limit_);
 
     for (auto &&chatter : lowerCaseUsernames)
     {
@@ -30,13 +56,83 @@ void ChatterSet::updateOnlineChatters(
 
             // Less chatters than the limit => try to preserve as many as possible.
         }
-        else if (lowerCaseUsernames.size() < ChatterSet::CHATTER_LIMIT)
+        else if (lowerCaseUsernames.size() < this->limit_)
         {
             tmp.put(chatter, chatter);
         }
     }
 
     this->items = std::move(tmp);
+    this->rebuildIndex();
+}
+
+void ChatterSet::beginOnlineChattersUpdate()
+{
+    this->online_.clear();
+    this->deferredOnline_.clear();
+}
+
+void ChatterSet::addOnlineChatters(
+    const std::unordered_set<QString> &lowerCaseUsernames, size_t total)
+{
+    BenchmarkGuard bench("add online chatters");
+
+    for (const auto &chatter : lowerCaseUsernames)
+    {
+        this->online_.insert(chatter);
+
+        // Less chatters than the limit => try to preserve as many as possible.
+        if (this->items.exists(chatter) || total >= this->limit_)
+        {
+            continue;
+        }
+
+        if (this->items.size() < this->limit_)
+        {
+            this->addRecentChatter(chatter);
+        }
+        else
+        {
+            // Adding it now would evict someone who might still be online
+            this->deferredOnline_.push_back(chatter);
+        }
+    }
+}
+
+void ChatterSet::finishOnlineChattersUpdate()
+{
+    BenchmarkGuard bench("finish online chatters update");
+
+    // Create a new lru cache without the users that are not present anymore,
+    // keeping the order of the others.
+    std::vector<std::pair<QString, QString>> remaining;
+    for (const auto &[lowerName, userName] : this->items)
+    {
+        if (this->online_.contains(lowerName))
+        {
+            remaining.emplace_back(lowerName, userName);
+        }
+    }
+
+    cache::lru_cache<QString, QString> tmp(this->limit_);
+    for (auto it = remaining.rbegin(); it != remaining.rend(); ++it)
+    {
+        tmp.put(it->first, it->second);
+    }
+    for (const auto &chatter : this->deferredOnline_)
+    {
+        if (tmp.size() >= this->limit_)
+        {
+            break;
+        }
+        tmp.put(chatter, chatter);
+    }
+
+    this->items = std::move(tmp);
+    this->rebuildIndex();
+
+    this->online_.clear();
+    this->deferredOnline_.clear();
 }
 
 bool ChatterSet::contains(const QString &userName) const
@@ -46,15 +142,34 @@ bool ChatterSet::contains(const QString &userName) const
 
 std::vector<QString> ChatterSet::filterByPrefix(const QString &prefix) const
 {
-    QString lowerPrefix = prefix.toLower();
     std::vector<QString> result;
+    for (auto &&item : this->findByPrefix(prefix.toLower()))
+    {
+        result.push_back(std::move(item.second));
+    }
 
-    for (auto &&item : this->items)
+    return result;
+}
+
+std::vector<std::pair<QString, QString>> ChatterSet::findByPrefix(
+    const QString &lowerPrefix) const
+{
+    std::vector<const std::pair<const QString, IndexEntry> *> matches;
+    for (auto it = this->index_.lower_bound(lowerPrefix);
+         it != this->index_.end() && it->first.startsWith(lowerPrefix); ++it)
     {
-        if (item.first.startsWith(lowerPrefix))
-        {
-            result.push_back(item.second);
-        }
+        matches.push_back(&*it);
+    }
+
+    std::sort(matches.begin(), matches.end(), [](auto *a, auto *b) {
+        return a->second.lastSeen > b->second.lastSeen;
+    });
+
+    std::vector<std::pair<QString, QString>> result;
+    result.reserve(matches.size());
+    for (const auto *match : matches)
+    {
+        result.emplace_back(match->first, match->second.userName);
     }
 
     return result;
@@ -65,4 +180,20 @@ std::vector<std::pair<QString, QString>> ChatterSet::all() const
     return {this->items.begin(), this->items.end()};
 }
 
+void ChatterSet::rebuildIndex()
+{
+    this->index_.clear();
+
+    // The cache is ordered from the most to the least recent chatter
+    this->clock_ += this->items.size();
+    auto lastSeen = this->clock_;
+    for (const auto &[lowerName, userName] : this->items)
+    {
+        this->index_[lowerName] = {
+            .userName = userName,
+            .lastSeen = lastSeen--,
+        };
+    }
+}
+
 }  // namespace chatterino
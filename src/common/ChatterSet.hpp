@@ -5,6 +5,8 @@
 #include <lrucache/lrucache.hpp>
 #include <QString>
 
+#include <cstdint>
+#include <map>
 #include <unordered_set>
 #include <vector>
 
@@ -12,13 +14,25 @@ namespace chatterino {
 
 /// ChatterSet is a limited container that contains a list of recent chatters
 /// that can be referenced by name.
+///
+/// Next to the LRU cache, the chatters are kept in an ordered index by their
+/// lowercase name, so looking chatters up by a prefix only touches the
+/// matching chatters.
 class ChatterSet
 {
 public:
-    /// The limit of how many chatters can be saved for a channel.
+    /// The default limit of how many chatters can be saved for a channel.
     static constexpr size_t CHATTER_LIMIT = 2000;
+    /// The highest limit that can be configured.
+    static constexpr size_t MAX_CHATTER_LIMIT = 50000;
 
     ChatterSet();
+    /// Creates a set that saves up to @a limit chatters (at most
+    /// MAX_CHATTER_LIMIT).
+    explicit ChatterSet(size_t limit);
+
+    /// Returns how many chatters can be saved.
+    size_t limit() const;
 
     /// Inserts a user name if it isn't contained. Doesn't replace the original
     /// if the casing hasn't changed.
@@ -29,20 +43,58 @@ public:
     void updateOnlineChatters(
         const std::unordered_set<QString> &lowerCaseUsernames);
 
+    /// Starts updating the online chatters page by page. Chatters that
+    /// aren't part of any page are removed by finishOnlineChattersUpdate().
+    void beginOnlineChattersUpdate();
+
+    /// Adds a page of online chatters. Chatters that aren't in the list yet
+    /// are only added if there are less than limit() chatters online (@a
+    /// total).
+    void addOnlineChatters(
+        const std::unordered_set<QString> &lowerCaseUsernames, size_t total);
+
+    /// Removes chatters that weren't part of any page since
+    /// beginOnlineChattersUpdate().
+    void finishOnlineChattersUpdate();
+
     /// Checks if a username is in the list.
     bool contains(const QString &userName) const;
 
     /// Get filtered usernames by a prefix for autocompletion. Contained items
-    /// are in mixed case if available.
+    /// are in mixed case if available. The most recent chatters come first.
     std::vector<QString> filterByPrefix(const QString &prefix) const;
 
+    /// Get the chatters whose lowercase name starts with @a lowerPrefix in
+    /// the same format as all(). The most recent chatters come first.
+    std::vector<std::pair<QString, QString>> findByPrefix(
+        const QString &lowerPrefix) const;
+
     /// Get all recent chatters. The first pair element contains the username
     /// in lowercase, while the second pair element is the original case.
     std::vector<std::pair<QString, QString>> all() const;
 
 private:
+    struct IndexEntry {
+        /// User name in normal case
+        QString userName;
+        /// When the chatter was last added, higher is more recent
+        uint64_t lastSeen = 0;
+    };
+
+    /// Rebuilds the prefix index from the LRU cache.
+    void rebuildIndex();
+
+    size_t limit_;
     // user name in lower case -> user name in normal case
     cache::lru_cache<QString, QString> items;
+    // user name in lower case -> entry, ordered by the lowercase name
+    std::map<QString, IndexEntry> index_;
+    uint64_t clock_ = 0;
+
+    // user names in lower case that were online during the current update
+    std::unordered_set<QString> online_;
+    // online user names in lower case that didn't fit into the list yet
+    std::vector<QString> deferredOnline_;
 };
 
 using ChatterSet = ChatterSet;
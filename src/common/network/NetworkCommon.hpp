@@ -14,6 +14,10 @@ class NetworkResult;
 using NetworkSuccessCallback = std::function<void(NetworkResult)>;
 using NetworkErrorCallback = std::function<void(NetworkResult)>;
 using NetworkFinallyCallback = std::function<void()>;
+/// Called with a function that sends the request
+using NetworkGateCallback = std::function<void(std::function<void()>)>;
+using NetworkResultObserver = std::function<void(const NetworkResult &)>;
+using NetworkReleasedCallback = std::function<void()>;
 
 /**
  * @exposeenum c2.HTTPMethod
@@ -91,6 +91,12 @@ NetworkData::NetworkData()
 NetworkData::~NetworkData()
 {
     DebugCount::decrease("NetworkData");
+
+    // The data lives until the request is done, however it ended
+    if (this->isSent && this->released)
+    {
+        this->released();
+    }
 }
 
 QString NetworkData::getHash()
@@ -117,6 +123,11 @@ QString NetworkData::getHash()
 
 void NetworkData::emitSuccess(NetworkResult &&result)
 {
+    if (this->observeResult)
+    {
+        this->observeResult(result);
+    }
+
     if (!this->onSuccess)
     {
         return;
@@ -146,6 +157,11 @@ void NetworkData::emitSuccess(NetworkResult &&result)
 
 void NetworkData::emitError(NetworkResult &&result)
 {
+    if (this->observeResult)
+    {
+        this->observeResult(result);
+    }
+
     if (!this->onError)
     {
         return;
@@ -189,6 +205,8 @@ QString NetworkData::typeString() const
 
 void load(std::shared_ptr<NetworkData> &&data)
 {
+    data->isSent = true;
+
     if (data->cache)
     {
         std::ignore = QtConcurrent::run([data = std::move(data)]() mutable {
@@ -44,6 +44,11 @@ public:
     NetworkSuccessCallback onSuccess;
     NetworkErrorCallback onError;
     NetworkFinallyCallback finally;
+    NetworkGateCallback gate;
+    NetworkResultObserver observeResult;
+    /// Called when the data is destroyed after the request was sent
+    NetworkReleasedCallback released;
+    bool isSent = false;
 
     NetworkRequestType requestType = NetworkRequestType::Get;
 
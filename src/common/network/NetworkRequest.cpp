@@ -71,6 +71,24 @@ NetworkRequest NetworkRequest::finally(NetworkFinallyCallback cb) &&
     return std::move(*this);
 }
 
+NetworkRequest NetworkRequest::gate(NetworkGateCallback gate) &&
+{
+    this->data->gate = std::move(gate);
+    return std::move(*this);
+}
+
+NetworkRequest NetworkRequest::observeResult(NetworkResultObserver cb) &&
+{
+    this->data->observeResult = std::move(cb);
+    return std::move(*this);
+}
+
+NetworkRequest NetworkRequest::released(NetworkReleasedCallback cb) &&
+{
+    this->data->released = std::move(cb);
+    return std::move(*this);
+}
+
 NetworkRequest NetworkRequest::header(const char *headerName,
                                       const char *value) &&
 {
@@ -178,6 +196,15 @@ void NetworkRequest::execute()
     // Can not have a caller and be concurrent at the same time.
     assert(!(this->data->caller && this->data->executeConcurrently));
 
+    if (this->data->gate)
+    {
+        auto gate = std::move(this->data->gate);
+        gate([data = std::move(this->data)]() mutable {
+            load(std::move(data));
+        });
+        return;
+    }
+
     load(std::move(this->data));
 }
 
@@ -47,6 +47,19 @@ public:
     NetworkRequest onSuccess(NetworkSuccessCallback cb) &&;
     NetworkRequest finally(NetworkFinallyCallback cb) &&;
 
+    /// Calls @a gate with a function that sends the request when the request
+    /// is executed. The request isn't sent until that function is called,
+    /// which can happen on any thread.
+    NetworkRequest gate(NetworkGateCallback gate) &&;
+    /// @a cb is called with the result before the success or error callback.
+    /// It's called on the network thread and even if the caller is gone.
+    NetworkRequest observeResult(NetworkResultObserver cb) &&;
+    /// @a cb is called once a request that was sent is done, no matter how it
+    /// ended. Unlike the other callbacks, it's also called if the request was
+    /// cancelled or couldn't be started. It can be called on any thread.
+    /// It isn't called if the request was never sent (see #gate).
+    NetworkRequest released(NetworkReleasedCallback cb) &&;
+
     NetworkRequest payload(const QByteArray &payload) &&;
     NetworkRequest cache() &&;
     /// NetworkRequest makes sure that the `caller` object still exists when the
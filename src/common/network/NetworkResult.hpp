@@ -15,7 +15,8 @@ public:
     using NetworkError = QNetworkReply::NetworkError;
 
     NetworkResult(NetworkError error, const QVariant &httpStatusCode,
-                  QByteArray data);
+                  QByteArray data,
+                  QList<QNetworkReply::RawHeaderPair> headers = {});
 
     /// Parses the result as json and returns the root as an object.
     /// Returns empty object if parsing failed.
@@ -27,6 +28,10 @@ public:
     rapidjson::Document parseRapidJson() const;
     const QByteArray &getData() const;
 
+    /// Returns the value of the response header @a name (case-insensitive).
+    /// Returns an empty array if the header wasn't sent.
+    QByteArray rawHeader(const QByteArray &name) const;
+
     /// The error code of the reply.
     /// In case of a successful reply, this will be NoError (0)
     NetworkError error() const
@@ -46,6 +51,7 @@ public:
 
 private:
     QByteArray data_;
+    QList<QNetworkReply::RawHeaderPair> headers_;
 
     NetworkError error_;
     std::optional<int> status_;
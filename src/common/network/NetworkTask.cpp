@@ -192,7 +192,8 @@ void NetworkTask::finished()
     if (reply->error() != QNetworkReply::NoError)
     {
         this->logReply();
-        this->data_->emitError({reply->error(), status, reply->readAll()});
+        this->data_->emitError({reply->error(), status, reply->readAll(),
+                                reply->rawHeaderPairs()});
         this->data_->emitFinally();
 
         return;
@@ -207,7 +208,8 @@ void NetworkTask::finished()
 
     DebugCount::increase("http request success");
     this->logReply();
-    this->data_->emitSuccess({reply->error(), status, bytes});
+    this->data_->emitSuccess(
+        {reply->error(), status, bytes, reply->rawHeaderPairs()});
     this->data_->emitFinally();
 }
 
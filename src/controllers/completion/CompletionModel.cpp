@@ -1,6 +1,11 @@
 #include "controllers/completion/CompletionModel.hpp"
 
 #include "controllers/completion/sources/Source.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QThreadPool>
+
+#include <utility>
 
 namespace chatterino {
 
@@ -9,9 +14,19 @@ CompletionModel::CompletionModel(QObject *parent)
 {
 }
 
-void CompletionModel::setSource(std::unique_ptr<completion::Source> source)
+CompletionModel::~CompletionModel() = default;
+
+void CompletionModel::setSource(std::unique_ptr<completion::Source> source,
+                                std::shared_ptr<const void> context)
 {
     this->source_ = std::move(source);
+    this->context_ = std::move(context);
+
+    // A query that's still running keeps the previous source alive, its
+    // results are dropped
+    this->token_ = CancellationToken(false);
+    this->querying_ = false;
+    this->pendingQuery_.reset();
 }
 
 bool CompletionModel::hasSource() const
@@ -21,14 +36,59 @@ bool CompletionModel::hasSource() const
 
 void CompletionModel::updateResults(const QString &query, size_t maxCount)
 {
-    if (this->source_)
+    if (!this->source_)
     {
-        this->source_->update(query);
+        return;
+    }
 
-        // Copy results to this model
-        this->clear();
-        this->source_->addToListModel(*this, maxCount);
+    this->pendingQuery_ = Query{
+        .text = query,
+        .maxCount = maxCount,
+    };
+    if (!this->querying_)
+    {
+        this->startQuery();
     }
 }
 
+void CompletionModel::startQuery()
+{
+    auto next = std::exchange(this->pendingQuery_, std::nullopt);
+    if (!next || !this->source_)
+    {
+        return;
+    }
+
+    this->querying_ = true;
+    auto token = CancellationToken(false);
+    this->token_ = token;
+
+    QThreadPool::globalInstance()->start([this, token, query = *next,
+                                          source = this->source_,
+                                          context = this->context_]() mutable {
+        source->update(query.text);
+
+        // The source and its context are released in the GUI thread
+        postToThread([this, token, maxCount = query.maxCount,
+                      source = std::move(source),
+                      context = std::move(context)] {
+            // The token is cancelled before the model is destroyed
+            if (token.isCancelled())
+            {
+                return;
+            }
+
+            // Sources can't be queried while their results are copied
+            GenericListModel results;
+            source->addToListModel(results, maxCount);
+            this->replaceItems(results);
+
+            this->querying_ = false;
+            this->resultsUpdated.invoke();
+
+            this->startQuery();
+        });
+    });
+}
+
 }  // namespace chatterino
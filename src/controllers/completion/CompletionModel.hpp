@@ -1,10 +1,15 @@
 #pragma once
 
+#include "util/CancellationToken.hpp"
 #include "widgets/listview/GenericListModel.hpp"
 
+#include <pajlada/signals/signal.hpp>
 #include <QObject>
 #include <QString>
 
+#include <memory>
+#include <optional>
+
 namespace chatterino {
 
 namespace completion {
@@ -20,25 +25,64 @@ enum class CompletionKind {
 /// @brief CompletionModel is a GenericListModel intended to provide completion
 /// suggestions to an InputCompletionPopup. The popup can determine the appropriate
 /// source based on the current input and the user's preferences.
+///
+/// Sources are queried in a background thread, one query at a time. While a
+/// query is running, only the latest of the queries requested in the meantime
+/// is kept, so typing quickly doesn't pile up work. Sources must support this
+/// (see completion::Source::update).
 class CompletionModel final : public GenericListModel
 {
 public:
     explicit CompletionModel(QObject *parent);
+    ~CompletionModel() override;
+
+    CompletionModel(const CompletionModel &) = delete;
+    CompletionModel &operator=(const CompletionModel &) = delete;
+
+    CompletionModel(CompletionModel &&) = delete;
+    CompletionModel &operator=(CompletionModel &&) = delete;
 
     /// @brief Sets the Source for subsequent queries
+    ///
+    /// Results of queries to the previous source are discarded.
     /// @param source Source to use
-    void setSource(std::unique_ptr<completion::Source> source);
+    /// @param context Kept alive until queries to the source are done (e.g.
+    /// the channel the source reads from)
+    void setSource(std::unique_ptr<completion::Source> source,
+                   std::shared_ptr<const void> context = nullptr);
 
     /// @return Whether the model has a source set
     bool hasSource() const;
 
     /// @brief Updates the model based on the completion query
+    ///
+    /// The results are applied once the source was queried. Only rows that
+    /// changed are replaced.
     /// @param query Completion query
     /// @param maxCount Maximum number of results. Zero indicates unlimited.
     void updateResults(const QString &query, size_t maxCount = 0);
 
+    /// Invoked after the results of a query were applied
+    pajlada::Signals::NoArgSignal resultsUpdated;
+
 private:
-    std::unique_ptr<completion::Source> source_{};
+    struct Query {
+        QString text;
+        size_t maxCount = 0;
+    };
+
+    void startQuery();
+
+    std::shared_ptr<completion::Source> source_{};
+    std::shared_ptr<const void> context_{};
+
+    /// Whether the source is being queried
+    bool querying_ = false;
+    /// The latest query requested while the source was being queried
+    std::optional<Query> pendingQuery_{};
+
+    /// Cancelled when the source changes or the model is destroyed
+    ScopedCancellationToken token_;
 };
 
 };  // namespace chatterino
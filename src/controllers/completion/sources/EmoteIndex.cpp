@@ -0,0 +1,230 @@
+#include "controllers/completion/sources/EmoteIndex.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "providers/emoji/Emojis.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace chatterino::completion {
+
+std::shared_ptr<const EmoteIndex> EmoteIndexCache::forEmotes(
+    const std::shared_ptr<const EmoteMap> &emotes, const QString &providerName)
+{
+    if (!emotes || emotes->empty())
+    {
+        return nullptr;
+    }
+
+    return this->cachedIndex(
+        emotes.get(), emotes, providerName, emotes->size(), [&] {
+            std::vector<EmoteItem> items;
+            items.reserve(emotes->size());
+            for (auto &&emote : *emotes)
+            {
+                items.push_back({.emote = emote.second,
+                                 .searchName = emote.first.string,
+                                 .tabCompletionName = emote.first.string,
+                                 .displayName = emote.second->name.string,
+                                 .providerName = providerName,
+                                 .isEmoji = false});
+            }
+            return items;
+        });
+}
+
+std::shared_ptr<const EmoteIndex> EmoteIndexCache::forEmojis(
+    const std::vector<EmojiPtr> &emojis)
+{
+    if (emojis.empty())
+    {
+        return nullptr;
+    }
+
+    // The list itself isn't shared, but the emojis in it are
+    return this->cachedIndex(
+        &emojis, emojis.front(), QStringLiteral("Emoji"), emojis.size(), [&] {
+            std::vector<EmoteItem> items;
+            for (const auto &emoji : emojis)
+            {
+                for (auto &&shortCode : emoji->shortCodes)
+                {
+                    items.push_back({.emote = emoji->emote,
+                                     .searchName = shortCode,
+                                     .tabCompletionName =
+                                         QStringLiteral(":%1:").arg(shortCode),
+                                     .displayName = shortCode,
+                                     .providerName = "Emoji",
+                                     .isEmoji = true});
+                }
+            }
+            return items;
+        });
+}
+
+std::shared_ptr<const EmoteIndex> EmoteIndexCache::cachedIndex(
+    const void *source, std::weak_ptr<const void> owner,
+    const QString &providerName, size_t sourceSize,
+    const std::function<std::vector<EmoteItem>()> &makeItems)
+{
+    assertInGuiThread();
+
+    auto &entries = this->entries_;
+
+    // A source can only be reused after it expired, so dropping expired
+    // entries first makes sure the pointers below can be compared
+    std::erase_if(entries, [](const auto &entry) {
+        return entry.owner.expired();
+    });
+
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [&](const auto &entry) {
+                               return entry.source == source &&
+                                      entry.providerName == providerName;
+                           });
+    if (it == entries.end())
+    {
+        it = entries.insert(entries.end(),
+                            Entry{
+                                .source = source,
+                                .owner = std::move(owner),
+                                .providerName = providerName,
+                            });
+    }
+    else if (it->sourceSize == sourceSize && it->index)
+    {
+        return it->index;
+    }
+
+    it->sourceSize = sourceSize;
+    it->index = std::make_shared<EmoteIndex>(makeItems());
+    return it->index;
+}
+
+EmoteIndex::EmoteIndex(std::vector<EmoteItem> items)
+    : items_(std::move(items))
+{
+    this->foldedNames_.reserve(this->items_.size());
+    this->sortedItems_.reserve(this->items_.size());
+
+    for (uint32_t i = 0; i < this->items_.size(); i++)
+    {
+        const auto &folded = this->foldedNames_.emplace_back(
+            this->items_[i].searchName.toCaseFolded());
+        this->sortedItems_.push_back(i);
+
+        for (qsizetype pos = 0; pos + 2 < folded.length(); pos++)
+        {
+            auto &items = this->postings_[trigramAt(folded, pos)];
+            if (items.empty() || items.back() != i)
+            {
+                items.push_back(i);
+            }
+        }
+    }
+
+    std::sort(this->sortedItems_.begin(), this->sortedItems_.end(),
+              [this](uint32_t a, uint32_t b) {
+                  return this->foldedNames_[a] < this->foldedNames_[b];
+              });
+}
+
+const std::vector<EmoteItem> &EmoteIndex::items() const
+{
+    return this->items_;
+}
+
+void EmoteIndex::findContaining(QStringView query,
+                                std::vector<EmoteItem> &out) const
+{
+    if (query.length() < MIN_TRIGRAM_QUERY_LENGTH)
+    {
+        for (const auto &item : this->items_)
+        {
+            if (item.searchName.contains(query, Qt::CaseInsensitive))
+            {
+                out.push_back(item);
+            }
+        }
+        return;
+    }
+
+    auto folded = query.toString().toCaseFolded();
+
+    std::vector<const std::vector<uint32_t> *> lists;
+    lists.reserve(static_cast<size_t>(folded.length() - 2));
+    for (qsizetype pos = 0; pos + 2 < folded.length(); pos++)
+    {
+        auto it = this->postings_.find(trigramAt(folded, pos));
+        if (it == this->postings_.end())
+        {
+            // No item contains this trigram
+            return;
+        }
+        lists.push_back(&it->second);
+    }
+
+    std::sort(lists.begin(), lists.end(), [](auto *a, auto *b) {
+        return a->size() < b->size();
+    });
+
+    for (auto i : *lists.front())
+    {
+        bool inAll = std::all_of(lists.begin() + 1, lists.end(),
+                                 [i](const auto *items) {
+                                     return std::binary_search(
+                                         items->begin(), items->end(), i);
+                                 });
+        if (inAll &&
+            this->items_[i].searchName.contains(query, Qt::CaseInsensitive))
+        {
+            out.push_back(this->items_[i]);
+        }
+    }
+}
+
+void EmoteIndex::findStartingWith(std::initializer_list<QStringView> prefixes,
+                                  std::vector<EmoteItem> &out) const
+{
+    std::vector<uint32_t> found;
+    for (auto prefix : prefixes)
+    {
+        auto folded = prefix.toString().toCaseFolded();
+
+        // All names starting with the prefix are next to each other
+        auto it = std::lower_bound(this->sortedItems_.begin(),
+                                   this->sortedItems_.end(), folded,
+                                   [this](uint32_t i, const QString &value) {
+                                       return this->foldedNames_[i] < value;
+                                   });
+        for (; it != this->sortedItems_.end() &&
+               this->foldedNames_[*it].startsWith(folded);
+             it++)
+        {
+            if (this->items_[*it].searchName.startsWith(prefix,
+                                                        Qt::CaseInsensitive))
+            {
+                found.push_back(*it);
+            }
+        }
+    }
+
+    // Keep the order of the emote map
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+
+    out.reserve(out.size() + found.size());
+    for (auto i : found)
+    {
+        out.push_back(this->items_[i]);
+    }
+}
+
+EmoteIndex::Trigram EmoteIndex::trigramAt(const QString &text, qsizetype i)
+{
+    return (Trigram{text[i].unicode()} << 32) |
+           (Trigram{text[i + 1].unicode()} << 16) |
+           Trigram{text[i + 2].unicode()};
+}
+
+}  // namespace chatterino::completion
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "controllers/completion/sources/EmoteSource.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <QString>
+#include <QStringView>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+struct EmojiData;
+using EmojiPtr = std::shared_ptr<EmojiData>;
+
+}  // namespace chatterino
+
+namespace chatterino::completion {
+
+/// @brief Completion index over the emotes of one provider
+///
+/// Items keep the order of the emote map they were built from. The
+/// case-folded search names are kept sorted, which answers prefix queries with
+/// a binary search, and a trigram index narrows down the items containing a
+/// query. Both only produce candidates, which are checked with the same
+/// comparison the strategies use, so the results are exactly those of a
+/// linear scan.
+///
+/// Indices are immutable, they can be read from any thread. They're built
+/// through the EmoteIndexCache.
+class EmoteIndex
+{
+public:
+    /// Queries shorter than this are checked against every item
+    static constexpr qsizetype MIN_TRIGRAM_QUERY_LENGTH = 3;
+
+    explicit EmoteIndex(std::vector<EmoteItem> items);
+
+    const std::vector<EmoteItem> &items() const;
+
+    /// Appends the items whose search name contains @a query
+    /// (case-insensitively) to @a out
+    void findContaining(QStringView query, std::vector<EmoteItem> &out) const;
+
+    /// Appends the items whose search name starts with any of @a prefixes
+    /// (case-insensitively) to @a out
+    void findStartingWith(std::initializer_list<QStringView> prefixes,
+                          std::vector<EmoteItem> &out) const;
+
+private:
+    using Trigram = uint64_t;
+
+    static Trigram trigramAt(const QString &text, qsizetype i);
+
+    std::vector<EmoteItem> items_;
+    /// Case-folded search names by item
+    std::vector<QString> foldedNames_;
+    /// Items ordered by their case-folded search name
+    std::vector<uint32_t> sortedItems_;
+    /// Items containing a trigram (in ascending order)
+    boost::unordered_flat_map<Trigram, std::vector<uint32_t>> postings_;
+};
+
+/// @brief Caches the EmoteIndex of every emote map
+///
+/// Indices are cached by the emote map they were built from. All channels
+/// share the indices of global emotes, and only maps that were replaced since
+/// the last completion get indexed again.
+///
+/// The cache is owned by Emotes (see IEmotes::getEmoteIndexCache), so the
+/// emotes it references are released together with the application. It must
+/// only be used from the GUI thread.
+class EmoteIndexCache
+{
+public:
+    /// Returns the index of @a emotes, which are listed as @a providerName.
+    /// Returns nullptr if there are no emotes.
+    std::shared_ptr<const EmoteIndex> forEmotes(
+        const std::shared_ptr<const EmoteMap> &emotes,
+        const QString &providerName);
+
+    /// Returns the index of the short codes of @a emojis.
+    /// Returns nullptr if there are no emojis.
+    std::shared_ptr<const EmoteIndex> forEmojis(
+        const std::vector<EmojiPtr> &emojis);
+
+private:
+    struct Entry {
+        /// The emote map or emoji list the index was built from
+        const void *source = nullptr;
+        /// Expires together with the source
+        std::weak_ptr<const void> owner;
+        QString providerName;
+        size_t sourceSize = 0;
+        std::shared_ptr<const EmoteIndex> index;
+    };
+
+    std::shared_ptr<const EmoteIndex> cachedIndex(
+        const void *source, std::weak_ptr<const void> owner,
+        const QString &providerName, size_t sourceSize,
+        const std::function<std::vector<EmoteItem>()> &makeItems);
+
+    std::vector<Entry> entries_;
+};
+
+}  // namespace chatterino::completion
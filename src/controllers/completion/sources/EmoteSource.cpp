@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/completion/sources/EmoteIndex.hpp"
 #include "controllers/completion/sources/Helpers.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/emoji/Emojis.hpp"
@@ -14,42 +15,6 @@
 
 namespace chatterino::completion {
 
-namespace {
-
-    void addEmotes(std::vector<EmoteItem> &out, const EmoteMap &map,
-                   const QString &providerName)
-    {
-        for (auto &&emote : map)
-        {
-            out.push_back({.emote = emote.second,
-                           .searchName = emote.first.string,
-                           .tabCompletionName = emote.first.string,
-                           .displayName = emote.second->name.string,
-                           .providerName = providerName,
-                           .isEmoji = false});
-        }
-    }
-
-    void addEmojis(std::vector<EmoteItem> &out,
-                   const std::vector<EmojiPtr> &map)
-    {
-        for (const auto &emoji : map)
-        {
-            for (auto &&shortCode : emoji->shortCodes)
-            {
-                out.push_back(
-                    {.emote = emoji->emote,
-                     .searchName = shortCode,
-                     .tabCompletionName = QStringLiteral(":%1:").arg(shortCode),
-                     .displayName = shortCode,
-                     .providerName = "Emoji",
-                     .isEmoji = true});
-            }
-        };
-    }
-
-}  // namespace
-
 EmoteSource::EmoteSource(const Channel *channel,
                          std::unique_ptr<EmoteStrategy> strategy,
                          ActionCallback callback)
@@ -62,10 +27,60 @@ EmoteSource::EmoteSource(const Channel *channel,
 void EmoteSource::update(const QString &query)
 {
     this->output_.clear();
-    if (this->strategy_)
+    if (!this->strategy_)
     {
-        this->strategy_->apply(this->items_, this->output_, query);
+        this->candidates_.clear();
+        return;
+    }
+
+    QStringView normalizedQuery = query;
+    if (normalizedQuery.startsWith(':'))
+    {
+        // TODO(Qt6): use sliced
+        normalizedQuery = normalizedQuery.mid(1);
+    }
+
+    bool prefixOnly = this->strategy_->prefixOnly();
+    // Emojis are matched without the colon, emotes with it
+    auto matches = [&](const EmoteItem &item) {
+        if (prefixOnly)
+        {
+            return item.searchName.startsWith(normalizedQuery,
+                                              Qt::CaseInsensitive) ||
+                   item.searchName.startsWith(query, Qt::CaseInsensitive);
+        }
+        return item.searchName.contains(normalizedQuery, Qt::CaseInsensitive);
+    };
+
+    // While typing, every query extends the previous one, so the emotes
+    // matching it are among the previous candidates
+    if (this->lastQuery_ && this->lastQuery_->prefixOnly == prefixOnly &&
+        query.startsWith(this->lastQuery_->text))
+    {
+        std::erase_if(this->candidates_, [&](const EmoteItem &item) {
+            return !matches(item);
+        });
+    }
+    else
+    {
+        this->candidates_.clear();
+        for (const auto &index : this->indices_)
+        {
+            if (prefixOnly)
+            {
+                index->findStartingWith({normalizedQuery, query},
+                                        this->candidates_);
+            }
+            else
+            {
+                index->findContaining(normalizedQuery, this->candidates_);
+            }
+        }
     }
+    this->lastQuery_ = {.text = query, .prefixOnly = prefixOnly};
+
+    // Strategies only look at the emotes that can match the query
+    this->strategy_->apply(this->candidates_, this->output_, query);
 }
 
 void EmoteSource::addToListModel(GenericListModel &model, size_t maxCount) const
@@ -90,53 +105,43 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
 {
     auto *app = getApp();
 
-    std::vector<EmoteItem> emotes;
+    auto &cache = app->getEmotes()->getEmoteIndexCache();
+
+    auto addEmotes = [this, &cache](const std::shared_ptr<const EmoteMap> &map,
+                                    const QString &providerName) {
+        if (auto index = cache.forEmotes(map, providerName))
+        {
+            this->indices_.push_back(std::move(index));
+        }
+    };
+
     const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
     // returns true also for special Twitch channels (/live, /mentions, /whispers, etc.)
     if (channel->isTwitchChannel())
     {
         if (tc)
         {
-            if (auto twitch = tc->localTwitchEmotes())
-            {
-                addEmotes(emotes, *twitch, "Local Twitch Emotes");
-            }
+            addEmotes(tc->localTwitchEmotes(), "Local Twitch Emotes");
 
             auto user = getApp()->getAccounts()->twitch.getCurrent();
-            addEmotes(emotes, **user->accessEmotes(), "Twitch Emote");
+            addEmotes(*user->accessEmotes(), "Twitch Emote");
 
             // TODO extract "Channel {BetterTTV,7TV,FrankerFaceZ}" text into a #define.
-            if (auto bttv = tc->bttvEmotes())
-            {
-                addEmotes(emotes, *bttv, "Channel BetterTTV");
-            }
-            if (auto ffz = tc->ffzEmotes())
-            {
-                addEmotes(emotes, *ffz, "Channel FrankerFaceZ");
-            }
-            if (auto seventv = tc->seventvEmotes())
-            {
-                addEmotes(emotes, *seventv, "Channel 7TV");
-            }
+            addEmotes(tc->bttvEmotes(), "Channel BetterTTV");
+            addEmotes(tc->ffzEmotes(), "Channel FrankerFaceZ");
+            addEmotes(tc->seventvEmotes(), "Channel 7TV");
         }
 
-        if (auto bttvG = app->getBttvEmotes()->emotes())
-        {
-            addEmotes(emotes, *bttvG, "Global BetterTTV");
-        }
-        if (auto ffzG = app->getFfzEmotes()->emotes())
-        {
-            addEmotes(emotes, *ffzG, "Global FrankerFaceZ");
-        }
-        if (auto seventvG = app->getSeventvEmotes()->globalEmotes())
-        {
-            addEmotes(emotes, *seventvG, "Global 7TV");
-        }
+        addEmotes(app->getBttvEmotes()->emotes(), "Global BetterTTV");
+        addEmotes(app->getFfzEmotes()->emotes(), "Global FrankerFaceZ");
+        addEmotes(app->getSeventvEmotes()->globalEmotes(), "Global 7TV");
     }
 
-    addEmojis(emotes, app->getEmotes()->getEmojis()->getEmojis());
-
-    this->items_ = std::move(emotes);
+    if (auto emojis =
+            cache.forEmojis(app->getEmotes()->getEmojis()->getEmojis()))
+    {
+        this->indices_.push_back(std::move(emojis));
+    }
 }
 
 const std::vector<EmoteItem> &EmoteSource::output() const
@@ -9,6 +9,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace chatterino::completion {
@@ -28,11 +29,26 @@ struct EmoteItem {
     bool isEmoji{};
 };
 
+class EmoteIndex;
+
+class EmoteStrategy : public Strategy<EmoteItem>
+{
+public:
+    /// @brief Returns true if the strategy only completes emotes that start
+    /// with the query.
+    ///
+    /// Otherwise, it may complete any emote that contains the query (without a
+    /// leading colon).
+    virtual bool prefixOnly() const
+    {
+        return false;
+    }
+};
+
 class EmoteSource : public Source
 {
 public:
     using ActionCallback = std::function<void(const QString &)>;
-    using EmoteStrategy = Strategy<EmoteItem>;
 
     /// @brief Initializes a source for EmoteItems from the given channel
     /// @param channel Channel to initialize emotes from
@@ -56,7 +72,17 @@ private:
     std::unique_ptr<EmoteStrategy> strategy_;
     ActionCallback callback_;
 
-    std::vector<EmoteItem> items_{};
+    /// Emotes available in the channel by provider, in order of priority
+    std::vector<std::shared_ptr<const EmoteIndex>> indices_{};
+    /// Emotes the strategy might complete for the last query
+    std::vector<EmoteItem> candidates_{};
+
+    struct Query {
+        QString text;
+        bool prefixOnly = false;
+    };
+    /// The query the candidates were found for
+    std::optional<Query> lastQuery_{};
     std::vector<EmoteItem> output_{};
 };
 
@@ -27,6 +27,10 @@ public:
     virtual ~Source() = default;
 
     /// @brief Updates the internal completion suggestions for the given query
+    ///
+    /// CompletionModel calls this in a background thread. Sources used there
+    /// must read the settings and channel state they need when they're built
+    /// and only touch immutable or locked data here.
     /// @param query Query to complete against
     virtual void update(const QString &query) = 0;
 
@@ -10,20 +10,57 @@ namespace chatterino::completion {
 UserSource::UserSource(const Channel *channel,
                        std::unique_ptr<UserStrategy> strategy,
                        ActionCallback callback, bool prependAt)
-    : strategy_(std::move(strategy))
+    : channel_(channel != nullptr ? channel->weak_from_this()
+                                  : std::weak_ptr<const Channel>())
+    , strategy_(std::move(strategy))
     , callback_(std::move(callback))
     , prependAt_(prependAt)
 {
-    this->initializeFromChannel(channel);
+    const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
+    if (tc && getSettings()->alwaysIncludeBroadcasterInUserCompletions)
+    {
+        this->broadcaster_ = {tc->getName(), tc->getDisplayName()};
+    }
 }
 
 void UserSource::update(const QString &query)
 {
     this->output_.clear();
-    if (this->strategy_)
+    if (!this->strategy_)
+    {
+        return;
+    }
+
+    auto channel = this->channel_.lock();
+    const auto *tc = dynamic_cast<const TwitchChannel *>(channel.get());
+    if (!tc)
     {
-        this->strategy_->apply(this->items_, this->output_, query);
+        return;
     }
+
+    QString prefix = query.toLower();
+    if (prefix.startsWith('@'))
+    {
+        prefix = prefix.mid(1);
+    }
+
+    auto items = tc->accessChatters()->findByPrefix(prefix);
+
+    if (this->broadcaster_ && this->broadcaster_->first.startsWith(prefix))
+    {
+        auto it = std::find_if(items.begin(), items.end(),
+                               [this](const UserItem &user) {
+                                   return user.first ==
+                                          this->broadcaster_->first;
+                               });
+
+        if (it == items.end())
+        {
+            items.push_back(*this->broadcaster_);
+        }
+    }
+
+    this->strategy_->apply(items, this->output_, query);
 }
 
 void UserSource::addToListModel(GenericListModel &model, size_t maxCount) const
@@ -52,30 +89,6 @@ void UserSource::addToStringList(QStringList &list, size_t maxCount,
         });
 }
 
-void UserSource::initializeFromChannel(const Channel *channel)
-{
-    const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
-    if (!tc)
-    {
-        return;
-    }
-
-    this->items_ = tc->accessChatters()->all();
-
-    if (getSettings()->alwaysIncludeBroadcasterInUserCompletions)
-    {
-        auto it = std::find_if(this->items_.begin(), this->items_.end(),
-                               [tc](const UserItem &user) {
-                                   return user.first == tc->getName();
-                               });
-
-        if (it == this->items_.end())
-        {
-            this->items_.emplace_back(tc->getName(), tc->getDisplayName());
-        }
-    }
-}
-
 const std::vector<UserItem> &UserSource::output() const
 {
     return this->output_;
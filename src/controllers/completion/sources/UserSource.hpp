@@ -8,6 +8,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -22,7 +23,13 @@ public:
     using UserStrategy = Strategy<UserItem>;
 
     /// @brief Initializes a source for UserItems from the given channel.
-    /// @param channel Channel to initialize users from. Must be a TwitchChannel
+    ///
+    /// The chatters are looked up in the channel's ChatterSet on every update,
+    /// only chatters whose name starts with the query (ignoring a leading @)
+    /// are passed to the strategy. Everything else the updates need is read
+    /// here, so updates can run in any thread.
+    ///
+    /// @param channel Channel to get users from. Must be a TwitchChannel
     /// or completion is a no-op.
     /// @param strategy Strategy to apply
     /// @param callback ActionCallback to invoke upon InputCompletionItem selection.
@@ -40,13 +47,13 @@ public:
     const std::vector<UserItem> &output() const;
 
 private:
-    void initializeFromChannel(const Channel *channel);
-
+    std::weak_ptr<const Channel> channel_;
     std::unique_ptr<UserStrategy> strategy_;
     ActionCallback callback_;
     bool prependAt_;
+    /// Name and display name of the broadcaster if they're always included
+    std::optional<UserItem> broadcaster_;
 
-    std::vector<UserItem> items_{};
     std::vector<UserItem> output_{};
 };
 
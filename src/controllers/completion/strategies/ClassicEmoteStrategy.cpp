@@ -48,6 +48,11 @@ struct CompletionEmoteOrder {
     }
 };
 
+ClassicTabEmoteStrategy::ClassicTabEmoteStrategy()
+    : prefixOnly_(getSettings()->prefixOnlyEmoteCompletion)
+{
+}
+
 void ClassicTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
                                     std::vector<EmoteItem> &output,
                                     const QString &query) const
@@ -82,8 +87,7 @@ void ClassicTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
         }
 
         if (startsWithOrContains(item.searchName, itemQuery,
-                                 Qt::CaseInsensitive,
-                                 getSettings()->prefixOnlyEmoteCompletion))
+                                 Qt::CaseInsensitive, this->prefixOnly_))
         {
             emotes.insert(item);
         }
@@ -93,4 +97,9 @@ void ClassicTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
     output.assign(emotes.begin(), emotes.end());
 }
 
+bool ClassicTabEmoteStrategy::prefixOnly() const
+{
+    return this->prefixOnly_;
+}
+
 }  // namespace chatterino::completion
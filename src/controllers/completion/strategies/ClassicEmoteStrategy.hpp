@@ -5,18 +5,26 @@
 
 namespace chatterino::completion {
 
-class ClassicEmoteStrategy : public Strategy<EmoteItem>
+class ClassicEmoteStrategy : public EmoteStrategy
 {
     void apply(const std::vector<EmoteItem> &items,
                std::vector<EmoteItem> &output,
                const QString &query) const override;
 };
 
-class ClassicTabEmoteStrategy : public Strategy<EmoteItem>
+class ClassicTabEmoteStrategy : public EmoteStrategy
 {
+public:
+    /// Reads the settings the strategy depends on
+    ClassicTabEmoteStrategy();
+
+private:
     void apply(const std::vector<EmoteItem> &items,
                std::vector<EmoteItem> &output,
                const QString &query) const override;
+    bool prefixOnly() const override;
+
+    bool prefixOnly_;
 };
 
 }  // namespace chatterino::completion
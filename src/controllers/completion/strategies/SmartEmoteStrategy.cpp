@@ -68,7 +68,7 @@ namespace {
     void completeEmotes(
         const std::vector<EmoteItem> &items, std::vector<EmoteItem> &output,
         QStringView query, bool ignoreColonForCost,
-        const std::function<bool(EmoteItem, Qt::CaseSensitivity)>
+        const std::function<bool(const EmoteItem &, Qt::CaseSensitivity)>
             &matchingFunction)
     {
         // Given these emotes: pajaW, PAJAW
@@ -128,31 +128,53 @@ namespace {
             }
         }
 
-        std::sort(output.begin(), output.end(),
-                  [query, prioritizeUpper, ignoreColonForCost](
-                      const EmoteItem &a, const EmoteItem &b) -> bool {
-                      auto tempA = a.searchName;
-                      auto tempB = b.searchName;
-                      if (ignoreColonForCost && tempA.startsWith(":"))
-                      {
-                          tempA = tempA.mid(1);
-                      }
-                      if (ignoreColonForCost && tempB.startsWith(":"))
+        // Costs are computed once per emote rather than in every comparison
+        struct RankedEmote {
+            int cost;
+            QStringView name;
+            size_t index;
+        };
+        std::vector<RankedEmote> ranked;
+        ranked.reserve(output.size());
+        for (size_t i = 0; i < output.size(); i++)
+        {
+            QStringView name = output[i].searchName;
+            if (ignoreColonForCost && name.startsWith(':'))
+            {
+                name = name.mid(1);
+            }
+            ranked.push_back({
+                .cost = costOfEmote(query, name, prioritizeUpper),
+                .name = name,
+                .index = i,
+            });
+        }
+
+        std::sort(ranked.begin(), ranked.end(),
+                  [](const RankedEmote &a, const RankedEmote &b) -> bool {
+                      if (a.cost != b.cost)
                       {
-                          tempB = tempB.mid(1);
+                          return a.cost < b.cost;
                       }
 
-                      auto costA = costOfEmote(query, tempA, prioritizeUpper);
-                      auto costB = costOfEmote(query, tempB, prioritizeUpper);
-                      if (costA == costB)
+                      // Case difference and length came up tied for (a, b), break the tie
+                      auto cmp = a.name.compare(b.name, Qt::CaseInsensitive);
+                      if (cmp != 0)
                       {
-                          // Case difference and length came up tied for (a, b), break the tie
-                          return QString::compare(tempA, tempB,
-                                                  Qt::CaseInsensitive) < 0;
+                          return cmp < 0;
                       }
 
-                      return costA < costB;
+                      // Keep the order of the providers
+                      return a.index < b.index;
                   });
+
+        std::vector<EmoteItem> sorted;
+        sorted.reserve(output.size());
+        for (const auto &emote : ranked)
+        {
+            sorted.push_back(std::move(output[emote.index]));
+        }
+        output = std::move(sorted);
     }
 }  // namespace
 
@@ -175,6 +197,11 @@ void SmartEmoteStrategy::apply(const std::vector<EmoteItem> &items,
                    });
 }
 
+SmartTabEmoteStrategy::SmartTabEmoteStrategy()
+    : prefixOnly_(getSettings()->prefixOnlyEmoteCompletion)
+{
+}
+
 void SmartTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
                                   std::vector<EmoteItem> &output,
                                   const QString &query) const
@@ -207,10 +234,14 @@ void SmartTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
                 itemQuery = query;
             }
 
-            return startsWithOrContains(
-                item.searchName, itemQuery, caseHandling,
-                getSettings()->prefixOnlyEmoteCompletion);
+            return startsWithOrContains(item.searchName, itemQuery,
+                                        caseHandling, this->prefixOnly_);
         });
 }
 
+bool SmartTabEmoteStrategy::prefixOnly() const
+{
+    return this->prefixOnly_;
+}
+
 }  // namespace chatterino::completion
@@ -5,18 +5,26 @@
 
 namespace chatterino::completion {
 
-class SmartEmoteStrategy : public Strategy<EmoteItem>
+class SmartEmoteStrategy : public EmoteStrategy
 {
     void apply(const std::vector<EmoteItem> &items,
                std::vector<EmoteItem> &output,
                const QString &query) const override;
 };
 
-class SmartTabEmoteStrategy : public Strategy<EmoteItem>
+class SmartTabEmoteStrategy : public EmoteStrategy
 {
+public:
+    /// Reads the settings the strategy depends on
+    SmartTabEmoteStrategy();
+
+private:
     void apply(const std::vector<EmoteItem> &items,
                std::vector<EmoteItem> &output,
                const QString &query) const override;
+    bool prefixOnly() const override;
+
+    bool prefixOnly_;
 };
 
 }  // namespace chatterino::completion
@@ -0,0 +1,121 @@
+#include "controllers/filters/FilterCache.hpp"
+
+#include "messages/Message.hpp"
+
+#include <boost/container_hash/hash.hpp>
+#include <QHash>
+
+#include <algorithm>
+#include <vector>
+
+namespace chatterino {
+
+FilterCache &FilterCache::instance()
+{
+    static FilterCache cache;
+    return cache;
+}
+
+std::optional<bool> FilterCache::find(const QUuid &filterID,
+                                      const MessagePtr &message)
+{
+    std::lock_guard lock(this->mutex_);
+
+    auto it = this->entries_.find(Key{filterID, message->serial});
+    if (it == this->entries_.end())
+    {
+        return std::nullopt;
+    }
+
+    const auto &entry = it->second;
+    if (entry.generation != this->generation_ ||
+        entry.flags != message->flags)
+    {
+        this->entries_.erase(it);
+        return std::nullopt;
+    }
+
+    return entry.result;
+}
+
+void FilterCache::insert(const QUuid &filterID, const MessagePtr &message,
+                         uint64_t generation, bool result)
+{
+    std::lock_guard lock(this->mutex_);
+
+    if (generation != this->generation_)
+    {
+        // A filter changed while this result was computed
+        return;
+    }
+
+    if (this->entries_.size() >= MAX_ENTRIES)
+    {
+        this->cleanUp();
+    }
+
+    this->entries_.insert_or_assign(Key{filterID, message->serial},
+                                    Entry{
+                                        .flags = message->flags,
+                                        .generation = this->generation_,
+                                        .result = result,
+                                    });
+}
+
+void FilterCache::invalidate()
+{
+    std::lock_guard lock(this->mutex_);
+
+    this->generation_++;
+    this->entries_.clear();
+}
+
+uint64_t FilterCache::generation() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->generation_;
+}
+
+size_t FilterCache::size() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->entries_.size();
+}
+
+void FilterCache::cleanUp()
+{
+    boost::unordered::erase_if(this->entries_, [this](const auto &it) {
+        return it.second.generation != this->generation_;
+    });
+
+    if (this->entries_.size() < MAX_ENTRIES / 2)
+    {
+        return;
+    }
+
+    // Serials increase with every message, the older messages are the ones
+    // most likely to be gone already
+    std::vector<uint64_t> serials;
+    serials.reserve(this->entries_.size());
+    for (const auto &it : this->entries_)
+    {
+        serials.push_back(it.first.second);
+    }
+    auto middle = serials.begin() +
+                  static_cast<std::ptrdiff_t>(serials.size() / 2);
+    std::nth_element(serials.begin(), middle, serials.end());
+    auto median = *middle;
+
+    boost::unordered::erase_if(this->entries_, [median](const auto &it) {
+        return it.first.second <= median;
+    });
+}
+
+size_t FilterCache::KeyHash::operator()(const Key &key) const
+{
+    size_t seed = qHash(key.first);
+    boost::hash_combine(seed, key.second);
+    return seed;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "messages/MessageFlag.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <QUuid>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/// @brief Remembers the results of filters on messages across all splits
+///
+/// When the same channel is open in multiple splits, or the same filter is
+/// used in multiple splits, every message would be checked against the same
+/// filter once per split (and again when messages are replaced or filled in).
+/// Results are cached by the filter's ID and the message, so each distinct
+/// filter only runs once per message.
+///
+/// All results are invalidated when any filter changes. Results are also
+/// dropped if the flags of a message changed since it was filtered.
+///
+/// Results are keyed by Message::serial and don't reference the message, so
+/// destroyed messages aren't kept alive. Once the cache is full, the results
+/// of the older half of the messages are dropped.
+class FilterCache
+{
+public:
+    /// The cache is cleaned up once it holds more than this many results
+    static constexpr size_t MAX_ENTRIES = 1 << 16;
+
+    static FilterCache &instance();
+
+    FilterCache() = default;
+
+    std::optional<bool> find(const QUuid &filterID, const MessagePtr &message);
+
+    /// Stores a result computed while the cache was at @a generation (as
+    /// returned by generation() before evaluating the filter)
+    void insert(const QUuid &filterID, const MessagePtr &message,
+                uint64_t generation, bool result);
+
+    /// Invalidates all cached results (e.g. because a filter was changed)
+    void invalidate();
+    uint64_t generation() const;
+
+    size_t size() const;
+
+private:
+    /// Filter ID and Message::serial
+    using Key = std::pair<QUuid, uint64_t>;
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct Entry {
+        MessageFlags flags;
+        uint64_t generation = 0;
+        bool result = false;
+    };
+
+    void cleanUp();
+
+    mutable std::mutex mutex_;
+    boost::unordered_flat_map<Key, Entry, KeyHash> entries_;
+    uint64_t generation_ = 0;
+};
+
+}  // namespace chatterino
@@ -58,12 +58,17 @@ bool FilterRecord::valid() const
     return this->filter_ != nullptr;
 }
 
-bool FilterRecord::filter(const filters::ContextMap &context) const
+bool FilterRecord::filter(const filters::Context &context) const
 {
     assert(this->valid());
     return this->filter_->execute(context).toBool();
 }
 
+bool FilterRecord::isCacheable() const
+{
+    return this->filter_ != nullptr && this->filter_->dependsOnMessageOnly();
+}
+
 bool FilterRecord::operator==(const FilterRecord &other) const
 {
     return std::tie(this->name_, this->filter_, this->id_) ==
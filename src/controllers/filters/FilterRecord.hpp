@@ -28,7 +28,11 @@ public:
 
     bool valid() const;
 
-    bool filter(const filters::ContextMap &context) const;
+    bool filter(const filters::Context &context) const;
+
+    /// Returns true if the results of this filter can be stored in the
+    /// FilterCache (they only depend on the message)
+    bool isCacheable() const;
 
     bool operator==(const FilterRecord &other) const;
 
@@ -1,6 +1,8 @@
 #include "controllers/filters/FilterSet.hpp"
 
+#include "controllers/filters/FilterCache.hpp"
 #include "controllers/filters/FilterRecord.hpp"
+#include "debug/Profiler.hpp"
 #include "singletons/Settings.hpp"
 
 namespace chatterino {
@@ -9,6 +11,7 @@ FilterSet::FilterSet()
 {
     this->listener_ =
         getSettings()->filterRecords.delayedItemsChanged.connect([this] {
+            FilterCache::instance().invalidate();
             this->reloadFilters();
         });
 }
@@ -26,6 +29,7 @@ FilterSet::FilterSet(const QList<QUuid> &filterIds)
 
     this->listener_ =
         getSettings()->filterRecords.delayedItemsChanged.connect([this] {
+            FilterCache::instance().invalidate();
             this->reloadFilters();
         });
 }
@@ -42,10 +46,36 @@ bool FilterSet::filter(const MessagePtr &m, ChannelPtr channel) const
         return true;
     }
 
-    filters::ContextMap context = filters::buildContextMap(m, channel.get());
-    for (const auto &f : this->filters_.values())
+    ProfileGuard profile(ProfileScope::FilterEvaluation);
+
+    auto &cache = FilterCache::instance();
+    const auto generation = cache.generation();
+
+    // Variables are only read from the message when a filter uses them
+    filters::MessageContext context(*m, channel.get());
+    for (const auto &f : this->filters_)
     {
-        if (!f->valid() || !f->filter(context))
+        if (!f->valid())
+        {
+            return false;
+        }
+
+        if (!f->isCacheable())
+        {
+            if (!f->filter(context))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        auto result = cache.find(f->getId(), m);
+        if (!result)
+        {
+            result = f->filter(context);
+            cache.insert(f->getId(), m, generation, *result);
+        }
+        if (!*result)
         {
             return false;
         }
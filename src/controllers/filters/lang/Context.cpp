@@ -0,0 +1,97 @@
+#include "controllers/filters/lang/Context.hpp"
+
+#include <QHash>
+
+#include <array>
+#include <cassert>
+
+namespace {
+
+using namespace chatterino::filters;
+
+const std::array<QString, static_cast<size_t>(Variable::Count)> IDENTIFIERS{
+    "author.badges",
+    "author.color",
+    "author.name",
+    "author.user_id",
+    "author.no_color",
+    "author.subbed",
+    "author.sub_length",
+
+    "channel.name",
+    "channel.watching",
+    "channel.live",
+
+    "flags.action",
+    "flags.highlighted",
+    "flags.points_redeemed",
+    "flags.sub_message",
+    "flags.system_message",
+    "flags.reward_message",
+    "flags.first_message",
+    "flags.elevated_message",
+    "flags.hype_chat",
+    "flags.cheer_message",
+    "flags.whisper",
+    "flags.reply",
+    "flags.automod",
+    "flags.restricted",
+    "flags.monitored",
+    "flags.shared",
+    "flags.similar",
+
+    "message.content",
+    "message.length",
+
+    "reward.title",
+    "reward.cost",
+    "reward.id",
+
+    "flags.webchat_detected",
+};
+
+const QHash<QString, Variable> &variablesByIdentifier()
+{
+    static const auto variables = [] {
+        QHash<QString, Variable> map;
+        for (size_t i = 0; i < IDENTIFIERS.size(); i++)
+        {
+            map.insert(IDENTIFIERS[i], static_cast<Variable>(i));
+        }
+        return map;
+    }();
+    return variables;
+}
+
+}  // namespace
+
+namespace chatterino::filters {
+
+std::optional<Variable> variableFromIdentifier(const QString &identifier)
+{
+    const auto &variables = variablesByIdentifier();
+    auto it = variables.find(identifier);
+    if (it == variables.end())
+    {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+QString variableToIdentifier(Variable variable)
+{
+    assert(variable < Variable::Count);
+    return IDENTIFIERS[static_cast<size_t>(variable)];
+}
+
+MapContext::MapContext(const ContextMap &map)
+    : map_(map)
+{
+}
+
+QVariant MapContext::value(Variable variable) const
+{
+    return this->map_.value(variableToIdentifier(variable));
+}
+
+}  // namespace chatterino::filters
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "controllers/filters/lang/Types.hpp"
+
+#include <QString>
+#include <QVariant>
+
+#include <bitset>
+#include <cstdint>
+#include <optional>
+
+namespace chatterino::filters {
+
+/// The identifiers that can be used in filters.
+///
+/// Identifiers are resolved to a variable when a filter is parsed, so
+/// evaluating a filter doesn't need to look anything up by name.
+enum class Variable : uint8_t {
+    AuthorBadges,
+    AuthorColor,
+    AuthorName,
+    AuthorUserID,
+    AuthorNoColor,
+    AuthorSubbed,
+    AuthorSubLength,
+
+    ChannelName,
+    ChannelWatching,
+    ChannelLive,
+
+    FlagsAction,
+    FlagsHighlighted,
+    FlagsPointsRedeemed,
+    FlagsSubMessage,
+    FlagsSystemMessage,
+    FlagsRewardMessage,
+    FlagsFirstMessage,
+    FlagsElevatedMessage,
+    FlagsHypeChat,
+    FlagsCheerMessage,
+    FlagsWhisper,
+    FlagsReply,
+    FlagsAutomod,
+    FlagsRestricted,
+    FlagsMonitored,
+    FlagsShared,
+    FlagsSimilar,
+
+    MessageContent,
+    MessageLength,
+
+    RewardTitle,
+    RewardCost,
+    RewardID,
+
+    // dankerino
+    FlagsWebchatDetected,
+
+    // don't remove this value
+    Count,
+};
+
+using VariableSet = std::bitset<static_cast<size_t>(Variable::Count)>;
+
+std::optional<Variable> variableFromIdentifier(const QString &identifier);
+QString variableToIdentifier(Variable variable);
+
+/// Provides the values of variables while a filter is evaluated
+class Context
+{
+public:
+    virtual ~Context() = default;
+
+    virtual QVariant value(Variable variable) const = 0;
+};
+
+/// A context that looks the variables up in a ContextMap
+class MapContext : public Context
+{
+public:
+    explicit MapContext(const ContextMap &map);
+
+    QVariant value(Variable variable) const override;
+
+private:
+    const ContextMap &map_;
+};
+
+}  // namespace chatterino::filters
@@ -9,6 +9,9 @@
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 namespace chatterino::filters {
 
 const QMap<QString, Type> MESSAGE_TYPING_CONTEXT{
@@ -49,142 +52,169 @@ const QMap<QString, Type> MESSAGE_TYPING_CONTEXT{
     {"flags.webchat_detected", Type::Bool},
 };
 
-ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
+MessageContext::MessageContext(const Message &message,
+                               chatterino::Channel *channel)
+    : message_(message)
+    , channel_(channel)
+{
+}
+
+QVariant MessageContext::value(Variable variable) const
 {
-    auto watchingChannel = getApp()->getTwitch()->getWatchingChannel().get();
+    assert(variable < Variable::Count);
+
+    auto &cached = this->values_[static_cast<size_t>(variable)];
+    if (!cached)
+    {
+        cached = this->read(variable);
+    }
+    return *cached;
+}
 
+QVariant MessageContext::read(Variable variable) const
+{
     /*
      * Looking to add a new identifier to filters? Here's what to do:
-     *  1. Update validIdentifiersMap in Tokenizer.cpp
-     *  2. Add the identifier to the list below
-     *  3. Add the type of the identifier to MESSAGE_TYPING_CONTEXT in Filter.hpp
-     *  4. Add the value for the identifier to the ContextMap returned by this function
-     *
-     * List of identifiers:
-     *
-     * author.badges
-     * author.color
-     * author.name
-     * author.user_id
-     * author.no_color
-     * author.subbed
-     * author.sub_length
-     *
-     * channel.name
-     * channel.watching
-     *
-     * flags.highlighted
-     * flags.points_redeemed
-     * flags.sub_message
-     * flags.system_message
-     * flags.reward_message
-     * flags.first_message
-     * flags.elevated_message
-     * flags.cheer_message
-     * flags.whisper
-     * flags.reply
-     * flags.automod
-     * flags.restricted
-     * flags.monitored
-     * flags.shared
-     *
-     * message.content
-     * message.length
-     *
-     * reward.title
-     * reward.cost
-     * reward.id
-     *
-     * dankerino:
-     * flags.webchat_detected
-     *
+     *  1. Update VALID_IDENTIFIERS_MAP in Tokenizer.cpp
+     *  2. Add a Variable and its identifier in Context.hpp/Context.cpp
+     *  3. Add the type of the identifier to MESSAGE_TYPING_CONTEXT above
+     *  4. Read the value for the variable from the message below
      */
 
     using MessageFlag = chatterino::MessageFlag;
+    const auto &m = this->message_;
 
-    QStringList badges;
-    badges.reserve(m->badges.size());
-    for (const auto &e : m->badges)
+    switch (variable)
     {
-        badges << e.key_;
+        case Variable::AuthorBadges: {
+            QStringList badges;
+            badges.reserve(static_cast<qsizetype>(m.badges.size()));
+            for (const auto &e : m.badges)
+            {
+                badges << e.key_;
+            }
+            return badges;
+        }
+        case Variable::AuthorColor:
+            return m.usernameColor;
+        case Variable::AuthorName:
+            return m.displayName;
+        case Variable::AuthorUserID:
+            return m.userID;
+        case Variable::AuthorNoColor:
+            return !m.usernameColor.isValid();
+        case Variable::AuthorSubbed:
+        case Variable::AuthorSubLength:
+            this->readSubscription();
+            return *this->values_[static_cast<size_t>(variable)];
+
+        case Variable::ChannelName:
+            return m.channelName;
+        case Variable::ChannelWatching: {
+            auto watchingChannel =
+                getApp()->getTwitch()->getWatchingChannel().get();
+            return !watchingChannel->getName().isEmpty() &&
+                   watchingChannel->getName().compare(
+                       m.channelName, Qt::CaseInsensitive) == 0;
+        }
+        case Variable::ChannelLive: {
+            auto *tc = dynamic_cast<TwitchChannel *>(this->channel_);
+            return this->channel_ && !this->channel_->isEmpty() && tc &&
+                   tc->isLive();
+        }
+
+        case Variable::FlagsAction:
+            return m.flags.has(MessageFlag::Action);
+        case Variable::FlagsHighlighted:
+            return m.flags.has(MessageFlag::Highlighted);
+        case Variable::FlagsPointsRedeemed:
+            return m.flags.has(MessageFlag::RedeemedHighlight);
+        case Variable::FlagsSubMessage:
+            return m.flags.has(MessageFlag::Subscription);
+        case Variable::FlagsSystemMessage:
+            return m.flags.has(MessageFlag::System);
+        case Variable::FlagsRewardMessage:
+            return m.flags.has(MessageFlag::RedeemedChannelPointReward);
+        case Variable::FlagsFirstMessage:
+            return m.flags.has(MessageFlag::FirstMessage);
+        case Variable::FlagsElevatedMessage:
+        case Variable::FlagsHypeChat:
+            return m.flags.has(MessageFlag::ElevatedMessage);
+        case Variable::FlagsCheerMessage:
+            return m.flags.has(MessageFlag::CheerMessage);
+        case Variable::FlagsWhisper:
+            return m.flags.has(MessageFlag::Whisper);
+        case Variable::FlagsReply:
+            return m.flags.has(MessageFlag::ReplyMessage);
+        case Variable::FlagsAutomod:
+            return m.flags.has(MessageFlag::AutoMod);
+        case Variable::FlagsRestricted:
+            return m.flags.has(MessageFlag::RestrictedMessage);
+        case Variable::FlagsMonitored:
+            return m.flags.has(MessageFlag::MonitoredMessage);
+        case Variable::FlagsShared:
+            return m.flags.has(MessageFlag::SharedMessage);
+        case Variable::FlagsSimilar:
+            return m.flags.has(MessageFlag::Similar);
+
+        case Variable::MessageContent:
+            return m.messageText;
+        case Variable::MessageLength:
+            return m.messageText.length();
+
+        case Variable::RewardTitle:
+            return m.reward != nullptr ? m.reward->title : QString("");
+        case Variable::RewardCost:
+            return m.reward != nullptr ? m.reward->cost : -1;
+        case Variable::RewardID:
+            return m.reward != nullptr ? m.reward->id : QString("");
+
+        case Variable::FlagsWebchatDetected:
+            return m.flags.has(MessageFlag::WebchatDetected);
+
+        case Variable::Count:
+            break;
     }
 
-    bool watching = !watchingChannel->getName().isEmpty() &&
-                    watchingChannel->getName().compare(
-                        m->channelName, Qt::CaseInsensitive) == 0;
+    return {};
+}
 
+void MessageContext::readSubscription() const
+{
     bool subscribed = false;
     int subLength = 0;
-    for (const auto &subBadge : {"subscriber", "founder"})
+    for (const auto *subBadge : {"subscriber", "founder"})
     {
-        if (!badges.contains(subBadge))
+        auto hasBadge = std::any_of(this->message_.badges.begin(),
+                                    this->message_.badges.end(),
+                                    [&](const auto &badge) {
+                                        return badge.key_ == subBadge;
+                                    });
+        if (!hasBadge)
         {
             continue;
         }
         subscribed = true;
-        if (m->badgeInfos.find(subBadge) != m->badgeInfos.end())
-        {
-            subLength = m->badgeInfos.at(subBadge).toInt();
-        }
-    }
-    ContextMap vars = {
-        {"author.badges", std::move(badges)},
-        {"author.color", m->usernameColor},
-        {"author.name", m->displayName},
-        {"author.user_id", m->userID},
-        {"author.no_color", !m->usernameColor.isValid()},
-        {"author.subbed", subscribed},
-        {"author.sub_length", subLength},
-
-        {"channel.name", m->channelName},
-        {"channel.watching", watching},
-
-        {"flags.action", m->flags.has(MessageFlag::Action)},
-        {"flags.highlighted", m->flags.has(MessageFlag::Highlighted)},
-        {"flags.points_redeemed", m->flags.has(MessageFlag::RedeemedHighlight)},
-        {"flags.sub_message", m->flags.has(MessageFlag::Subscription)},
-        {"flags.system_message", m->flags.has(MessageFlag::System)},
-        {"flags.reward_message",
-         m->flags.has(MessageFlag::RedeemedChannelPointReward)},
-        {"flags.first_message", m->flags.has(MessageFlag::FirstMessage)},
-        {"flags.elevated_message", m->flags.has(MessageFlag::ElevatedMessage)},
-        {"flags.hype_chat", m->flags.has(MessageFlag::ElevatedMessage)},
-        {"flags.cheer_message", m->flags.has(MessageFlag::CheerMessage)},
-        {"flags.whisper", m->flags.has(MessageFlag::Whisper)},
-        {"flags.reply", m->flags.has(MessageFlag::ReplyMessage)},
-        {"flags.automod", m->flags.has(MessageFlag::AutoMod)},
-        {"flags.restricted", m->flags.has(MessageFlag::RestrictedMessage)},
-        {"flags.monitored", m->flags.has(MessageFlag::MonitoredMessage)},
-        {"flags.shared", m->flags.has(MessageFlag::SharedMessage)},
-        {"flags.similar", m->flags.has(MessageFlag::Similar)},
-
-        {"message.content", m->messageText},
-        {"message.length", m->messageText.length()},
-
-        {"flags.webchat_detected", m->flags.has(MessageFlag::WebchatDetected)},
-    };
-    {
-        auto *tc = dynamic_cast<TwitchChannel *>(channel);
-        if (channel && !channel->isEmpty() && tc)
-        {
-            vars["channel.live"] = tc->isLive();
-        }
-        else
+        auto it = this->message_.badgeInfos.find(subBadge);
+        if (it != this->message_.badgeInfos.end())
         {
-            vars["channel.live"] = false;
+            subLength = it->second.toInt();
         }
     }
-    if (m->reward != nullptr)
-    {
-        vars["reward.title"] = m->reward->title;
-        vars["reward.cost"] = m->reward->cost;
-        vars["reward.id"] = m->reward->id;
-    }
-    else
+
+    this->values_[static_cast<size_t>(Variable::AuthorSubbed)] = subscribed;
+    this->values_[static_cast<size_t>(Variable::AuthorSubLength)] = subLength;
+}
+
+ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
+{
+    MessageContext context(*m, channel);
+
+    ContextMap vars;
+    for (size_t i = 0; i < static_cast<size_t>(Variable::Count); i++)
     {
-        vars["reward.title"] = "";
-        vars["reward.cost"] = -1;
-        vars["reward.id"] = "";
+        auto variable = static_cast<Variable>(i);
+        vars.insert(variableToIdentifier(variable), context.value(variable));
     }
     return vars;
 }
@@ -207,6 +237,7 @@ Filter::Filter(ExpressionPtr expression, Type returnType)
     : expression_(std::move(expression))
     , returnType_(returnType)
 {
+    this->expression_->collectVariables(this->variables_);
 }
 
 Type Filter::returnType() const
@@ -214,11 +245,16 @@ Type Filter::returnType() const
     return this->returnType_;
 }
 
-QVariant Filter::execute(const ContextMap &context) const
+QVariant Filter::execute(const Context &context) const
 {
     return this->expression_->execute(context);
 }
 
+QVariant Filter::execute(const ContextMap &context) const
+{
+    return this->expression_->execute(MapContext(context));
+}
+
 QString Filter::filterString() const
 {
     return this->expression_->filterString();
@@ -229,4 +265,16 @@ QString Filter::debugString(const TypingContext &context) const
     return this->expression_->debug(context);
 }
 
+const VariableSet &Filter::variables() const
+{
+    return this->variables_;
+}
+
+bool Filter::dependsOnMessageOnly() const
+{
+    return !this->variables_.test(static_cast<size_t>(Variable::ChannelLive)) &&
+           !this->variables_.test(
+               static_cast<size_t>(Variable::ChannelWatching));
+}
+
 }  // namespace chatterino::filters
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "controllers/filters/lang/Context.hpp"
 #include "controllers/filters/lang/expressions/Expression.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
 #include <QString>
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <variant>
 
 namespace chatterino {
@@ -24,6 +27,30 @@ namespace chatterino::filters {
 // i.e. if all the variables and operators being used have compatible types.
 extern const QMap<QString, Type> MESSAGE_TYPING_CONTEXT;
 
+/// Reads the variables of a message when a filter first uses them.
+///
+/// Values are cached, so one context can be shared by all filters that are
+/// evaluated on the same message.
+class MessageContext : public Context
+{
+public:
+    MessageContext(const Message &message, chatterino::Channel *channel);
+
+    QVariant value(Variable variable) const override;
+
+private:
+    QVariant read(Variable variable) const;
+    void readSubscription() const;
+
+    const Message &message_;
+    chatterino::Channel *const channel_;
+
+    mutable std::array<std::optional<QVariant>,
+                       static_cast<size_t>(Variable::Count)>
+        values_;
+};
+
+/// Builds a map of all variables of a message
 ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel);
 
 class Filter;
@@ -39,16 +66,25 @@ public:
     static FilterResult fromString(const QString &str);
 
     Type returnType() const;
+    QVariant execute(const Context &context) const;
     QVariant execute(const ContextMap &context) const;
 
     QString filterString() const;
     QString debugString(const TypingContext &context) const;
 
+    /// Returns the variables this filter references
+    const VariableSet &variables() const;
+
+    /// Returns true if the result of this filter only depends on the message
+    /// (and not on the state of its channel), so it can be cached
+    bool dependsOnMessageOnly() const;
+
 private:
     Filter(ExpressionPtr expression, Type returnType);
 
     ExpressionPtr expression_;
     Type returnType_;
+    VariableSet variables_;
 };
 
 }  // namespace chatterino::filters
@@ -49,7 +49,7 @@ BinaryOperation::BinaryOperation(TokenType op, ExpressionPtr left,
 {
 }
 
-QVariant BinaryOperation::execute(const ContextMap &context) const
+QVariant BinaryOperation::execute(const Context &context) const
 {
     auto left = this->left_->execute(context);
     auto right = this->right_->execute(context);
@@ -394,6 +394,17 @@ QString BinaryOperation::debug(const TypingContext &context) const
         .arg(possibleTypeToString(this->right_->synthesizeType(context)));
 }
 
+bool BinaryOperation::isConstant() const
+{
+    return this->left_->isConstant() && this->right_->isConstant();
+}
+
+void BinaryOperation::collectVariables(VariableSet &variables) const
+{
+    this->left_->collectVariables(variables);
+    this->right_->collectVariables(variables);
+}
+
 QString BinaryOperation::filterString() const
 {
     const auto opText = [&]() -> QString {
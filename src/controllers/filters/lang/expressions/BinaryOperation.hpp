@@ -10,10 +10,12 @@ class BinaryOperation : public Expression
 public:
     BinaryOperation(TokenType op, ExpressionPtr left, ExpressionPtr right);
 
-    QVariant execute(const ContextMap &context) const override;
+    QVariant execute(const Context &context) const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
+    bool isConstant() const override;
+    void collectVariables(VariableSet &variables) const override;
 
 private:
     TokenType op_;
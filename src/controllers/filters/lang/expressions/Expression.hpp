@@ -1,5 +1,6 @@
 #pragma once
 
+#include "controllers/filters/lang/Context.hpp"
 #include "controllers/filters/lang/Tokenizer.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
@@ -16,10 +17,22 @@ class Expression
 public:
     virtual ~Expression() = default;
 
-    virtual QVariant execute(const ContextMap &context) const = 0;
+    virtual QVariant execute(const Context &context) const = 0;
     virtual PossibleType synthesizeType(const TypingContext &context) const = 0;
     virtual QString debug(const TypingContext &context) const = 0;
     virtual QString filterString() const = 0;
+
+    /// Returns true if this expression evaluates to the same value in every
+    /// context (i.e. it doesn't reference any variable)
+    virtual bool isConstant() const
+    {
+        return false;
+    }
+
+    /// Adds the variables this expression references to @a variables
+    virtual void collectVariables(VariableSet & /*variables*/) const
+    {
+    }
 };
 
 using ExpressionPtr = std::unique_ptr<Expression>;
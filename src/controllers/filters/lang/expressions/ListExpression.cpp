@@ -1,11 +1,59 @@
 #include "controllers/filters/lang/expressions/ListExpression.hpp"
 
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino::filters;
+
+class EmptyContext : public Context
+{
+public:
+    QVariant value(Variable /*variable*/) const override
+    {
+        return {};
+    }
+};
+
+}  // namespace
+
 namespace chatterino::filters {
 
 ListExpression::ListExpression(ExpressionList &&list)
-    : list_(std::move(list)){};
+    : list_(std::move(list))
+{
+    if (this->isConstant())
+    {
+        this->constant_ = this->evaluate(EmptyContext{});
+    }
+}
+
+QVariant ListExpression::execute(const Context &context) const
+{
+    if (this->constant_)
+    {
+        return *this->constant_;
+    }
+    return this->evaluate(context);
+}
+
+bool ListExpression::isConstant() const
+{
+    return std::all_of(this->list_.begin(), this->list_.end(),
+                       [](const auto &exp) {
+                           return exp->isConstant();
+                       });
+}
+
+void ListExpression::collectVariables(VariableSet &variables) const
+{
+    for (const auto &exp : this->list_)
+    {
+        exp->collectVariables(variables);
+    }
+}
 
-QVariant ListExpression::execute(const ContextMap &context) const
+QVariant ListExpression::evaluate(const Context &context) const
 {
     QList<QVariant> results;
     bool allStrings = true;
@@ -3,6 +3,8 @@
 #include "controllers/filters/lang/expressions/Expression.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
+#include <optional>
+
 namespace chatterino::filters {
 
 class ListExpression : public Expression
@@ -10,13 +12,20 @@ class ListExpression : public Expression
 public:
     ListExpression(ExpressionList &&list);
 
-    QVariant execute(const ContextMap &context) const override;
+    QVariant execute(const Context &context) const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
+    bool isConstant() const override;
+    void collectVariables(VariableSet &variables) const override;
 
 private:
+    QVariant evaluate(const Context &context) const;
+
     ExpressionList list_;
+
+    /// Lists of literals are built once when parsing
+    std::optional<QVariant> constant_;
 };
 
 }  // namespace chatterino::filters
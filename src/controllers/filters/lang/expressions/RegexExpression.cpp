@@ -9,7 +9,7 @@ RegexExpression::RegexExpression(const QString &regex, bool caseInsensitive)
           regex, caseInsensitive ? QRegularExpression::CaseInsensitiveOption
                                  : QRegularExpression::NoPatternOption)){};
 
-QVariant RegexExpression::execute(const ContextMap & /*context*/) const
+QVariant RegexExpression::execute(const Context & /*context*/) const
 {
     return this->regex_;
 }
@@ -25,6 +25,11 @@ QString RegexExpression::debug(const TypingContext & /*context*/) const
     return QString("RegEx(%1)").arg(this->regexString_);
 }
 
+bool RegexExpression::isConstant() const
+{
+    return true;
+}
+
 QString RegexExpression::filterString() const
 {
     auto s = this->regexString_;
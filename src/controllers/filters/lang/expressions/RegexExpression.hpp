@@ -12,10 +12,11 @@ class RegexExpression : public Expression
 public:
     RegexExpression(const QString &regex, bool caseInsensitive);
 
-    QVariant execute(const ContextMap &context) const override;
+    QVariant execute(const Context &context) const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
+    bool isConstant() const override;
 
 private:
     QString regexString_;
@@ -8,7 +8,7 @@ UnaryOperation::UnaryOperation(TokenType op, ExpressionPtr right)
 {
 }
 
-QVariant UnaryOperation::execute(const ContextMap &context) const
+QVariant UnaryOperation::execute(const Context &context) const
 {
     auto right = this->right_->execute(context);
     switch (this->op_)
@@ -51,6 +51,16 @@ QString UnaryOperation::debug(const TypingContext &context) const
         .arg(possibleTypeToString(this->right_->synthesizeType(context)));
 }
 
+bool UnaryOperation::isConstant() const
+{
+    return this->right_->isConstant();
+}
+
+void UnaryOperation::collectVariables(VariableSet &variables) const
+{
+    this->right_->collectVariables(variables);
+}
+
 QString UnaryOperation::filterString() const
 {
     const auto opText = [&]() -> QString {
@@ -8,13 +8,21 @@ ValueExpression::ValueExpression(QVariant value, TokenType type)
     : value_(std::move(value))
     , type_(type)
 {
+    if (this->type_ == TokenType::IDENTIFIER)
+    {
+        this->variable_ = variableFromIdentifier(this->value_.toString());
+    }
 }
 
-QVariant ValueExpression::execute(const ContextMap &context) const
+QVariant ValueExpression::execute(const Context &context) const
 {
     if (this->type_ == TokenType::IDENTIFIER)
     {
-        return context.value(this->value_.toString());
+        if (this->variable_)
+        {
+            return context.value(*this->variable_);
+        }
+        return {};
     }
     return this->value_;
 }
@@ -51,6 +59,19 @@ QString ValueExpression::debug(const TypingContext & /*context*/) const
     return QString("Val(%1)").arg(this->value_.toString());
 }
 
+bool ValueExpression::isConstant() const
+{
+    return this->type_ != TokenType::IDENTIFIER;
+}
+
+void ValueExpression::collectVariables(VariableSet &variables) const
+{
+    if (this->variable_)
+    {
+        variables.set(static_cast<size_t>(*this->variable_));
+    }
+}
+
 QString ValueExpression::filterString() const
 {
     switch (this->type_)
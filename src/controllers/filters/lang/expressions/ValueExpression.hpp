@@ -3,6 +3,8 @@
 #include "controllers/filters/lang/expressions/Expression.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
+#include <optional>
+
 namespace chatterino::filters {
 
 class ValueExpression : public Expression
@@ -11,14 +13,19 @@ public:
     ValueExpression(QVariant value, TokenType type);
     TokenType type();
 
-    QVariant execute(const ContextMap &context) const override;
+    QVariant execute(const Context &context) const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
+    bool isConstant() const override;
+    void collectVariables(VariableSet &variables) const override;
 
 private:
     QVariant value_;
     TokenType type_;
+
+    /// The variable an identifier refers to, resolved when parsing
+    std::optional<Variable> variable_;
 };
 
 }  // namespace chatterino::filters
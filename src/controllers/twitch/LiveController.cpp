@@ -3,15 +3,66 @@
 #include "common/QLogging.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
+#include "util/DebugCount.hpp"
 #include "util/Helpers.hpp"
 
 #include <QDebug>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 namespace {
 
+using namespace chatterino;
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 const auto &LOG = chatterinoTwitchLiveController;
 
+constexpr int SECONDS_PER_DAY = 24 * 60 * 60;
+
+/// Returns true if @a now is close to the time of day the last stream started
+/// at. Many channels stream at the same time every day.
+bool isExpectedLive(const TwitchLiveController::LiveState &state,
+                    const QDateTime &now)
+{
+    if (!state.lastStarted.isValid())
+    {
+        return false;
+    }
+
+    auto diff = std::abs(state.lastStarted.toUTC().time().secsTo(
+        now.toUTC().time()));
+    diff = std::min(diff, SECONDS_PER_DAY - diff);
+
+    return std::chrono::seconds(diff) <=
+           TwitchLiveController::EXPECTED_LIVE_WINDOW;
+}
+
+void updateLiveState(TwitchLiveController::LiveState &state,
+                     const std::optional<HelixStream> &stream,
+                     const QDateTime &now)
+{
+    state.live = stream.has_value();
+    if (stream)
+    {
+        state.lastLive = now;
+        state.lastStarted =
+            QDateTime::fromString(stream->startedAt, Qt::ISODate);
+    }
+}
+
+QDateTime nextRefreshAfter(const TwitchLiveController::LiveState &state,
+                           const QDateTime &now)
+{
+    // Channels that aren't polled are refreshed once they lose their EventSub
+    // subscriptions
+    auto interval = TwitchLiveController::refreshInterval(state, now)
+                        .value_or(TwitchLiveController::REFRESH_INTERVAL);
+    return now.addSecs(interval.count());
+}
+
 }  // namespace
 
 namespace chatterino {
@@ -19,7 +70,7 @@ namespace chatterino {
 TwitchLiveController::TwitchLiveController()
 {
     QObject::connect(&this->refreshTimer, &QTimer::timeout, [this] {
-        this->request();
+        this->refresh();
     });
     this->refreshTimer.start(TwitchLiveController::REFRESH_INTERVAL);
 
@@ -54,9 +105,24 @@ void TwitchLiveController::add(const std::shared_ptr<TwitchChannel> &newChannel)
     const auto channelID = newChannel->roomId();
     assert(!channelID.isEmpty());
 
+    auto now = QDateTime::currentDateTimeUtc();
+
     {
         std::unique_lock lock(this->channelsMutex);
-        this->channels[channelID] = {.ptr = newChannel, .wasChecked = false};
+        this->channels[channelID] = {
+            .ptr = newChannel,
+            .wasChecked = false,
+            .state =
+                {
+                    .hasStreamEvents =
+                        this->onlineEventChannels.contains(channelID) &&
+                        this->offlineEventChannels.contains(channelID),
+                    .trackedSince = now,
+                },
+            // The immediate request takes care of the first refresh
+            .nextRefresh = now.addSecs(
+                TwitchLiveController::REFRESH_INTERVAL.count()),
+        };
     }
 
     {
@@ -65,21 +131,132 @@ void TwitchLiveController::add(const std::shared_ptr<TwitchChannel> &newChannel)
     }
 }
 
-void TwitchLiveController::request(std::optional<QStringList> optChannelIDs)
+void TwitchLiveController::setStreamEventSubscribed(const QString &channelID,
+                                                    StreamEvent event,
+                                                    bool subscribed)
 {
-    QStringList channelIDs;
+    std::unique_lock lock(this->channelsMutex);
 
-    if (optChannelIDs)
+    auto &eventChannels = event == StreamEvent::Online
+                              ? this->onlineEventChannels
+                              : this->offlineEventChannels;
+    if (subscribed)
     {
-        channelIDs = *optChannelIDs;
+        eventChannels.emplace(channelID);
     }
     else
+    {
+        eventChannels.erase(channelID);
+    }
+
+    auto it = this->channels.find(channelID);
+    if (it == this->channels.end())
+    {
+        return;
+    }
+
+    auto &entry = it->second;
+    entry.state.hasStreamEvents =
+        this->onlineEventChannels.contains(channelID) &&
+        this->offlineEventChannels.contains(channelID);
+    if (!entry.state.hasStreamEvents)
+    {
+        // We might have missed the channel going live while the subscription
+        // was gone
+        entry.nextRefresh = QDateTime::currentDateTimeUtc();
+    }
+}
+
+void TwitchLiveController::onStreamEvent(const QString &channelID)
+{
+    {
+        std::shared_lock lock(this->channelsMutex);
+        if (!this->channels.contains(channelID))
+        {
+            return;
+        }
+    }
+
+    std::unique_lock immediateRequestsLock(this->immediateRequestsMutex);
+    this->immediateRequests.emplace(channelID);
+}
+
+double TwitchLiveController::requestsPerMinute() const
+{
+    auto since =
+        std::chrono::steady_clock::now() - TwitchLiveController::RATE_WINDOW;
+    auto count = std::ranges::count_if(this->requestTimes, [&](auto time) {
+        return time >= since;
+    });
+
+    return static_cast<double>(count) /
+           static_cast<double>(TwitchLiveController::RATE_WINDOW.count());
+}
+
+std::optional<std::chrono::seconds> TwitchLiveController::refreshInterval(
+    const LiveState &state, const QDateTime &now)
+{
+    if (state.live)
+    {
+        // Keep the viewer count and uptime up to date
+        return TwitchLiveController::REFRESH_INTERVAL;
+    }
+
+    if (state.hasStreamEvents)
+    {
+        // EventSub tells us when the channel goes live
+        return std::nullopt;
+    }
+
+    const auto &offlineSince =
+        state.lastLive.isValid() ? state.lastLive : state.trackedSince;
+    auto offlineFor = std::chrono::seconds(offlineSince.secsTo(now));
+
+    if ((state.lastLive.isValid() &&
+         offlineFor < TwitchLiveController::RECENTLY_OFFLINE) ||
+        isExpectedLive(state, now))
+    {
+        return TwitchLiveController::REFRESH_INTERVAL;
+    }
+
+    if (offlineFor >= TwitchLiveController::LONG_OFFLINE)
+    {
+        return TwitchLiveController::LONG_OFFLINE_REFRESH_INTERVAL;
+    }
+
+    return TwitchLiveController::OFFLINE_REFRESH_INTERVAL;
+}
+
+void TwitchLiveController::refresh()
+{
+    auto now = QDateTime::currentDateTimeUtc();
+
+    // Channels due within half a tick are refreshed now, the timer doesn't
+    // fire exactly on time
+    auto dueBefore =
+        now.addSecs(TwitchLiveController::REFRESH_INTERVAL.count() / 2);
+
+    QStringList channelIDs;
+    std::vector<std::pair<QDateTime, QString>> upcoming;
+
     {
         std::shared_lock lock(this->channelsMutex);
 
-        for (const auto &channelList : this->channels)
+        for (const auto &[channelID, entry] : this->channels)
         {
-            channelIDs.append(channelList.first);
+            if (!TwitchLiveController::refreshInterval(entry.state, now))
+            {
+                continue;
+            }
+
+            if (entry.nextRefresh < dueBefore)
+            {
+                channelIDs.append(channelID);
+            }
+            else
+            {
+                upcoming.emplace_back(entry.nextRefresh, channelID);
+            }
         }
     }
 
@@ -88,11 +265,47 @@ void TwitchLiveController::request(std::optional<QStringList> optChannelIDs)
         return;
     }
 
+    // A request costs the same no matter how many channels it contains, so
+    // fill the last batch with the channels that are due next
+    auto spare = (TwitchLiveController::BATCH_SIZE -
+                  (channelIDs.size() % TwitchLiveController::BATCH_SIZE)) %
+                 TwitchLiveController::BATCH_SIZE;
+    auto fill = std::min(static_cast<size_t>(spare), upcoming.size());
+    std::partial_sort(upcoming.begin(),
+                      upcoming.begin() + static_cast<std::ptrdiff_t>(fill),
+                      upcoming.end(), [](const auto &a, const auto &b) {
+                          return a.first < b.first;
+                      });
+    for (size_t i = 0; i < fill; i++)
+    {
+        channelIDs.append(upcoming[i].second);
+    }
+
+    this->request(channelIDs);
+}
+
+void TwitchLiveController::request(const QStringList &channelIDs)
+{
+    if (channelIDs.isEmpty())
+    {
+        return;
+    }
+
     auto batches =
         splitListIntoBatches(channelIDs, TwitchLiveController::BATCH_SIZE);
 
     qCDebug(LOG) << "Make" << batches.size() << "requests";
 
+    // Every batch makes a Streams and a Channels request
+    auto requestedAt = std::chrono::steady_clock::now();
+    std::erase_if(this->requestTimes, [&](auto time) {
+        return time < requestedAt - TwitchLiveController::RATE_WINDOW;
+    });
+    this->requestTimes.insert(this->requestTimes.end(), batches.size() * 2,
+                              requestedAt);
+    DebugCount::set("Live status requests per minute",
+                    std::lround(this->requestsPerMinute()));
+
     for (const auto &batch : batches)
     {
         // TODO: Explore making this concurrent
@@ -112,6 +325,7 @@ void TwitchLiveController::request(std::optional<QStringList> optChannelIDs)
                 }
 
                 QStringList deadChannels;
+                auto now = QDateTime::currentDateTimeUtc();
 
                 {
                     std::shared_lock lock(this->channelsMutex);
@@ -122,9 +336,15 @@ void TwitchLiveController::request(std::optional<QStringList> optChannelIDs)
                         {
                             if (auto channel = it->second.ptr.lock(); channel)
                             {
-                                channel->updateStreamStatus(
-                                    result.second, !it->second.wasChecked);
-                                it->second.wasChecked = true;
+                                auto &entry = it->second;
+                                channel->updateStreamStatus(result.second,
+                                                            !entry.wasChecked);
+                                entry.wasChecked = true;
+
+                                updateLiveState(entry.state, result.second,
+                                                now);
+                                entry.nextRefresh =
+                                    nextRefreshAfter(entry.state, now);
                             }
                             else
                             {
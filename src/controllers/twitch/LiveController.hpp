@@ -2,10 +2,13 @@
 
 #include "util/QStringHash.hpp"
 
+#include <QDateTime>
 #include <QString>
 #include <QTimer>
 
 #include <chrono>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -22,15 +25,54 @@ class ITwitchLiveController
 public:
     virtual ~ITwitchLiveController() = default;
 
+    enum class StreamEvent : uint8_t {
+        Online,
+        Offline,
+    };
+
     virtual void add(const std::shared_ptr<TwitchChannel> &newChannel) = 0;
+
+    /// Called when the EventSub subscription to @a event of a channel was
+    /// created or removed
+    virtual void setStreamEventSubscribed(const QString &channelID,
+                                          StreamEvent event,
+                                          bool subscribed) = 0;
+
+    /// Called when EventSub notified us that a channel went online or offline
+    virtual void onStreamEvent(const QString &channelID) = 0;
+
+    /// Number of Helix requests made per minute, averaged over the last few
+    /// minutes
+    virtual double requestsPerMinute() const = 0;
 };
 
 class TwitchLiveController : public ITwitchLiveController
 {
 public:
-    // Controls how often all channels have their stream status refreshed
+    // Controls how often live channels have their stream status refreshed
     static constexpr std::chrono::seconds REFRESH_INTERVAL{30};
 
+    // Controls how often offline channels have their stream status refreshed
+    static constexpr std::chrono::seconds OFFLINE_REFRESH_INTERVAL{120};
+
+    // Controls how often long offline channels have their stream status
+    // refreshed
+    static constexpr std::chrono::seconds LONG_OFFLINE_REFRESH_INTERVAL{300};
+
+    // Channels that went offline this recently are refreshed as often as live
+    // channels, streams often come back after a crash
+    static constexpr std::chrono::minutes RECENTLY_OFFLINE{30};
+
+    // Channels that have been offline for this long are long offline
+    static constexpr std::chrono::hours LONG_OFFLINE{6};
+
+    // Channels are expected to go live within this long of the time of day
+    // their last stream started at
+    static constexpr std::chrono::minutes EXPECTED_LIVE_WINDOW{30};
+
+    // The request rate is averaged over this long
+    static constexpr std::chrono::minutes RATE_WINDOW{5};
+
     // Controls how quickly new channels have their stream status loaded
     static constexpr std::chrono::seconds IMMEDIATE_REQUEST_INTERVAL{1};
 
@@ -41,34 +83,74 @@ public:
      **/
     static constexpr int BATCH_SIZE{100};
 
+    /// What we know about the stream of a channel
+    struct LiveState {
+        bool live = false;
+
+        /// Whether EventSub tells us when the channel goes online and offline
+        bool hasStreamEvents = false;
+
+        /// When the channel was added
+        QDateTime trackedSince;
+
+        /// When the channel was last seen live
+        QDateTime lastLive;
+
+        /// When the last stream we saw started
+        QDateTime lastStarted;
+    };
+
     TwitchLiveController();
 
     // Add a Twitch channel to be queried for live status
     // A request is made within a few seconds if this is the first time this channel is added
     void add(const std::shared_ptr<TwitchChannel> &newChannel) override;
 
+    void setStreamEventSubscribed(const QString &channelID, StreamEvent event,
+                                  bool subscribed) override;
+
+    void onStreamEvent(const QString &channelID) override;
+
+    double requestsPerMinute() const override;
+
+    /// Returns how long to wait before refreshing a channel in @a state again,
+    /// or std::nullopt if it doesn't have to be polled
+    static std::optional<std::chrono::seconds> refreshInterval(
+        const LiveState &state, const QDateTime &now);
+
 private:
     struct ChannelEntry {
         std::weak_ptr<TwitchChannel> ptr;
         bool wasChecked = false;
+        LiveState state;
+        QDateTime nextRefresh;
     };
 
+    /**
+     * Refresh the channels that are due, and as many channels that are due
+     * soon as fit into the last batch
+     **/
+    void refresh();
+
     /**
      * Run batched Helix Channels & Stream requests for channels
-     *
-     * If a list of channel IDs is passed to request, we only make a request for those channels
-     *
-     * If no list of channels is passed to request (the default behaviour), we make requests for all channels
-     * in the `channels` map.
      **/
-    void request(std::optional<QStringList> optChannelIDs = std::nullopt);
+    void request(const QStringList &channelIDs);
 
     /**
      * List of channel IDs pointing to their Twitch Channel
      *
-     * These channels will have their stream status updated every REFRESH_INTERVAL seconds
+     * These channels will have their stream status updated every
+     * refreshInterval
      **/
     std::unordered_map<QString, ChannelEntry> channels;
+
+    /**
+     * Channels with EventSub subscriptions to stream.online and stream.offline
+     **/
+    std::unordered_set<QString> onlineEventChannels;
+    std::unordered_set<QString> offlineEventChannels;
+
     std::shared_mutex channelsMutex;
 
     /**
@@ -88,6 +170,11 @@ private:
      * Timer responsible for refreshing `immediateRequests`
      **/
     QTimer immediateRequestTimer;
+
+    /**
+     * When the requests in the last RATE_WINDOW were made
+     **/
+    std::deque<std::chrono::steady_clock::time_point> requestTimes;
 };
 
 }  // namespace chatterino
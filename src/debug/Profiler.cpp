@@ -0,0 +1,294 @@
+#include "debug/Profiler.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringBuilder>
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+using namespace chatterino;
+using namespace std::chrono;
+
+uint32_t currentThreadID()
+{
+    static std::atomic<uint32_t> nextID{1};
+    thread_local const uint32_t id = nextID.fetch_add(1);
+    return id;
+}
+
+QString formatNs(uint64_t ns)
+{
+    return QString::number(static_cast<double>(ns) / 1'000'000.0, 'f', 3) %
+           "ms";
+}
+
+}  // namespace
+
+namespace chatterino {
+
+Profiler &Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : epoch_(steady_clock::now())
+    , trace_(std::make_unique<TraceEvent[]>(TRACE_CAPACITY))
+{
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    this->enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::setOverlayEnabled(bool enabled)
+{
+    this->overlayEnabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::record(ProfileScope scope, steady_clock::time_point start,
+                      steady_clock::duration duration)
+{
+    const auto durationNs = static_cast<uint64_t>(
+        std::max<int64_t>(0, duration_cast<nanoseconds>(duration).count()));
+
+    auto &histogram = this->histograms_[static_cast<size_t>(scope)];
+    histogram.buckets[bucketFor(durationNs)].fetch_add(
+        1, std::memory_order_relaxed);
+    histogram.totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+
+    auto max = histogram.maxNs.load(std::memory_order_relaxed);
+    while (durationNs > max &&
+           !histogram.maxNs.compare_exchange_weak(max, durationNs,
+                                                  std::memory_order_relaxed))
+    {
+    }
+
+    // Events are overwritten in a ring, readers might observe a partially
+    // written event, which is acceptable for a debug export.
+    auto index =
+        this->traceHead_.fetch_add(1, std::memory_order_relaxed) %
+        TRACE_CAPACITY;
+    auto &event = this->trace_[index];
+    event.durationNs.store(-1, std::memory_order_relaxed);
+    event.startNs.store(
+        duration_cast<nanoseconds>(start - this->epoch_).count(),
+        std::memory_order_relaxed);
+    event.threadID.store(currentThreadID(), std::memory_order_relaxed);
+    event.scope.store(static_cast<uint8_t>(scope), std::memory_order_relaxed);
+    event.durationNs.store(static_cast<int64_t>(durationNs),
+                           std::memory_order_release);
+}
+
+Profiler::Summary Profiler::summary(ProfileScope scope) const
+{
+    const auto &histogram = this->histograms_[static_cast<size_t>(scope)];
+
+    Summary summary;
+    summary.totalNs = histogram.totalNs.load(std::memory_order_relaxed);
+    summary.maxNs = histogram.maxNs.load(std::memory_order_relaxed);
+
+    std::array<uint64_t, BUCKET_COUNT> buckets{};
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+        summary.count += buckets[i];
+    }
+
+    auto percentile = [&](uint64_t permille) -> uint64_t {
+        if (summary.count == 0)
+        {
+            return 0;
+        }
+
+        // rank of the wanted sample (1-based)
+        auto rank = std::max<uint64_t>(1, (summary.count * permille) / 1000);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            seen += buckets[i];
+            if (seen >= rank)
+            {
+                if (i + 1 == BUCKET_COUNT)
+                {
+                    return summary.maxNs;
+                }
+                return std::min(bucketLowerBound(i + 1), summary.maxNs);
+            }
+        }
+        return summary.maxNs;
+    };
+
+    summary.p50Ns = percentile(500);
+    summary.p90Ns = percentile(900);
+    summary.p99Ns = percentile(990);
+
+    return summary;
+}
+
+QString Profiler::getDebugText() const
+{
+    QString text;
+    for (size_t i = 0; i < static_cast<size_t>(ProfileScope::Count); i++)
+    {
+        auto scope = static_cast<ProfileScope>(i);
+        auto s = this->summary(scope);
+        if (s.count == 0)
+        {
+            text += scopeName(scope) % ": -\n";
+            continue;
+        }
+
+        text += scopeName(scope) % ": n=" % QString::number(s.count) %
+                " avg=" % formatNs(s.totalNs / s.count) % " p50=" %
+                formatNs(s.p50Ns) % " p90=" % formatNs(s.p90Ns) % " p99=" %
+                formatNs(s.p99Ns) % " max=" % formatNs(s.maxNs) % '\n';
+    }
+    return text;
+}
+
+QByteArray Profiler::toChromeTrace() const
+{
+    QJsonArray events;
+
+    const auto head = this->traceHead_.load(std::memory_order_relaxed);
+    const auto size = std::min<uint64_t>(head, TRACE_CAPACITY);
+    for (auto n = head - size; n < head; n++)
+    {
+        const auto &event = this->trace_[n % TRACE_CAPACITY];
+        auto durationNs = event.durationNs.load(std::memory_order_acquire);
+        if (durationNs < 0)
+        {
+            // currently being written
+            continue;
+        }
+
+        auto scope = static_cast<ProfileScope>(
+            event.scope.load(std::memory_order_relaxed));
+        events.append(QJsonObject{
+            {"name", scopeName(scope)},
+            {"cat", "chatterino"},
+            {"ph", "X"},
+            {"ts", static_cast<double>(
+                       event.startNs.load(std::memory_order_relaxed)) /
+                       1000.0},
+            {"dur", static_cast<double>(durationNs) / 1000.0},
+            {"pid", 1},
+            {"tid", static_cast<qint64>(
+                        event.threadID.load(std::memory_order_relaxed))},
+        });
+    }
+
+    return QJsonDocument(QJsonObject{
+                             {"traceEvents", events},
+                             {"displayTimeUnit", "ms"},
+                         })
+        .toJson(QJsonDocument::Compact);
+}
+
+void Profiler::reset()
+{
+    for (auto &histogram : this->histograms_)
+    {
+        for (auto &bucket : histogram.buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.totalNs.store(0, std::memory_order_relaxed);
+        histogram.maxNs.store(0, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < TRACE_CAPACITY; i++)
+    {
+        this->trace_[i].durationNs.store(-1, std::memory_order_relaxed);
+    }
+    this->traceHead_.store(0, std::memory_order_relaxed);
+}
+
+QString Profiler::scopeName(ProfileScope scope)
+{
+    switch (scope)
+    {
+        case ProfileScope::ViewLayout:
+            return QStringLiteral("view layout");
+        case ProfileScope::MessageLayout:
+            return QStringLiteral("message layout");
+        case ProfileScope::Paint:
+            return QStringLiteral("paint");
+        case ProfileScope::BufferUpdate:
+            return QStringLiteral("buffer update");
+        case ProfileScope::MessageBuild:
+            return QStringLiteral("message build");
+        case ProfileScope::FilterEvaluation:
+            return QStringLiteral("filter evaluation");
+        case ProfileScope::HighlightCheck:
+            return QStringLiteral("highlight check");
+        case ProfileScope::Count:
+            break;
+    }
+    return QStringLiteral("unknown");
+}
+
+size_t Profiler::bucketFor(uint64_t durationNs)
+{
+    if (durationNs < 2)
+    {
+        return static_cast<size_t>(durationNs);
+    }
+
+    const auto exponent = static_cast<size_t>(std::bit_width(durationNs) - 1);
+    const auto upperHalf = (durationNs >> (exponent - 1)) & 1;
+
+    return std::min(exponent * 2 + upperHalf, BUCKET_COUNT - 1);
+}
+
+uint64_t Profiler::bucketLowerBound(size_t bucket)
+{
+    if (bucket < 2)
+    {
+        return bucket;
+    }
+
+    const auto exponent = bucket / 2;
+    const auto upperHalf = bucket % 2;
+
+    return (uint64_t{1} << exponent) +
+           upperHalf * (uint64_t{1} << (exponent - 1));
+}
+
+ProfileGuard::ProfileGuard(ProfileScope scope, int64_t *elapsedNs)
+    : scope_(scope)
+    , elapsedNs_(elapsedNs)
+    , active_(Profiler::instance().isEnabled())
+{
+    if (this->active_ || this->elapsedNs_ != nullptr)
+    {
+        this->start_ = steady_clock::now();
+    }
+}
+
+ProfileGuard::~ProfileGuard()
+{
+    if (!this->active_ && this->elapsedNs_ == nullptr)
+    {
+        return;
+    }
+
+    auto elapsed = steady_clock::now() - this->start_;
+    if (this->elapsedNs_ != nullptr)
+    {
+        *this->elapsedNs_ = duration_cast<nanoseconds>(elapsed).count();
+    }
+    if (this->active_)
+    {
+        Profiler::instance().record(this->scope_, this->start_, elapsed);
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace chatterino {
+
+enum class ProfileScope : uint8_t {
+    /// ChannelView::performLayout
+    ViewLayout,
+    /// MessageLayout::layout when the message actually had to be laid out
+    MessageLayout,
+    /// ChannelView::paintEvent
+    Paint,
+    /// MessageLayout::updateBuffer
+    BufferUpdate,
+    /// Building a message from an IRC message
+    MessageBuild,
+    /// FilterSet::filter
+    FilterEvaluation,
+    /// HighlightController::check
+    HighlightCheck,
+
+    // don't remove this value
+    Count,
+};
+
+/// @brief Low-overhead timing of the hot paths in the GUI
+///
+/// Timings are recorded with ProfileGuard into lock-free histograms (one per
+/// ProfileScope) and a ring buffer of the most recent events, which can be
+/// exported in the Chrome trace event format (chrome://tracing, Perfetto).
+///
+/// Recording is disabled by default and can be toggled at runtime from the
+/// debug popup. While disabled, a ProfileGuard only checks an atomic flag,
+/// unless it was asked for the elapsed time.
+class Profiler
+{
+public:
+    /// Number of histogram buckets, each power of two is split in half
+    static constexpr size_t BUCKET_COUNT = 64;
+    /// Number of events kept for the trace export
+    static constexpr size_t TRACE_CAPACITY = 16384;
+
+    struct Summary {
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+
+        // Percentiles are approximated by the upper bound of their bucket
+        uint64_t p50Ns = 0;
+        uint64_t p90Ns = 0;
+        uint64_t p99Ns = 0;
+    };
+
+    static Profiler &instance();
+
+    bool isEnabled() const
+    {
+        return this->enabled_.load(std::memory_order_relaxed);
+    }
+    void setEnabled(bool enabled);
+
+    /// Whether ChannelViews should draw their frame times on top of messages
+    bool isOverlayEnabled() const
+    {
+        return this->overlayEnabled_.load(std::memory_order_relaxed);
+    }
+    void setOverlayEnabled(bool enabled);
+
+    void record(ProfileScope scope,
+                std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::duration duration);
+
+    Summary summary(ProfileScope scope) const;
+
+    /// Returns a human readable summary of all scopes
+    QString getDebugText() const;
+
+    /// Returns the recorded events as Chrome trace JSON
+    QByteArray toChromeTrace() const;
+
+    /// Clears all histograms and recorded events
+    void reset();
+
+    static QString scopeName(ProfileScope scope);
+
+    /// Returns the histogram bucket a duration of @a durationNs falls into
+    static size_t bucketFor(uint64_t durationNs);
+    /// Returns the lowest duration in nanoseconds that falls into @a bucket
+    static uint64_t bucketLowerBound(size_t bucket);
+
+private:
+    Profiler();
+
+    struct Histogram {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> maxNs{0};
+    };
+
+    struct TraceEvent {
+        std::atomic<int64_t> startNs{0};
+        std::atomic<int64_t> durationNs{-1};
+        std::atomic<uint32_t> threadID{0};
+        std::atomic<uint8_t> scope{0};
+    };
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<bool> overlayEnabled_{false};
+
+    const std::chrono::steady_clock::time_point epoch_;
+
+    std::array<Histogram, static_cast<size_t>(ProfileScope::Count)>
+        histograms_;
+
+    std::unique_ptr<TraceEvent[]> trace_;
+    std::atomic<uint64_t> traceHead_{0};
+};
+
+/// @brief Records the time until it's destroyed in the Profiler
+///
+/// If @a elapsedNs is set, the measured time is written to it as well (even
+/// if recording is disabled).
+class ProfileGuard
+{
+public:
+    explicit ProfileGuard(ProfileScope scope, int64_t *elapsedNs = nullptr);
+    ~ProfileGuard();
+
+    ProfileGuard(const ProfileGuard &) = delete;
+    ProfileGuard &operator=(const ProfileGuard &) = delete;
+
+    ProfileGuard(ProfileGuard &&) = delete;
+    ProfileGuard &operator=(ProfileGuard &&) = delete;
+
+private:
+    const ProfileScope scope_;
+    int64_t *const elapsedNs_;
+    const bool active_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace chatterino
@@ -14,12 +14,21 @@
 #include <QJsonObject>
 #include <QJsonValue>
 
+#include <atomic>
+
+namespace {
+
+std::atomic<uint64_t> nextSerial{0};
+
+}  // namespace
+
 namespace chatterino {
 
 using namespace literals;
 
 Message::Message()
-    : parseTime(QTime::currentTime())
+    : serial(nextSerial.fetch_add(1, std::memory_order_relaxed))
+    , parseTime(QTime::currentTime())
 {
     DebugCount::increase("messages");
 }
@@ -33,6 +33,10 @@ struct Message {
     Message(Message &&) = delete;
     Message &operator=(Message &&) = delete;
 
+    /// Unique for every message created by this process. Unlike the address,
+    /// this isn't reused once the message is destroyed.
+    const uint64_t serial;
+
     // Making this a mutable means that we can update a messages flags,
     // while still keeping Message constant. This means that a message's flag
     // can be updated without the renderer being made aware, which might be bad.
@@ -9,6 +9,7 @@
 #include "controllers/ignores/IgnoreController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
 #include "controllers/userdata/UserDataController.hpp"
+#include "debug/Profiler.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/Message.hpp"
@@ -32,6 +33,7 @@
 #include "providers/twitch/TwitchBadges.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrc.hpp"
+#include "providers/twitch/TwitchIrcTags.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "providers/twitch/TwitchUsers.hpp"
 #include "singletons/Emotes.hpp"
@@ -2114,18 +2116,22 @@ MessagePtrMut MessageBuilder::makeClearChatMessage(const QDateTime &now,
 
 std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
     /* mutable */ Channel *channel, const Communi::IrcMessage *ircMessage,
-    const MessageParseArgs &args, /* mutable */ QString content,
+    const TwitchIrcTags &tags, const MessageParseArgs &args,
+    /* mutable */ QString content,
     const QString::size_type messageOffset,
     const std::shared_ptr<MessageThread> &thread, const MessagePtr &parent)
 {
     assert(ircMessage != nullptr);
     assert(channel != nullptr);
 
-    auto tags = ircMessage->tags();
+    ProfileGuard profile(ProfileScope::MessageBuild);
+
+    using Tag = TwitchIrcTags::Tag;
+
+    auto userID = tags.value(Tag::UserId).toString();
     if (args.allowIgnore)
     {
-        bool ignored = MessageBuilder::isIgnored(
-            content, tags.value("user-id").toString(), channel);
+        bool ignored = MessageBuilder::isIgnored(content, userID, channel);
         if (ignored)
         {
             return {};
@@ -2134,8 +2140,6 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
 
     auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel);
 
-    auto userID = tags.value("user-id").toString();
-
     MessageBuilder builder;
     builder.parseUsernameColor(tags, userID);
     builder->userID = userID;
@@ -2146,7 +2150,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
         builder->flags.set(MessageFlag::Action);
     }
 
-    builder.parseUsername(ircMessage, twitchChannel,
+    builder.parseUsername(ircMessage, tags, twitchChannel,
                           args.trimSubscriberUsername);
 
     builder->flags.set(MessageFlag::Collapsed);
@@ -2192,17 +2196,18 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
         }
     }
 
-    if (tags.contains("client-nonce") && getSettings()->nonceFuckeryEnabled &&
+    if (tags.has(Tag::ClientNonce) && getSettings()->nonceFuckeryEnabled &&
         !isBridged)
     {
-        auto isAbnormal = isAbnormalNonce(tags["client-nonce"].toString());
+        auto nonce = tags.value(Tag::ClientNonce).toString();
+        auto isAbnormal = isAbnormalNonce(nonce);
         if (isAbnormal && getSettings()->abnormalNonceDetection)
         {
             builder.emplace<TimestampElement>();
             builder.emplace<TextElement>(
                 "Abnormal nonce:", MessageElementFlag::ChannelPointReward,
                 MessageColor::System);
-            builder.emplace<TextElement>(tags["client-nonce"].toString(),
+            builder.emplace<TextElement>(nonce,
                                          MessageElementFlag::ChannelPointReward,
                                          MessageColor::Text);
             builder.emplace<LinebreakElement>(
@@ -2216,28 +2221,27 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
 
     builder.appendChannelName(channel);
 
-    if (tags.contains("rm-deleted"))
+    if (tags.has(Tag::RmDeleted))
     {
         builder->flags.set(MessageFlag::Disabled);
     }
 
-    if (tags.contains("msg-id") &&
-        tags["msg-id"].toString().split(';').contains("highlighted-message"))
+    if (tags.value(Tag::MsgId) == u"highlighted-message")
     {
         builder->flags.set(MessageFlag::RedeemedHighlight);
     }
 
-    if (tags.contains("first-msg") && tags["first-msg"].toString() == "1")
+    if (tags.value(Tag::FirstMsg) == u"1")
     {
         builder->flags.set(MessageFlag::FirstMessage);
     }
 
-    if (tags.contains("pinned-chat-paid-amount"))
+    if (tags.has(Tag::PinnedChatPaidAmount))
     {
         builder->flags.set(MessageFlag::ElevatedMessage);
     }
 
-    if (tags.contains("bits"))
+    if (tags.has(Tag::Bits))
     {
         builder->flags.set(MessageFlag::CheerMessage);
     }
@@ -2246,7 +2250,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
     builder.parseThread(content, tags, channel, thread, parent);
 
     // timestamp
-    builder->serverReceivedTime = calculateMessageTime(ircMessage);
+    builder->serverReceivedTime = calculateMessageTime(tags);
     builder.emplace<TimestampElement>(builder->serverReceivedTime.time());
 
     bool shouldAddModerationElements = [&] {
@@ -2256,7 +2260,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
             return false;
         }
 
-        if (tags.value("user-type").toString() == "mod" &&
+        if (tags.value(Tag::UserType) == u"mod" &&
             !args.isStaffOrBroadcaster)
         {
             // You cannot timeout moderators UNLESS you are Twitch Staff or the broadcaster of the channel
@@ -2281,12 +2285,11 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
     TextState textState{.twitchChannel = twitchChannel};
     QString bits;
 
-    auto iterator = tags.find("bits");
-    if (iterator != tags.end())
+    if (tags.has(Tag::Bits))
     {
         textState.hasBits = true;
-        textState.bitsLeft = iterator.value().toInt();
-        bits = iterator.value().toString();
+        textState.bitsLeft = static_cast<int>(tags.integer(Tag::Bits));
+        bits = tags.value(Tag::Bits).toString();
     }
 
     // Twitch emotes
@@ -2321,7 +2324,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
 
     // highlights
     HighlightAlert highlight = builder.parseHighlights(tags, content, args);
-    if (tags.contains("historical"))
+    if (tags.has(Tag::Historical))
     {
         highlight.playSound = false;
         highlight.windowAlert = false;
@@ -2335,7 +2338,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
             ColorProvider::instance().color(ColorType::Whisper);
     }
 
-    if (!args.isReceivedWhisper && tags.value("msg-id") != "announcement")
+    if (!args.isReceivedWhisper && tags.value(Tag::MsgId) != u"announcement")
     {
         if (thread)
         {
@@ -2491,7 +2494,7 @@ TextElement *MessageBuilder::emplaceSystemTextAndUpdate(const QString &text,
                                       MessageColor::System);
 }
 
-void MessageBuilder::parseUsernameColor(const QVariantMap &tags,
+void MessageBuilder::parseUsernameColor(const TwitchIrcTags &tags,
                                         const QString &userID)
 {
     const auto *userData = getApp()->getUserData();
@@ -2507,25 +2510,24 @@ void MessageBuilder::parseUsernameColor(const QVariantMap &tags,
         }
     }
 
-    const auto iterator = tags.find("color");
-    if (iterator != tags.end())
+    if (const auto color = tags.value(TwitchIrcTags::Tag::Color);
+        !color.isEmpty())
     {
-        if (const auto color = iterator.value().toString(); !color.isEmpty())
-        {
-            this->usernameColor_ = QColor(color);
-            this->message().usernameColor = this->usernameColor_;
-            return;
-        }
+        this->usernameColor_ = QColor(color.toString());
+        this->message().usernameColor = this->usernameColor_;
+        return;
     }
 
-    if (getSettings()->colorizeNicknames && tags.contains("user-id"))
+    if (getSettings()->colorizeNicknames &&
+        tags.has(TwitchIrcTags::Tag::UserId))
     {
-        this->usernameColor_ = getRandomColor(tags.value("user-id").toString());
+        this->usernameColor_ = getRandomColor(userID);
         this->message().usernameColor = this->usernameColor_;
     }
 }
 
 void MessageBuilder::parseUsername(const Communi::IrcMessage *ircMessage,
+                                   const TwitchIrcTags &tags,
                                    TwitchChannel *twitchChannel,
                                    bool trimSubscriberUsername)
 {
@@ -2534,7 +2536,7 @@ void MessageBuilder::parseUsername(const Communi::IrcMessage *ircMessage,
 
     if (userName.isEmpty() || trimSubscriberUsername)
     {
-        userName = ircMessage->tag("login").toString();
+        userName = tags.value(TwitchIrcTags::Tag::Login).toString();
     }
 
     this->message_->loginName = userName;
@@ -2551,17 +2553,15 @@ void MessageBuilder::parseUsername(const Communi::IrcMessage *ircMessage,
     }
 }
 
-void MessageBuilder::parseMessageID(const QVariantMap &tags)
+void MessageBuilder::parseMessageID(const TwitchIrcTags &tags)
 {
-    auto iterator = tags.find("id");
-
-    if (iterator != tags.end())
+    if (tags.has(TwitchIrcTags::Tag::Id))
     {
-        this->message().id = iterator.value().toString();
+        this->message().id = tags.value(TwitchIrcTags::Tag::Id).toString();
     }
 }
 
-QString MessageBuilder::parseRoomID(const QVariantMap &tags,
+QString MessageBuilder::parseRoomID(const TwitchIrcTags &tags,
                                     TwitchChannel *twitchChannel)
 {
     if (twitchChannel == nullptr)
@@ -2569,11 +2569,9 @@ QString MessageBuilder::parseRoomID(const QVariantMap &tags,
         return {};
     }
 
-    auto iterator = tags.find("room-id");
-
-    if (iterator != std::end(tags))
+    if (tags.has(TwitchIrcTags::Tag::RoomId))
     {
-        auto roomID = iterator->toString();
+        auto roomID = tags.value(TwitchIrcTags::Tag::RoomId).toString();
         if (twitchChannel->roomId() != roomID)
         {
             if (twitchChannel->roomId().isEmpty())
@@ -2594,7 +2592,7 @@ QString MessageBuilder::parseRoomID(const QVariantMap &tags,
     return {};
 }
 
-TwitchChannel *MessageBuilder::parseSharedChatInfo(const QVariantMap &tags,
+TwitchChannel *MessageBuilder::parseSharedChatInfo(const TwitchIrcTags &tags,
                                                    TwitchChannel *twitchChannel)
 {
     if (!twitchChannel)
@@ -2602,9 +2600,10 @@ TwitchChannel *MessageBuilder::parseSharedChatInfo(const QVariantMap &tags,
         return twitchChannel;
     }
 
-    if (auto it = tags.find("source-room-id"); it != tags.end())
+    if (tags.has(TwitchIrcTags::Tag::SourceRoomId))
     {
-        auto sourceRoom = it.value().toString();
+        auto sourceRoom =
+            tags.value(TwitchIrcTags::Tag::SourceRoomId).toString();
         if (twitchChannel->roomId() != sourceRoom)
         {
             this->message().flags.set(MessageFlag::SharedMessage);
@@ -2629,7 +2628,7 @@ TwitchChannel *MessageBuilder::parseSharedChatInfo(const QVariantMap &tags,
 }
 
 void MessageBuilder::parseThread(const QString &messageContent,
-                                 const QVariantMap &tags,
+                                 const TwitchIrcTags &tags,
                                  const Channel *channel,
                                  const std::shared_ptr<MessageThread> &thread,
                                  const MessagePtr &parent)
@@ -2689,15 +2688,13 @@ void MessageBuilder::parseThread(const QString &messageContent,
                 color, FontStyle::ChatMediumSmall)
             ->setLink({Link::ViewThread, thread->rootId()});
     }
-    else if (tags.find("reply-parent-msg-id") != tags.end())
+    else if (tags.has(TwitchIrcTags::Tag::ReplyParentMsgId))
     {
         // Message is a reply but we couldn't find the original message.
         // Render the message using the additional reply tags
 
-        auto replyDisplayName = tags.find("reply-parent-display-name");
-        auto replyBody = tags.find("reply-parent-msg-body");
-
-        if (replyDisplayName != tags.end() && replyBody != tags.end())
+        if (tags.has(TwitchIrcTags::Tag::ReplyParentDisplayName) &&
+            tags.has(TwitchIrcTags::Tag::ReplyParentMsgBody))
         {
             QString body;
 
@@ -2707,7 +2704,8 @@ void MessageBuilder::parseThread(const QString &messageContent,
                 MessageColor::System, FontStyle::ChatMediumSmall);
 
             bool ignored = MessageBuilder::isIgnored(
-                messageContent, tags.value("reply-parent-user-id").toString(),
+                messageContent,
+                tags.value(TwitchIrcTags::Tag::ReplyParentUserId).toString(),
                 channel);
             if (ignored)
             {
@@ -2715,8 +2713,10 @@ void MessageBuilder::parseThread(const QString &messageContent,
             }
             else
             {
-                auto name = replyDisplayName->toString();
-                body = parseTagString(replyBody->toString());
+                auto name =
+                    tags.value(TwitchIrcTags::Tag::ReplyParentDisplayName)
+                        .toString();
+                body = tags.unescaped(TwitchIrcTags::Tag::ReplyParentMsgBody);
 
                 this->emplace<TextElement>(
                         "@" + name + ":", MessageElementFlag::RepliedMessage,
@@ -2733,7 +2733,7 @@ void MessageBuilder::parseThread(const QString &messageContent,
     }
 }
 
-HighlightAlert MessageBuilder::parseHighlights(const QVariantMap &tags,
+HighlightAlert MessageBuilder::parseHighlights(const TwitchIrcTags &tags,
                                                const QString &originalMessage,
                                                const MessageParseArgs &args)
 {
@@ -2788,7 +2788,7 @@ void MessageBuilder::appendChannelName(const Channel *channel)
         ->setLink(link);
 }
 
-void MessageBuilder::appendUsername(const QVariantMap &tags,
+void MessageBuilder::appendUsername(const TwitchIrcTags &tags,
                                     const MessageParseArgs &args)
 {
     auto *app = getApp();
@@ -2796,11 +2796,10 @@ void MessageBuilder::appendUsername(const QVariantMap &tags,
     QString username = this->message_->loginName;
     QString localizedName;
 
-    auto iterator = tags.find("display-name");
-    if (iterator != tags.end())
+    if (tags.has(TwitchIrcTags::Tag::DisplayName))
     {
         QString displayName =
-            parseTagString(iterator.value().toString()).trimmed();
+            tags.unescaped(TwitchIrcTags::Tag::DisplayName).trimmed();
 
         if (QString::compare(displayName, username, Qt::CaseInsensitive) == 0)
         {
@@ -3002,7 +3001,7 @@ void MessageBuilder::addWords(
     }
 }
 
-void MessageBuilder::appendTwitchBadges(const QVariantMap &tags,
+void MessageBuilder::appendTwitchBadges(const TwitchIrcTags &tags,
                                         TwitchChannel *twitchChannel)
 {
     if (twitchChannel == nullptr)
@@ -3012,7 +3011,8 @@ void MessageBuilder::appendTwitchBadges(const QVariantMap &tags,
 
     if (this->message().flags.has(MessageFlag::SharedMessage))
     {
-        const QString sourceId = tags["source-room-id"].toString();
+        const QString sourceId =
+            tags.value(TwitchIrcTags::Tag::SourceRoomId).toString();
         QString sourceName;
         if (sourceId.isEmpty())
         {
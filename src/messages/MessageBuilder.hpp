@@ -45,6 +45,7 @@ using HelixModerator = HelixVip;
 struct ChannelPointReward;
 struct DeleteAction;
 struct TwitchEmoteOccurrence;
+class TwitchIrcTags;
 
 namespace linkparser {
     struct Parsed;
@@ -234,6 +235,7 @@ public:
     ///                   accessed through this parameter but through `content`,
     ///                   as the content might be inside a tag (e.g. gifts in a
     ///                   USERNOTICE).
+    /// @param tags The tags of `ircMessage`
     /// @param args Arguments from parsing a chat message.
     /// @param content The message text. This isn't always the entire text. In
     ///                replies, the leading mention can be cut off.
@@ -256,7 +258,8 @@ public:
     ///          will be en empty `shared_ptr`.
     static std::pair<MessagePtrMut, HighlightAlert> makeIrcMessage(
         Channel *channel, const Communi::IrcMessage *ircMessage,
-        const MessageParseArgs &args, QString content,
+        const TwitchIrcTags &tags, const MessageParseArgs &args,
+        QString content,
         QString::size_type messageOffset,
         const std::shared_ptr<MessageThread> &thread = {},
         const MessagePtr &parent = {});
@@ -295,16 +298,16 @@ private:
     std::unique_ptr<MessageElement> releaseBack();
 
     void parse();
-    void parseUsernameColor(const QVariantMap &tags, const QString &userID);
+    void parseUsernameColor(const TwitchIrcTags &tags, const QString &userID);
     void parseUsername(const Communi::IrcMessage *ircMessage,
-                       TwitchChannel *twitchChannel,
+                       const TwitchIrcTags &tags, TwitchChannel *twitchChannel,
                        bool trimSubscriberUsername);
-    void parseMessageID(const QVariantMap &tags);
+    void parseMessageID(const TwitchIrcTags &tags);
 
     /// Parses the room-ID this message was received in
     ///
     /// @returns The room-ID
-    static QString parseRoomID(const QVariantMap &tags,
+    static QString parseRoomID(const TwitchIrcTags &tags,
                                TwitchChannel *twitchChannel);
 
     /// Parses the shared-chat information from this message.
@@ -314,28 +317,29 @@ private:
     /// @returns The source channel - the channel this message originated from.
     ///          If there's no channel currently open, @a twitchChannel is
     ///          returned.
-    TwitchChannel *parseSharedChatInfo(const QVariantMap &tags,
+    TwitchChannel *parseSharedChatInfo(const TwitchIrcTags &tags,
                                        TwitchChannel *twitchChannel);
 
     // Parse & build thread information into the message
     // Will read information from thread_ or from IRC tags
-    void parseThread(const QString &messageContent, const QVariantMap &tags,
+    void parseThread(const QString &messageContent, const TwitchIrcTags &tags,
                      const Channel *channel,
                      const std::shared_ptr<MessageThread> &thread,
                      const MessagePtr &parent);
     // parseHighlights only updates the visual state of the message, but leaves the playing of alerts and sounds to the triggerHighlights function
-    HighlightAlert parseHighlights(const QVariantMap &tags,
+    HighlightAlert parseHighlights(const TwitchIrcTags &tags,
                                    const QString &originalMessage,
                                    const MessageParseArgs &args);
 
     void appendChannelName(const Channel *channel);
-    void appendUsername(const QVariantMap &tags, const MessageParseArgs &args);
+    void appendUsername(const TwitchIrcTags &tags,
+                        const MessageParseArgs &args);
 
     void addWords(const QStringList &words,
                   const std::vector<TwitchEmoteOccurrence> &twitchEmotes,
                   TextState &state);
 
-    void appendTwitchBadges(const QVariantMap &tags,
+    void appendTwitchBadges(const TwitchIrcTags &tags,
                             TwitchChannel *twitchChannel);
     void appendChatterinoBadges(const QString &userID);
     void appendFfzBadges(TwitchChannel *twitchChannel, const QString &userID);
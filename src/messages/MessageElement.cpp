@@ -605,7 +605,8 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
                 return e;
             };
 
-            auto width = metrics.horizontalAdvance(word);
+            auto width = app->getFonts()->getWordWidths().width(
+                this->style_, container.getScale(), metrics, word);
 
             // see if the text fits in the current line
             if (container.fitsInLine(width))
@@ -684,6 +685,11 @@ FontStyle TextElement::fontStyle() const noexcept
     return this->style_;
 }
 
+const QStringList &TextElement::words() const noexcept
+{
+    return this->words_;
+}
+
 void TextElement::appendText(QStringView text)
 {
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
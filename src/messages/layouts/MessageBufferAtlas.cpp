@@ -0,0 +1,179 @@
+#include "messages/layouts/MessageBufferAtlas.hpp"
+
+#include "util/DebugCount.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+// Generations are unique across all atlases, so a slot can never be mistaken
+// for a slot of another view's atlas.
+// Atlases are only used from the GUI thread.
+uint64_t nextGeneration = 1;
+
+}  // namespace
+
+namespace chatterino {
+
+MessageBufferAtlas::~MessageBufferAtlas()
+{
+    this->clear();
+}
+
+void MessageBufferAtlas::setGeometry(int width, int viewportHeight,
+                                     qreal devicePixelRatio)
+{
+    if (width != this->width_ || devicePixelRatio != this->devicePixelRatio_)
+    {
+        this->clear();
+        this->width_ = width;
+        this->devicePixelRatio_ = devicePixelRatio;
+    }
+
+    this->viewportHeight_ = viewportHeight;
+}
+
+void MessageBufferAtlas::setMaxBytes(int64_t maxBytes)
+{
+    this->maxBytes_ = maxBytes;
+
+    auto maxPages = this->maxPages();
+    if (this->pages_.size() > maxPages)
+    {
+        DebugCount::decrease(
+            "message buffer atlas pages",
+            static_cast<int64_t>(this->pages_.size() - maxPages));
+        this->pages_.resize(maxPages);
+        this->currentPage_ = 0;
+    }
+}
+
+std::optional<MessageBufferSlot> MessageBufferAtlas::allocate(int height)
+{
+    if (height <= 0 || height > PAGE_HEIGHT || this->width_ <= 0)
+    {
+        return std::nullopt;
+    }
+
+    Page *page = nullptr;
+    if (this->currentPage_ < this->pages_.size() &&
+        this->pages_[this->currentPage_].cursor + height <= PAGE_HEIGHT)
+    {
+        page = &this->pages_[this->currentPage_];
+    }
+    else
+    {
+        page = &this->nextPage();
+    }
+
+    if (page->pixmap.isNull())
+    {
+        return std::nullopt;
+    }
+
+    MessageBufferSlot slot{
+        .page = this->currentPage_,
+        .generation = page->generation,
+        .y = page->cursor,
+        .height = height,
+    };
+    page->cursor += height;
+
+    return slot;
+}
+
+bool MessageBufferAtlas::isValid(const MessageBufferSlot &slot) const
+{
+    return slot.page < this->pages_.size() &&
+           this->pages_[slot.page].generation == slot.generation;
+}
+
+QPixmap &MessageBufferAtlas::use(const MessageBufferSlot &slot)
+{
+    assert(this->isValid(slot));
+
+    auto &page = this->pages_[slot.page];
+    page.lastUse = ++this->useCounter_;
+    return page.pixmap;
+}
+
+QRectF MessageBufferAtlas::sourceRect(const MessageBufferSlot &slot) const
+{
+    return {
+        0,
+        slot.y * this->devicePixelRatio_,
+        this->width_ * this->devicePixelRatio_,
+        slot.height * this->devicePixelRatio_,
+    };
+}
+
+void MessageBufferAtlas::clear()
+{
+    if (!this->pages_.empty())
+    {
+        DebugCount::decrease("message buffer atlas pages",
+                             static_cast<int64_t>(this->pages_.size()));
+    }
+
+    this->pages_.clear();
+    this->currentPage_ = 0;
+}
+
+size_t MessageBufferAtlas::pageCount() const
+{
+    return this->pages_.size();
+}
+
+size_t MessageBufferAtlas::maxPages() const
+{
+    // Always keep enough pages around to fit a full screen of messages, plus
+    // one to allocate new messages from while the others are being painted.
+    const auto minPages =
+        static_cast<size_t>(std::max(0, this->viewportHeight_) / PAGE_HEIGHT) +
+        2;
+
+    const auto pageBytes =
+        static_cast<int64_t>(this->width_ * this->devicePixelRatio_) *
+        static_cast<int64_t>(PAGE_HEIGHT * this->devicePixelRatio_) * 4;
+    if (pageBytes <= 0)
+    {
+        return minPages;
+    }
+
+    return std::max(minPages,
+                    static_cast<size_t>(this->maxBytes_ / pageBytes));
+}
+
+MessageBufferAtlas::Page &MessageBufferAtlas::nextPage()
+{
+    if (this->pages_.size() < this->maxPages())
+    {
+        auto &page = this->pages_.emplace_back();
+        page.pixmap = QPixmap(int(this->width_ * this->devicePixelRatio_),
+                              int(PAGE_HEIGHT * this->devicePixelRatio_));
+        page.pixmap.setDevicePixelRatio(this->devicePixelRatio_);
+        page.generation = nextGeneration++;
+        page.lastUse = ++this->useCounter_;
+
+        this->currentPage_ = this->pages_.size() - 1;
+        DebugCount::increase("message buffer atlas pages");
+        return page;
+    }
+
+    auto it = std::min_element(this->pages_.begin(), this->pages_.end(),
+                               [](const auto &a, const auto &b) {
+                                   return a.lastUse < b.lastUse;
+                               });
+    assert(it != this->pages_.end());
+
+    // Every slot in this page gets invalidated by bumping the generation
+    it->generation = nextGeneration++;
+    it->lastUse = ++this->useCounter_;
+    it->cursor = 0;
+
+    this->currentPage_ = static_cast<size_t>(it - this->pages_.begin());
+    return *it;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QPixmap>
+#include <QRectF>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace chatterino {
+
+/// A region inside a page of a MessageBufferAtlas
+///
+/// A slot stays usable until the atlas recycles the page it was allocated
+/// from. Use MessageBufferAtlas::isValid to check this before drawing.
+struct MessageBufferSlot {
+    size_t page = 0;
+    uint64_t generation = 0;
+
+    /// Offset of this slot from the top of its page in logical pixels
+    int y = 0;
+    /// Height of this slot in logical pixels
+    int height = 0;
+};
+
+/// @brief Drawing buffers for all messages of a single ChannelView
+///
+/// Instead of every MessageLayout owning a pixmap the size of the view, message
+/// buffers are sub-allocated from a small set of large pages. Each page is as
+/// wide as the view and is filled from top to bottom.
+///
+/// Once the memory cap is reached, the least recently painted page is
+/// recycled, which invalidates every slot allocated from it. Messages that
+/// were scrolled off-screen keep their slot until that happens, so scrolling
+/// back through recent history doesn't have to repaint them.
+class MessageBufferAtlas
+{
+public:
+    /// Height of a page in logical pixels.
+    /// Messages taller than this don't fit into the atlas.
+    static constexpr int PAGE_HEIGHT = 512;
+
+    MessageBufferAtlas() = default;
+    ~MessageBufferAtlas();
+
+    MessageBufferAtlas(const MessageBufferAtlas &) = delete;
+    MessageBufferAtlas &operator=(const MessageBufferAtlas &) = delete;
+
+    MessageBufferAtlas(MessageBufferAtlas &&) = delete;
+    MessageBufferAtlas &operator=(MessageBufferAtlas &&) = delete;
+
+    /// @brief Updates the dimensions of the pages
+    ///
+    /// If @a width or @a devicePixelRatio changed, all pages are dropped.
+    /// @a viewportHeight is used to always keep enough pages around to fit
+    /// one screen of messages, regardless of the memory cap.
+    void setGeometry(int width, int viewportHeight, qreal devicePixelRatio);
+
+    /// Sets the maximum amount of memory used by all pages
+    void setMaxBytes(int64_t maxBytes);
+
+    /// @brief Allocates a slot that's @a height logical pixels tall
+    ///
+    /// This might recycle the least recently used page.
+    /// Returns std::nullopt if no slot of this height can be allocated.
+    std::optional<MessageBufferSlot> allocate(int height);
+
+    /// Returns true if @a slot still points to memory owned by it
+    bool isValid(const MessageBufferSlot &slot) const;
+
+    /// @brief Returns the page @a slot was allocated from
+    ///
+    /// The page will be marked as the most recently used one.
+    /// @pre @a slot must be valid.
+    QPixmap &use(const MessageBufferSlot &slot);
+
+    /// Returns the area of @a slot inside its page in device pixels
+    QRectF sourceRect(const MessageBufferSlot &slot) const;
+
+    /// Drops all pages and invalidates all slots
+    void clear();
+
+    size_t pageCount() const;
+    size_t maxPages() const;
+
+private:
+    struct Page {
+        QPixmap pixmap;
+        uint64_t generation = 0;
+        uint64_t lastUse = 0;
+        /// Top of the free area of this page in logical pixels
+        int cursor = 0;
+    };
+
+    /// Adds a new page or recycles the least recently used one
+    Page &nextPage();
+
+    std::vector<Page> pages_;
+    size_t currentPage_ = 0;
+    uint64_t useCounter_ = 0;
+
+    int width_ = 0;
+    int viewportHeight_ = 0;
+    qreal devicePixelRatio_ = 1;
+    int64_t maxBytes_ = 0;
+};
+
+}  // namespace chatterino
@@ -1,6 +1,7 @@
 #include "messages/layouts/MessageLayout.hpp"
 
 #include "Application.hpp"
+#include "debug/Profiler.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
@@ -9,6 +10,7 @@
 #include "messages/MessageFlag.hpp"
 #include "messages/Selection.hpp"
 #include "providers/colors/ColorProvider.hpp"
+#include "singletons/Fonts.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
 #include "singletons/WindowManager.hpp"
@@ -20,6 +22,9 @@
 #include <QtGlobal>
 #include <QThread>
 
+#include <algorithm>
+#include <iterator>
+
 namespace chatterino {
 
 namespace {
@@ -72,8 +77,6 @@ int MessageLayout::getWidth() const
 bool MessageLayout::layout(const MessageLayoutContext &ctx,
                            bool shouldInvalidateBuffer)
 {
-    //    BenchmarkGuard benchmark("MessageLayout::layout()");
-
     bool layoutRequired = false;
 
     // check if width changed
@@ -125,8 +128,61 @@ bool MessageLayout::layout(const MessageLayoutContext &ctx,
     return true;
 }
 
+bool MessageLayout::measureAhead(const Message &message,
+                                 MessageElementFlags flags, float scale,
+                                 std::function<void()> onDone)
+{
+    auto *fonts = getApp()->getFonts();
+
+    std::vector<WordWidthCache::Batch> batches;
+    for (const auto &element : message.elements)
+    {
+        const auto *text = dynamic_cast<const TextElement *>(element.get());
+        if (text == nullptr || !flags.hasAny(text->getFlags()))
+        {
+            continue;
+        }
+
+        auto batch = std::find_if(batches.begin(), batches.end(),
+                                  [&](const auto &it) {
+                                      return it.style == text->fontStyle();
+                                  });
+        if (batch == batches.end())
+        {
+            batches.push_back({
+                .style = text->fontStyle(),
+                .font = fonts->getFont(text->fontStyle(), scale),
+                .words = {},
+            });
+            batch = std::prev(batches.end());
+        }
+
+        for (const auto &word : text->words())
+        {
+            if (!fonts->getWordWidths().find(batch->style, scale, word))
+            {
+                batch->words.push_back(word);
+            }
+        }
+    }
+
+    std::erase_if(batches, [](const auto &batch) {
+        return batch.words.empty();
+    });
+    if (batches.empty())
+    {
+        return false;
+    }
+
+    fonts->getWordWidths().measureAsync(scale, std::move(batches),
+                                        std::move(onDone));
+    return true;
+}
+
 void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
 {
+    ProfileGuard profile(ProfileScope::MessageLayout);
+
 #ifdef FOURTF
     this->layoutCount_++;
 #endif
@@ -216,20 +272,15 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 {
     MessagePaintResult result;
 
-    QPixmap *pixmap = this->ensureBuffer(ctx.painter, ctx.canvasWidth,
-                                         ctx.messageColors.hasTransparency);
-
-    if (!this->bufferValid_)
+    // draw on buffer
+    if (ctx.bufferAtlas == nullptr ||
+        !this->paintAtlasBuffer(*ctx.bufferAtlas, ctx))
     {
-        if (ctx.messageColors.hasTransparency)
-        {
-            pixmap->fill(Qt::transparent);
-        }
-        this->updateBuffer(pixmap, ctx);
+        this->paintOwnBuffer(ctx);
     }
 
-    // draw on buffer
-    ctx.painter.drawPixmap(0, ctx.y, *pixmap);
+    const auto width = ctx.canvasWidth;
+    const auto height = this->container_.getHeight();
 
     // draw gif emotes
     result.hasAnimatedElements =
@@ -238,14 +289,14 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
     // draw disabled
     if (this->message_->flags.has(MessageFlag::Disabled))
     {
-        ctx.painter.fillRect(0, ctx.y, pixmap->width(), pixmap->height(),
+        ctx.painter.fillRect(0, ctx.y, width, height,
                              ctx.messageColors.disabled);
     }
 
     if (this->message_->flags.has(MessageFlag::RecentMessage) &&
         getSettings()->grayOutRecents)
     {
-        ctx.painter.fillRect(0, ctx.y, pixmap->width(), pixmap->height(),
+        ctx.painter.fillRect(0, ctx.y, width, height,
                              ctx.messageColors.disabled);
     }
 
@@ -255,7 +306,7 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
         ctx.preferences.enableRedeemedHighlight)
     {
         ctx.painter.fillRect(
-            0, ctx.y, int(this->scale_ * 4), pixmap->height(),
+            0, ctx.y, int(this->scale_ * 4), height,
             *ColorProvider::instance().color(ColorType::RedeemedHighlight));
     }
 
@@ -290,8 +341,7 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 
         QBrush brush(color, ctx.preferences.lastMessagePattern);
 
-        ctx.painter.fillRect(0, ctx.y + this->container_.getHeight() - 1,
-                             pixmap->width(), 1, brush);
+        ctx.painter.fillRect(0, ctx.y + height - 1, width, 1, brush);
     }
 
     this->bufferValid_ = true;
@@ -323,15 +373,82 @@ QPixmap *MessageLayout::ensureBuffer(QPainter &painter, int width, bool clear)
     return this->buffer_.get();
 }
 
-void MessageLayout::updateBuffer(QPixmap *buffer,
-                                 const MessagePaintContext &ctx)
+bool MessageLayout::paintAtlasBuffer(MessageBufferAtlas &atlas,
+                                     const MessagePaintContext &ctx)
+{
+    if (this->buffer_ != nullptr)
+    {
+        // This message didn't fit into the atlas when its buffer was created
+        return false;
+    }
+
+    const auto height = this->container_.getHeight();
+    if (!atlas.isValid(this->atlasSlot_) || this->atlasSlot_.height != height)
+    {
+        auto slot = atlas.allocate(height);
+        if (!slot)
+        {
+            return false;
+        }
+
+        this->atlasSlot_ = *slot;
+        this->bufferValid_ = false;
+    }
+
+    QPixmap &page = atlas.use(this->atlasSlot_);
+
+    if (!this->bufferValid_)
+    {
+        QPainter painter(&page);
+        painter.translate(0, this->atlasSlot_.y);
+
+        QRect rect(0, 0, ctx.canvasWidth, height);
+        painter.setClipRect(rect);
+
+        if (ctx.messageColors.hasTransparency)
+        {
+            // The slot might still contain a message from before the page was
+            // recycled
+            painter.setCompositionMode(QPainter::CompositionMode_Source);
+            painter.fillRect(rect, Qt::transparent);
+            painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        }
+
+        this->updateBuffer(painter, rect, ctx);
+    }
+
+    ctx.painter.drawPixmap(QRectF(0, ctx.y, ctx.canvasWidth, height), page,
+                           atlas.sourceRect(this->atlasSlot_));
+
+    return true;
+}
+
+void MessageLayout::paintOwnBuffer(const MessagePaintContext &ctx)
 {
-    if (buffer->isNull())
+    QPixmap *pixmap = this->ensureBuffer(ctx.painter, ctx.canvasWidth,
+                                         ctx.messageColors.hasTransparency);
+
+    if (!this->bufferValid_ && !pixmap->isNull())
     {
-        return;
+        if (ctx.messageColors.hasTransparency)
+        {
+            pixmap->fill(Qt::transparent);
+        }
+
+        QPainter painter(pixmap);
+        this->updateBuffer(
+            painter, QRect(0, 0, ctx.canvasWidth, this->container_.getHeight()),
+            ctx);
     }
 
-    QPainter painter(buffer);
+    ctx.painter.drawPixmap(0, ctx.y, *pixmap);
+}
+
+void MessageLayout::updateBuffer(QPainter &painter, const QRect &rect,
+                                 const MessagePaintContext &ctx)
+{
+    ProfileGuard profile(ProfileScope::BufferUpdate);
+
     painter.setRenderHint(QPainter::SmoothPixmapTransform);
 
     // draw background
@@ -417,7 +534,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
             blendColors(backgroundColor, QColor(getSettings()->webchatColor));
     }
 
-    painter.fillRect(buffer->rect(), backgroundColor);
+    painter.fillRect(rect, backgroundColor);
 
     // draw message
     this->container_.paintElements(painter, ctx);
@@ -425,8 +542,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
 #ifdef FOURTF
     // debug
     painter.setPen(QColor(255, 0, 0));
-    painter.drawRect(buffer->rect().x(), buffer->rect().y(),
-                     buffer->rect().width() - 1, buffer->rect().height() - 1);
+    painter.drawRect(rect.x(), rect.y(), rect.width() - 1, rect.height() - 1);
 
     QTextOption option;
     option.setAlignment(Qt::AlignRight | Qt::AlignTop);
@@ -444,6 +560,12 @@ void MessageLayout::invalidateBuffer()
 }
 
 void MessageLayout::deleteBuffer()
+{
+    this->releaseBuffer();
+    this->atlasSlot_ = {};
+}
+
+void MessageLayout::releaseBuffer()
 {
     if (this->buffer_ != nullptr)
     {
@@ -2,11 +2,13 @@
 
 #include "common/Common.hpp"
 #include "common/FlagsEnum.hpp"
+#include "messages/layouts/MessageBufferAtlas.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 
 #include <QPixmap>
 
 #include <cinttypes>
+#include <functional>
 #include <memory>
 
 namespace chatterino {
@@ -59,10 +61,30 @@ public:
 
     bool layout(const MessageLayoutContext &ctx, bool shouldInvalidateBuffer);
 
+    /**
+     * @brief Measures the text of @a message on the layout worker pool
+     *
+     * Once the words are measured, laying out the message with the same
+     * @a flags and @a scale only has to look up their widths.
+     * @a onDone is invoked on the GUI thread afterwards.
+     *
+     * @return false if there was nothing to measure, in this case @a onDone
+     *         isn't invoked.
+     */
+    static bool measureAhead(const Message &message, MessageElementFlags flags,
+                             float scale, std::function<void()> onDone);
+
     // Painting
     MessagePaintResult paint(const MessagePaintContext &ctx);
     void invalidateBuffer();
+    /// Deletes the buffer of this message and releases its atlas slot
     void deleteBuffer();
+    /// @brief Deletes the buffer of this message if it owns one
+    ///
+    /// Slots in the view's buffer atlas are kept, so the message doesn't have
+    /// to be repainted if it's scrolled back into view before the atlas
+    /// recycles its page.
+    void releaseBuffer();
     void deleteCache();
 
     /**
@@ -113,15 +135,23 @@ public:
 private:
     // methods
     void actuallyLayout(const MessageLayoutContext &ctx);
-    void updateBuffer(QPixmap *buffer, const MessagePaintContext &ctx);
+    void updateBuffer(QPainter &painter, const QRect &rect,
+                      const MessagePaintContext &ctx);
 
     // Create new buffer if required, returning the buffer
     QPixmap *ensureBuffer(QPainter &painter, int width, bool clear);
 
+    // Draws the buffer from the atlas, returns false if the message doesn't
+    // fit into the atlas
+    bool paintAtlasBuffer(MessageBufferAtlas &atlas,
+                          const MessagePaintContext &ctx);
+    void paintOwnBuffer(const MessagePaintContext &ctx);
+
     // variables
     const MessagePtr message_;
     MessageLayoutContainer container_;
     std::unique_ptr<QPixmap> buffer_;
+    MessageBufferSlot atlasSlot_;
     bool bufferValid_ = false;
 
     int height_ = 0;
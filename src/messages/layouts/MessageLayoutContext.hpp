@@ -12,6 +12,7 @@ class SignalHolder;
 namespace chatterino {
 
 class ColorProvider;
+class MessageBufferAtlas;
 class Theme;
 class Settings;
 struct Selection;
@@ -72,6 +73,8 @@ struct MessagePaintContext {
     const bool isWindowFocused{};
     // whether the painting should be treated as if this view is the special mentions view
     const bool isMentions{};
+    // buffer atlas of the view, if this is nullptr, messages use their own buffer
+    MessageBufferAtlas *const bufferAtlas{};
 
     // y coordinate we're currently painting at
     int y{};
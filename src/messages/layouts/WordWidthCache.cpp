@@ -0,0 +1,134 @@
+#include "messages/layouts/WordWidthCache.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QThread>
+
+#include <algorithm>
+#include <mutex>
+
+namespace chatterino {
+
+WordWidthCache::WordWidthCache()
+{
+    this->pool_.setObjectName("WordWidthCache");
+    this->pool_.setMaxThreadCount(
+        std::max(1, QThread::idealThreadCount() / 2));
+}
+
+WordWidthCache::~WordWidthCache()
+{
+    this->pool_.clear();
+    this->pool_.waitForDone();
+}
+
+int WordWidthCache::width(FontStyle style, float scale,
+                          const QFontMetrics &metrics, const QString &word)
+{
+    if (auto cached = this->find(style, scale, word))
+    {
+        return *cached;
+    }
+
+    auto width = metrics.horizontalAdvance(word);
+
+    std::unique_lock lock(this->mutex_);
+    this->insert({style, scale}, word, width);
+
+    return width;
+}
+
+std::optional<int> WordWidthCache::find(FontStyle style, float scale,
+                                        const QString &word) const
+{
+    std::shared_lock lock(this->mutex_);
+
+    auto font = this->widths_.find({style, scale});
+    if (font == this->widths_.end())
+    {
+        return std::nullopt;
+    }
+
+    auto it = font->second.find(word);
+    if (it == font->second.end())
+    {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+void WordWidthCache::measureAsync(float scale, std::vector<Batch> batches,
+                                  std::function<void()> onDone)
+{
+    assertInGuiThread();
+
+    uint64_t generation = 0;
+    {
+        std::shared_lock lock(this->mutex_);
+        generation = this->generation_;
+    }
+
+    this->pool_.start([this, scale, generation, batches{std::move(batches)},
+                       onDone{std::move(onDone)}] {
+        for (const auto &batch : batches)
+        {
+            // QFontMetrics uses a font engine cache local to this thread
+            QFontMetrics metrics(batch.font);
+
+            std::vector<std::pair<const QString *, int>> measured;
+            measured.reserve(batch.words.size());
+            for (const auto &word : batch.words)
+            {
+                if (!this->find(batch.style, scale, word))
+                {
+                    measured.emplace_back(&word,
+                                          metrics.horizontalAdvance(word));
+                }
+            }
+
+            std::unique_lock lock(this->mutex_);
+            if (generation != this->generation_)
+            {
+                // The fonts changed while we were measuring
+                break;
+            }
+
+            for (const auto &[word, width] : measured)
+            {
+                this->insert({batch.style, scale}, *word, width);
+            }
+        }
+
+        if (onDone)
+        {
+            postToThread(onDone);
+        }
+    });
+}
+
+void WordWidthCache::clear()
+{
+    std::unique_lock lock(this->mutex_);
+    this->widths_.clear();
+    this->generation_++;
+}
+
+void WordWidthCache::waitForDone()
+{
+    this->pool_.waitForDone();
+}
+
+void WordWidthCache::insert(FontKey key, const QString &word, int width)
+{
+    auto &widths = this->widths_[key];
+    if (widths.size() >= MAX_WORDS_PER_FONT)
+    {
+        widths.clear();
+    }
+
+    widths.emplace(word, width);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "util/QStringHash.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <QFont>
+#include <QFontMetrics>
+#include <QString>
+#include <QThreadPool>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+enum class FontStyle : uint8_t;
+
+/// @brief Caches the horizontal advance of words in chat fonts
+///
+/// Measuring words is the most expensive part of laying out a message. Most
+/// words (emote codes, usernames, common phrases) repeat a lot, so the widths
+/// are shared between all messages and views.
+///
+/// Words of incoming messages can be measured ahead of time on a worker pool
+/// with #measureAsync. Their first layout on the GUI thread then only has to
+/// look the widths up. Results are keyed by font style and scale, and are
+/// discarded if the fonts changed while they were measured.
+class WordWidthCache
+{
+public:
+    /// Upper bound for cached words per font style and scale
+    static constexpr size_t MAX_WORDS_PER_FONT = 16384;
+
+    WordWidthCache();
+    ~WordWidthCache();
+
+    WordWidthCache(const WordWidthCache &) = delete;
+    WordWidthCache &operator=(const WordWidthCache &) = delete;
+
+    WordWidthCache(WordWidthCache &&) = delete;
+    WordWidthCache &operator=(WordWidthCache &&) = delete;
+
+    /// @brief Returns the horizontal advance of @a word
+    ///
+    /// If the word hasn't been measured yet, it's measured with @a metrics.
+    /// @a metrics must belong to the font of @a style at @a scale.
+    int width(FontStyle style, float scale, const QFontMetrics &metrics,
+              const QString &word);
+
+    /// Returns the cached width of @a word if it has been measured already
+    std::optional<int> find(FontStyle style, float scale,
+                            const QString &word) const;
+
+    struct Batch {
+        FontStyle style;
+        /// The font of #style at the scale passed to #measureAsync
+        QFont font;
+        std::vector<QString> words;
+    };
+
+    /// @brief Measures the words in @a batches on a worker thread
+    ///
+    /// @a onDone is invoked on the GUI thread once all words are measured.
+    void measureAsync(float scale, std::vector<Batch> batches,
+                      std::function<void()> onDone);
+
+    /// Drops all widths, used when fonts changed
+    void clear();
+
+    /// Blocks until all pending measurements are done (used in tests)
+    void waitForDone();
+
+private:
+    using Widths = boost::unordered_flat_map<QString, int>;
+    using FontKey = std::pair<FontStyle, float>;
+
+    void insert(FontKey key, const QString &word, int width);
+
+    mutable std::shared_mutex mutex_;
+    std::map<FontKey, Widths> widths_;
+    uint64_t generation_ = 0;
+
+    // This must be the last member, so pending measurements are finished
+    // before the cache is destroyed.
+    QThreadPool pool_;
+};
+
+}  // namespace chatterino
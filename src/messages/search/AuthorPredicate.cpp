@@ -1,6 +1,9 @@
 #include "messages/search/AuthorPredicate.hpp"
 
 #include "messages/Message.hpp"
+#include "util/QStringHash.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
 
 namespace chatterino {
 
@@ -21,4 +24,31 @@ bool AuthorPredicate::appliesToImpl(const Message &message)
            authors_.contains(message.loginName, Qt::CaseInsensitive);
 }
 
+void AuthorPredicate::filterImpl(std::span<const MessagePtr> messages,
+                                 MessageMask &mask, bool expected)
+{
+    struct Seen {
+        QString displayName;
+        bool applies = false;
+    };
+    // Most authors send more than one message in a batch
+    boost::unordered_flat_map<QString, Seen> seen;
+
+    mask.forEachSet([&](size_t i) {
+        const auto &message = *messages[i];
+        auto [it, inserted] = seen.try_emplace(message.loginName);
+        auto &entry = it->second;
+        if (inserted || entry.displayName != message.displayName)
+        {
+            entry.displayName = message.displayName;
+            entry.applies = this->appliesToImpl(message);
+        }
+
+        if (entry.applies != expected)
+        {
+            mask.reset(i);
+        }
+    });
+}
+
 }  // namespace chatterino
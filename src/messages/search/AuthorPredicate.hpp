@@ -35,6 +35,13 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Checks a batch of messages, comparing the names of each author
+     *        only once.
+     */
+    void filterImpl(std::span<const MessagePtr> messages, MessageMask &mask,
+                    bool expected) override;
+
 private:
     /// Holds the user names that will be searched for
     QStringList authors_;
@@ -2,6 +2,9 @@
 
 #include "messages/Message.hpp"
 #include "providers/twitch/TwitchBadge.hpp"
+#include "util/QStringHash.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
 
 namespace chatterino {
 
@@ -44,4 +47,34 @@ bool BadgePredicate::appliesToImpl(const Message &message)
     return false;
 }
 
+void BadgePredicate::filterImpl(std::span<const MessagePtr> messages,
+                                MessageMask &mask, bool expected)
+{
+    // Only a handful of distinct badges show up in a batch
+    boost::unordered_flat_map<QString, bool> searched;
+
+    mask.forEachSet([&](size_t i) {
+        bool applies = false;
+        for (const Badge &badge : messages[i]->badges)
+        {
+            auto [it, inserted] = searched.try_emplace(badge.key_, false);
+            if (inserted)
+            {
+                it->second = this->badges_.contains(badge.key_,
+                                                    Qt::CaseInsensitive);
+            }
+            if (it->second)
+            {
+                applies = true;
+                break;
+            }
+        }
+
+        if (applies != expected)
+        {
+            mask.reset(i);
+        }
+    });
+}
+
 }  // namespace chatterino
@@ -35,6 +35,13 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Checks a batch of messages, looking up each distinct badge only
+     *        once.
+     */
+    void filterImpl(std::span<const MessagePtr> messages, MessageMask &mask,
+                    bool expected) override;
+
 private:
     /// Holds the badges that will be searched for
     QStringList badges_;
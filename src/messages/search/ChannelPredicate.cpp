@@ -1,6 +1,9 @@
 #include "messages/search/ChannelPredicate.hpp"
 
 #include "messages/Message.hpp"
+#include "util/QStringHash.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
 
 namespace chatterino {
 
@@ -20,4 +23,25 @@ bool ChannelPredicate::appliesToImpl(const Message &message)
     return channels_.contains(message.channelName, Qt::CaseInsensitive);
 }
 
+void ChannelPredicate::filterImpl(std::span<const MessagePtr> messages,
+                                  MessageMask &mask, bool expected)
+{
+    // A batch usually comes from very few channels
+    boost::unordered_flat_map<QString, bool> searched;
+
+    mask.forEachSet([&](size_t i) {
+        const auto &message = *messages[i];
+        auto [it, inserted] = searched.try_emplace(message.channelName, false);
+        if (inserted)
+        {
+            it->second = this->appliesToImpl(message);
+        }
+
+        if (it->second != expected)
+        {
+            mask.reset(i);
+        }
+    });
+}
+
 }  // namespace chatterino
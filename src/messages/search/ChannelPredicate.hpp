@@ -35,6 +35,13 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Checks a batch of messages, comparing each channel name only
+     *        once.
+     */
+    void filterImpl(std::span<const MessagePtr> messages, MessageMask &mask,
+                    bool expected) override;
+
 private:
     /// Holds the channel names that will be searched for
     QStringList channels_;
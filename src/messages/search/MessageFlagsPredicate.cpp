@@ -65,6 +65,11 @@ MessageFlagsPredicate::MessageFlagsPredicate(const QString &flags, bool negate)
     }
 }
 
+bool MessageFlagsPredicate::readsMutableFields() const
+{
+    return true;
+}
+
 bool MessageFlagsPredicate::appliesToImpl(const Message &message)
 {
     // Exclude timeout messages from system flag when timeout flag isn't present
@@ -77,4 +82,25 @@ bool MessageFlagsPredicate::appliesToImpl(const Message &message)
     return message.flags.hasAny(flags_);
 }
 
+void MessageFlagsPredicate::filterImpl(std::span<const MessagePtr> messages,
+                                       MessageMask &mask, bool expected)
+{
+    // Same as appliesToImpl, with the checks of our own flags done only once
+    MessageFlags excluded;
+    if (this->flags_.has(MessageFlag::System) &&
+        !this->flags_.has(MessageFlag::Timeout))
+    {
+        excluded.set(MessageFlag::Timeout);
+    }
+
+    mask.forEachSet([&](size_t i) {
+        auto flags = messages[i]->flags;
+        bool applies = flags.hasAny(this->flags_) && !flags.hasAny(excluded);
+        if (applies != expected)
+        {
+            mask.reset(i);
+        }
+    });
+}
+
 }  // namespace chatterino
@@ -32,6 +32,9 @@ public:
      */
     MessageFlagsPredicate(const QString &flags, bool negate);
 
+    /// Flags are changed in the GUI thread (e.g. when a message is disabled)
+    bool readsMutableFields() const override;
+
 protected:
     /**
      * @brief Checks whether the message has any of the flags passed
@@ -43,6 +46,12 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Checks the flags of a batch of messages in one loop.
+     */
+    void filterImpl(std::span<const MessagePtr> messages, MessageMask &mask,
+                    bool expected) override;
+
 private:
     /// Holds the flags that will be searched for
     MessageFlags flags_;
@@ -1,10 +1,85 @@
 #pragma once
 
+#include <QString>
+
+#include <bit>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace chatterino {
 
 struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/**
+ * @brief One bit per message of a batch checked with MessagePredicate::filter
+ *
+ * The bits are stored in 64-bit words, so combining masks and skipping
+ * messages that were already rejected only takes a few instructions per 64
+ * messages.
+ */
+class MessageMask
+{
+public:
+    /// Creates a mask of @a size messages that are all set
+    explicit MessageMask(size_t size)
+        : words_((size + 63) / 64, ~uint64_t{0})
+        , size_(size)
+    {
+        if (size % 64 != 0)
+        {
+            this->words_.back() = (uint64_t{1} << (size % 64)) - 1;
+        }
+    }
+
+    size_t size() const
+    {
+        return this->size_;
+    }
+
+    bool test(size_t i) const
+    {
+        return (this->words_[i / 64] >> (i % 64) & 1) != 0;
+    }
+
+    void reset(size_t i)
+    {
+        this->words_[i / 64] &= ~(uint64_t{1} << (i % 64));
+    }
+
+    bool none() const
+    {
+        for (auto word : this->words_)
+        {
+            if (word != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Calls @a fn with the index of every set bit (in ascending order)
+    template <typename F>
+    void forEachSet(F &&fn) const
+    {
+        for (size_t w = 0; w < this->words_.size(); w++)
+        {
+            auto word = this->words_[w];
+            while (word != 0)
+            {
+                fn(w * 64 + static_cast<size_t>(std::countr_zero(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> words_;
+    size_t size_;
+};
 
 /**
  * @brief Abstract base class for message predicates.
@@ -38,6 +113,52 @@ public:
         return result;
     }
 
+    /**
+     * @brief Checks this predicate for a batch of messages
+     *
+     * Clears the bits of @a mask for the messages this predicate doesn't apply
+     * to. Messages whose bit is already cleared aren't checked again, so
+     * chaining predicates over the same mask keeps the short-circuiting of
+     * calling `appliesTo` for each of them.
+     *
+     * @param messages the messages to check
+     * @param mask the messages to check, with one bit per message in
+     *             @a messages
+     **/
+    void filter(std::span<const MessagePtr> messages, MessageMask &mask)
+    {
+        this->filterImpl(messages, mask, !this->isNegated_);
+    }
+
+    /**
+     * @brief Returns true if this predicate reads parts of a message that can
+     *        still change after it was added to a channel (like its flags).
+     *
+     * Such predicates must only be checked in the GUI thread. All others only
+     * read parts that are immutable once a message is built.
+     **/
+    virtual bool readsMutableFields() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Returns a text that's contained (case-insensitively) in the
+     *        `searchText` of every message this predicate applies to.
+     *
+     * Searches use this to look up candidates in the MessageSearchIndex.
+     *
+     * @return the required text, or an empty string if there's none
+     **/
+    QString requiredText() const
+    {
+        if (this->isNegated_)
+        {
+            return {};
+        }
+        return this->requiredTextImpl();
+    }
+
 protected:
     explicit MessagePredicate(bool negate)
         : isNegated_(negate)
@@ -55,6 +176,40 @@ protected:
      */
     virtual bool appliesToImpl(const Message &message) = 0;
 
+    /**
+     * @brief Clears the bits of @a mask for the messages `appliesToImpl`
+     *        doesn't return @a expected for.
+     *
+     * The default implementation calls `appliesToImpl` for every set bit.
+     * Predicates that can share work between the messages of a batch should
+     * override this.
+     *
+     * @param messages the messages to check
+     * @param mask the messages to check
+     * @param expected the result of `appliesToImpl` that keeps a message
+     */
+    virtual void filterImpl(std::span<const MessagePtr> messages,
+                            MessageMask &mask, bool expected)
+    {
+        mask.forEachSet([&](size_t i) {
+            if (this->appliesToImpl(*messages[i]) != expected)
+            {
+                mask.reset(i);
+            }
+        });
+    }
+
+    /**
+     * @brief Returns the text every message this predicate applies to must
+     *        contain, ignoring `isNegated_`.
+     *
+     * @return the required text, or an empty string if there's none
+     */
+    virtual QString requiredTextImpl() const
+    {
+        return {};
+    }
+
 private:
     const bool isNegated_ = false;
 };
@@ -0,0 +1,190 @@
+#include "messages/search/MessageSearchIndex.hpp"
+
+#include "messages/Message.hpp"
+
+#include <algorithm>
+
+namespace {
+
+/// Stale postings are only dropped once there are at least this many
+constexpr size_t MIN_STALE_POSTINGS = 4096;
+
+}  // namespace
+
+namespace chatterino {
+
+void MessageSearchIndex::add(const MessagePtr &message)
+{
+    if (!message)
+    {
+        return;
+    }
+
+    auto [it, inserted] =
+        this->messages_.try_emplace(message.get(), Entry{.message = message});
+    if (!inserted)
+    {
+        it->second.references++;
+        return;
+    }
+
+    this->insertPostings(message.get(), message->searchText.toCaseFolded(),
+                         it->second);
+}
+
+void MessageSearchIndex::remove(const MessagePtr &message)
+{
+    auto it = this->messages_.find(message.get());
+    if (it == this->messages_.end() || it->second.message != message)
+    {
+        return;
+    }
+
+    if (--it->second.references > 0)
+    {
+        return;
+    }
+
+    this->stalePostings_ += it->second.trigrams;
+    this->messages_.erase(it);
+    this->compactIfNeeded();
+}
+
+void MessageSearchIndex::rebuild(
+    const LimitedQueueSnapshot<MessagePtr> &messages)
+{
+    this->clear();
+    for (const auto &message : messages)
+    {
+        this->add(message);
+    }
+}
+
+void MessageSearchIndex::clear()
+{
+    this->postings_.clear();
+    this->messages_.clear();
+    this->totalPostings_ = 0;
+    this->stalePostings_ = 0;
+}
+
+std::optional<MessageSearchIndex::Candidates> MessageSearchIndex::candidates(
+    const QStringList &terms) const
+{
+    // The posting lists that all have to contain a message
+    std::vector<const std::vector<const Message *> *> lists;
+    for (const auto &term : terms)
+    {
+        if (term.length() < MIN_TERM_LENGTH)
+        {
+            continue;
+        }
+
+        for (auto trigram : trigramsOf(term.toCaseFolded()))
+        {
+            auto it = this->postings_.find(trigram);
+            if (it == this->postings_.end())
+            {
+                // No message contains this trigram
+                return Candidates{};
+            }
+            lists.push_back(&it->second);
+        }
+    }
+
+    if (lists.empty())
+    {
+        return std::nullopt;
+    }
+
+    // Intersect starting with the shortest list, so the candidates only get
+    // smaller from there
+    std::sort(lists.begin(), lists.end(), [](auto *a, auto *b) {
+        return a->size() < b->size();
+    });
+
+    Candidates result;
+    for (const auto *message : *lists.front())
+    {
+        if (this->messages_.contains(message))
+        {
+            result.insert(message);
+        }
+    }
+
+    for (size_t i = 1; i < lists.size() && !result.empty(); i++)
+    {
+        Candidates next;
+        for (const auto *message : *lists[i])
+        {
+            if (result.contains(message))
+            {
+                next.insert(message);
+            }
+        }
+        result = std::move(next);
+    }
+
+    return result;
+}
+
+size_t MessageSearchIndex::size() const
+{
+    return this->messages_.size();
+}
+
+std::vector<MessageSearchIndex::Trigram> MessageSearchIndex::trigramsOf(
+    const QString &text)
+{
+    std::vector<Trigram> trigrams;
+    if (text.length() < MIN_TERM_LENGTH)
+    {
+        return trigrams;
+    }
+
+    trigrams.reserve(static_cast<size_t>(text.length() - 2));
+    for (qsizetype i = 0; i + 2 < text.length(); i++)
+    {
+        trigrams.push_back((Trigram{text[i].unicode()} << 32) |
+                           (Trigram{text[i + 1].unicode()} << 16) |
+                           Trigram{text[i + 2].unicode()});
+    }
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                   trigrams.end());
+    return trigrams;
+}
+
+void MessageSearchIndex::insertPostings(const Message *message,
+                                        const QString &text, Entry &entry)
+{
+    auto trigrams = trigramsOf(text);
+    for (auto trigram : trigrams)
+    {
+        this->postings_[trigram].push_back(message);
+    }
+
+    entry.trigrams = trigrams.size();
+    this->totalPostings_ += trigrams.size();
+}
+
+void MessageSearchIndex::compactIfNeeded()
+{
+    if (this->stalePostings_ < MIN_STALE_POSTINGS ||
+        this->stalePostings_ * 2 < this->totalPostings_)
+    {
+        return;
+    }
+
+    this->postings_.clear();
+    this->totalPostings_ = 0;
+    this->stalePostings_ = 0;
+    for (auto &[message, entry] : this->messages_)
+    {
+        this->insertPostings(message, entry.message->searchText.toCaseFolded(),
+                             entry);
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "messages/LimitedQueueSnapshot.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/// @brief Trigram index over the `searchText` of the messages of a channel
+///
+/// The index is used to narrow down the messages a search has to check. It
+/// returns a superset of the messages that contain a text: messages that
+/// share all trigrams with the text. Predicates still have to be checked on
+/// these candidates.
+///
+/// Removing a message only marks its entries as stale, they're dropped
+/// once enough of them piled up.
+///
+/// This must only be used from the GUI thread.
+class MessageSearchIndex
+{
+public:
+    using Candidates = boost::unordered_flat_set<const Message *>;
+
+    /// Texts shorter than this can't be looked up in the index
+    static constexpr qsizetype MIN_TERM_LENGTH = 3;
+
+    void add(const MessagePtr &message);
+    void remove(const MessagePtr &message);
+
+    /// Replaces the contents of the index with @a messages
+    void rebuild(const LimitedQueueSnapshot<MessagePtr> &messages);
+    void clear();
+
+    /// @brief Returns the messages that might contain all @a terms
+    ///
+    /// Terms are matched case-insensitively. Terms shorter than
+    /// MIN_TERM_LENGTH are ignored. If no term can be used, std::nullopt is
+    /// returned (every message is a candidate).
+    std::optional<Candidates> candidates(const QStringList &terms) const;
+
+    /// Returns the number of indexed messages
+    size_t size() const;
+
+private:
+    using Trigram = uint64_t;
+
+    struct Entry {
+        MessagePtr message;
+        size_t trigrams = 0;
+        /// How often the message was added (a message can be in a channel
+        /// more than once)
+        size_t references = 1;
+    };
+
+    /// Returns the unique trigrams of @a text (which must be case-folded)
+    static std::vector<Trigram> trigramsOf(const QString &text);
+
+    void insertPostings(const Message *message, const QString &text,
+                        Entry &entry);
+    void compactIfNeeded();
+
+    boost::unordered_flat_map<Trigram, std::vector<const Message *>>
+        postings_;
+    boost::unordered_flat_map<const Message *, Entry> messages_;
+
+    size_t totalPostings_ = 0;
+    size_t stalePostings_ = 0;
+};
+
+}  // namespace chatterino
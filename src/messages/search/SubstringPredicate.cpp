@@ -15,4 +15,9 @@ bool SubstringPredicate::appliesToImpl(const Message &message)
     return message.searchText.contains(this->search_, Qt::CaseInsensitive);
 }
 
+QString SubstringPredicate::requiredTextImpl() const
+{
+    return this->search_;
+}
+
 }  // namespace chatterino
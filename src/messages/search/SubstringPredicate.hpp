@@ -36,6 +36,11 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Returns the substring passed in the constructor.
+     */
+    QString requiredTextImpl() const override;
+
 private:
     /// Holds the substring to search for in a message's `messageText`
     const QString search_;
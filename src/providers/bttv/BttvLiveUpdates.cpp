@@ -1,8 +1,7 @@
 #include "providers/bttv/BttvLiveUpdates.hpp"
 
 #include "common/Literals.hpp"
-
-#include <QJsonDocument>
+#include "util/JsonFrame.hpp"
 
 #include <utility>
 
@@ -43,26 +42,25 @@ void BttvLiveUpdates::onMessage(
     websocketpp::connection_hdl /*hdl*/,
     BasicPubSubManager<BttvLiveUpdateSubscription>::WebsocketMessagePtr msg)
 {
-    const auto &payload = QString::fromStdString(msg->get_payload());
-    QJsonDocument jsonDoc(QJsonDocument::fromJson(payload.toUtf8()));
+    // Parsed in place, the frame isn't used afterwards
+    JsonFrame json(msg->get_raw_payload());
 
-    if (jsonDoc.isNull())
+    if (!json.isValid())
     {
         qCDebug(chatterinoBttv) << "Failed to parse live update JSON";
         return;
     }
-    auto json = jsonDoc.object();
 
-    auto eventType = json["name"].toString();
-    auto eventData = json["data"].toObject();
+    auto eventType = JsonFrame::string(json.root(), "name");
 
     if (eventType == "emote_create")
     {
+        auto eventData = JsonFrame::toQt(json.root(), "data");
         auto message = BttvLiveUpdateEmoteUpdateAddMessage(eventData);
 
         if (!message.validate())
         {
-            qCDebug(chatterinoBttv) << "Invalid add message" << json;
+            qCDebug(chatterinoBttv) << "Invalid add message" << eventData;
             return;
         }
 
@@ -70,11 +68,12 @@ void BttvLiveUpdates::onMessage(
     }
     else if (eventType == "emote_update")
     {
+        auto eventData = JsonFrame::toQt(json.root(), "data");
         auto message = BttvLiveUpdateEmoteUpdateAddMessage(eventData);
 
         if (!message.validate())
         {
-            qCDebug(chatterinoBttv) << "Invalid update message" << json;
+            qCDebug(chatterinoBttv) << "Invalid update message" << eventData;
             return;
         }
 
@@ -82,11 +81,12 @@ void BttvLiveUpdates::onMessage(
     }
     else if (eventType == "emote_delete")
     {
+        auto eventData = JsonFrame::toQt(json.root(), "data");
         auto message = BttvLiveUpdateEmoteRemoveMessage(eventData);
 
         if (!message.validate())
         {
-            qCDebug(chatterinoBttv) << "Invalid deletion message" << json;
+            qCDebug(chatterinoBttv) << "Invalid deletion message" << eventData;
             return;
         }
 
@@ -98,7 +98,8 @@ void BttvLiveUpdates::onMessage(
     }
     else
     {
-        qCDebug(chatterinoBttv) << "Unhandled event:" << json;
+        qCDebug(chatterinoBttv)
+            << "Unhandled event:" << JsonFrame::qString(json.root(), "name");
     }
 }
 
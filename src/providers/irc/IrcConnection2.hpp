@@ -32,8 +32,10 @@ public:
     virtual void close();
 
 private:
-    QTimer pingTimer_;
-    QTimer reconnectTimer_;
+    // The timers are children, so they move along when the connection is
+    // moved to another thread
+    QTimer pingTimer_{this};
+    QTimer reconnectTimer_{this};
     std::atomic<bool> recentlyReceivedMessage_{true};
     std::chrono::time_point<std::chrono::system_clock> lastPing_;
 
@@ -0,0 +1,134 @@
+#include "providers/irc/IrcIngest.hpp"
+
+#include "common/QLogging.hpp"
+#include "providers/irc/IrcConnection2.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QElapsedTimer>
+
+#include <cassert>
+
+namespace chatterino {
+
+IrcIngest::IrcIngest(std::function<void(const Line &)> handler)
+    : handler_(std::move(handler))
+    , queue_(BACKLOG_SIZE)
+{
+    this->thread_.setObjectName("IrcIngest");
+    this->thread_.start();
+}
+
+IrcIngest::~IrcIngest()
+{
+    // Connections that were deleted later are deleted once the thread
+    // finished
+    this->thread_.quit();
+    this->thread_.wait();
+}
+
+void IrcIngest::add(IrcConnection *connection)
+{
+    assert(connection->parent() == nullptr);
+
+    connection->moveToThread(&this->thread_);
+
+    // The message is deleted once the signal returns, so a copy of it leaves
+    // the ingest thread
+    QObject::connect(connection, &Communi::IrcConnection::messageReceived,
+                     connection,
+                     [this, connection](Communi::IrcMessage *message) {
+                         this->push(connection, message);
+                     });
+}
+
+void IrcIngest::runOn(IrcConnection *connection, std::function<void()> fn)
+{
+    QMetaObject::invokeMethod(connection, std::move(fn), Qt::QueuedConnection);
+}
+
+size_t IrcIngest::queued() const
+{
+    return this->queue_.size();
+}
+
+uint64_t IrcIngest::dropped() const
+{
+    return this->dropped_.load(std::memory_order_relaxed);
+}
+
+void IrcIngest::push(const IrcConnection *connection,
+                     Communi::IrcMessage *message)
+{
+    // Only we push, so the queue can't fill up after this check
+    if (this->queue_.size() >= this->queue_.capacity())
+    {
+        this->dropped_.fetch_add(1, std::memory_order_relaxed);
+        this->unreportedDrops_.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        // The clone copies the parsed message and has no parent, so it can be
+        // handed to the GUI thread
+        std::unique_ptr<Communi::IrcMessage> clone(message->clone());
+        clone->moveToThread(this->thread());
+
+        [[maybe_unused]] auto pushed = this->queue_.tryPush({
+            .connection = connection,
+            .message = std::move(clone),
+        });
+        assert(pushed);
+    }
+
+    if (!this->drainPending_.exchange(true))
+    {
+        QMetaObject::invokeMethod(
+            this,
+            [this] {
+                this->drain();
+            },
+            Qt::QueuedConnection);
+    }
+}
+
+void IrcIngest::drain()
+{
+    // Lines pushed from now on schedule another drain
+    this->drainPending_ = false;
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    while (auto line = this->queue_.tryPop())
+    {
+        this->handler_(*line);
+
+        if (elapsed.elapsed() >= SLICE_DURATION.count())
+        {
+            // Let the events that arrived in the meantime run first
+            if (this->queue_.size() > 0 && !this->drainPending_.exchange(true))
+            {
+                QMetaObject::invokeMethod(
+                    this,
+                    [this] {
+                        this->drain();
+                    },
+                    Qt::QueuedConnection);
+            }
+            break;
+        }
+    }
+
+    DebugCount::set("IRC ingest backlog",
+                    static_cast<int64_t>(this->queue_.size()));
+
+    auto drops = this->unreportedDrops_.exchange(0);
+    if (drops > 0)
+    {
+        DebugCount::increase("IRC ingest dropped lines",
+                             static_cast<int64_t>(drops));
+        qCWarning(chatterinoIrc)
+            << "IRC ingest backlog is full, dropped" << drops << "lines";
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "util/SpscQueue.hpp"
+
+#include <IrcMessage>
+#include <QObject>
+#include <QThread>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace chatterino {
+
+class IrcConnection;
+
+/// @brief Reads IRC connections on a dedicated thread
+///
+/// Connections added to this live on the ingest thread, where their sockets
+/// are read and their lines are parsed. The parsed messages are passed to the
+/// GUI thread through a bounded queue and handled there in slices, so a burst
+/// of messages doesn't block input handling and painting.
+///
+/// Everything but the signals of a connection has to be used from its own
+/// thread (see #runOn).
+class IrcIngest : public QObject
+{
+public:
+    struct Line {
+        /// The connection that received the line.
+        /// This must only be compared, the connection might be gone already.
+        const IrcConnection *connection = nullptr;
+        /// The message, which belongs to the GUI thread.
+        /// Its connection must not be used.
+        std::unique_ptr<Communi::IrcMessage> message;
+    };
+
+    /// Lines received while this many are waiting are dropped
+    static constexpr size_t BACKLOG_SIZE = 16384;
+
+    /// Time spent handling lines before letting the GUI thread do other work
+    static constexpr std::chrono::milliseconds SLICE_DURATION{8};
+
+    /// @a handler is called on the GUI thread for every line
+    explicit IrcIngest(std::function<void(const Line &)> handler);
+    ~IrcIngest() override;
+
+    IrcIngest(const IrcIngest &) = delete;
+    IrcIngest(IrcIngest &&) = delete;
+    IrcIngest &operator=(const IrcIngest &) = delete;
+    IrcIngest &operator=(IrcIngest &&) = delete;
+
+    /// Moves @a connection (which must not have a parent) to the ingest
+    /// thread and queues the messages it receives
+    void add(IrcConnection *connection);
+
+    /// Runs @a fn on the thread of @a connection.
+    /// @a fn isn't run if @a connection is destroyed before.
+    static void runOn(IrcConnection *connection, std::function<void()> fn);
+
+    /// Number of lines waiting to be handled
+    size_t queued() const;
+
+    /// Number of lines that were dropped because the backlog was full
+    uint64_t dropped() const;
+
+private:
+    /// Called on the ingest thread
+    void push(const IrcConnection *connection, Communi::IrcMessage *message);
+
+    /// Called on the GUI thread
+    void drain();
+
+    std::function<void(const Line &)> handler_;
+    QThread thread_;
+    SpscQueue<Line> queue_;
+
+    std::atomic<bool> drainPending_{false};
+    std::atomic<uint64_t> dropped_{0};
+    /// Dropped lines that weren't reported yet
+    std::atomic<uint64_t> unreportedDrops_{0};
+};
+
+}  // namespace chatterino
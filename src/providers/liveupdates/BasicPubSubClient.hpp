@@ -10,6 +10,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <unordered_set>
 
 namespace chatterino {
@@ -39,6 +40,8 @@ public:
         : maxSubscriptions(maxSubscriptions)
         , websocketClient_(websocketClient)
         , handle_(std::move(handle))
+        , idleTimer_(std::make_shared<boost::asio::steady_timer>(
+              websocketClient.get_io_service()))
     {
     }
 
@@ -173,12 +176,15 @@ private:
     {
         assert(this->isStarted());
         this->started_.store(false, std::memory_order_release);
+        this->idleTimer_->cancel();
 
         this->stopImpl();
     }
 
     liveupdates::WebsocketHandle handle_;
     std::unordered_set<Subscription> subscriptions_;
+    /// Closes the connection if it has no subscriptions (used by the manager)
+    std::shared_ptr<boost::asio::steady_timer> idleTimer_;
 
     std::atomic<bool> started_{false};
 
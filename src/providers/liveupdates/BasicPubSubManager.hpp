@@ -16,6 +16,7 @@
 #include <QScopeGuard>
 #include <QString>
 #include <QStringBuilder>
+#include <boost/asio/post.hpp>
 #include <websocketpp/client.hpp>
 
 #include <algorithm>
@@ -25,9 +26,8 @@
 #include <map>
 #include <memory>
 #include <thread>
-#include <unordered_map>
+#include <unordered_set>
 #include <utility>
-#include <vector>
 
 namespace chatterino {
 
@@ -46,7 +46,17 @@ namespace chatterino {
  *
  * You must expose your own subscribe and unsubscribe methods
  * (e.g. [un-]subscribeTopic).
- * This manager does not keep track of the subscriptions.
+ * This manager does not keep track of the subscriptions you want,
+ * only of the ones it sent and the ones waiting for a connection.
+ * Subscriptions are packed into the fullest connection that has room,
+ * so new connections are only opened if all others are full.
+ * Connections without subscriptions are closed after #IDLE_CLIENT_TIMEOUT.
+ * When a connection is lost, its subscriptions wait for a connection again.
+ * Changes made in the meantime are applied to the waiting subscriptions,
+ * so only the ones that are still wanted are sent after reconnecting.
+ *
+ * Subscribing and unsubscribing is done on the websocket thread,
+ * so both can be called from any thread.
  *
  * @tparam Subscription
  * The subscription has the following requirements:
@@ -110,6 +120,9 @@ public:
     BasicPubSubManager &operator=(const BasicPubSubManager &) = delete;
     BasicPubSubManager &operator=(const BasicPubSubManager &&) = delete;
 
+    /// Connections without subscriptions are closed after this time
+    static constexpr std::chrono::seconds IDLE_CLIENT_TIMEOUT{30};
+
     /** This is only used for testing. */
     struct {
         std::atomic<uint32_t> connectionsClosed{0};
@@ -214,28 +227,61 @@ protected:
 
     void unsubscribe(const Subscription &subscription)
     {
-        for (auto &client : this->clients_)
-        {
-            if (client.second->unsubscribe(subscription))
-            {
-                return;
-            }
-        }
+        boost::asio::post(this->websocketClient_.get_io_service(),
+                          [this, subscription] {
+                              this->unsubscribeNow(subscription);
+                          });
     }
 
     void subscribe(const Subscription &subscription)
     {
+        boost::asio::post(this->websocketClient_.get_io_service(),
+                          [this, subscription] {
+                              this->subscribeNow(subscription);
+                          });
+    }
+
+private:
+    void subscribeNow(const Subscription &subscription)
+    {
+        if (this->stopping_ ||
+            this->pendingSubscriptions_.contains(subscription))
+        {
+            return;
+        }
+
         if (this->trySubscribe(subscription))
         {
             return;
         }
 
-        this->addClient();
-        this->pendingSubscriptions_.emplace_back(subscription);
+        this->pendingSubscriptions_.emplace(subscription);
         DebugCount::increase("LiveUpdates subscription backlog");
+        this->addClient();
+    }
+
+    void unsubscribeNow(const Subscription &subscription)
+    {
+        // It was never sent, so there's nothing to tell the server
+        if (this->pendingSubscriptions_.erase(subscription) > 0)
+        {
+            DebugCount::decrease("LiveUpdates subscription backlog");
+            return;
+        }
+
+        for (auto &[hdl, client] : this->clients_)
+        {
+            if (client->unsubscribe(subscription))
+            {
+                if (client->subscriptions_.empty())
+                {
+                    this->closeWhenIdle(client);
+                }
+                return;
+            }
+        }
     }
 
-private:
     void onConnectionOpen(websocketpp::connection_hdl hdl)
     {
         DebugCount::increase("LiveUpdates connections");
@@ -259,21 +305,26 @@ private:
             << "LiveUpdate connection opened, subscribing to"
             << pendingSubsToTake << "subscriptions!";
 
-        while (pendingSubsToTake > 0 && !this->pendingSubscriptions_.empty())
+        auto it = this->pendingSubscriptions_.begin();
+        while (pendingSubsToTake > 0 && it != this->pendingSubscriptions_.end())
         {
-            const auto last = std::move(this->pendingSubscriptions_.back());
-            this->pendingSubscriptions_.pop_back();
-            if (!client->subscribe(last))
+            if (!client->subscribe(*it))
             {
                 qCDebug(chatterinoLiveupdates)
-                    << "Failed to subscribe to" << last << "on new client.";
-                // TODO: should we try to add a new client here?
-                return;
+                    << "Failed to subscribe to" << *it << "on new client.";
+                break;
             }
+            it = this->pendingSubscriptions_.erase(it);
             DebugCount::decrease("LiveUpdates subscription backlog");
             pendingSubsToTake--;
         }
 
+        if (client->subscriptions_.empty())
+        {
+            // Everything we connected for was unsubscribed in the meantime
+            this->closeWhenIdle(client);
+        }
+
         if (!this->pendingSubscriptions_.empty())
         {
             this->addClient();
@@ -325,11 +376,18 @@ private:
 
         client->stop();
 
+        DebugCount::decrease(
+            "LiveUpdates subscriptions",
+            static_cast<int64_t>(client->subscriptions_.size()));
+
         if (!this->stopping_)
         {
+            // Subscriptions removed while the connection was open aren't
+            // part of it anymore, and ones removed until we're connected
+            // again are dropped from the backlog (see #unsubscribeNow)
             for (const auto &sub : client->subscriptions_)
             {
-                this->subscribe(sub);
+                this->subscribeNow(sub);
             }
         }
     }
@@ -389,16 +447,46 @@ private:
         this->websocketClient_.connect(con);
     }
 
+    /// Subscribes on the fullest client that has room, so the others can
+    /// run empty and be closed
     bool trySubscribe(const Subscription &subscription)
     {
-        for (auto &client : this->clients_)
+        BasicPubSubClient<Subscription> *fullest = nullptr;
+        for (const auto &[hdl, client] : this->clients_)
         {
-            if (client.second->subscribe(subscription))
+            if (client->subscriptions_.contains(subscription))
             {
                 return true;
             }
+
+            auto size = client->subscriptions_.size();
+            if (size < client->maxSubscriptions &&
+                (fullest == nullptr || size > fullest->subscriptions_.size()))
+            {
+                fullest = client.get();
+            }
         }
-        return false;
+
+        return fullest != nullptr && fullest->subscribe(subscription);
+    }
+
+    void closeWhenIdle(
+        const std::shared_ptr<BasicPubSubClient<Subscription>> &client)
+    {
+        std::weak_ptr<BasicPubSubClient<Subscription>> weak = client;
+        runAfter(client->idleTimer_, IDLE_CLIENT_TIMEOUT,
+                 [this, weak](auto /*timer*/) {
+                     auto client = weak.lock();
+                     if (!client || !client->isStarted() || this->stopping_ ||
+                         !client->subscriptions_.empty())
+                     {
+                         return;
+                     }
+
+                     qCDebug(chatterinoLiveupdates)
+                         << "Closing connection without subscriptions";
+                     client->close("No subscriptions left");
+                 });
     }
 
     std::map<liveupdates::WebsocketHandle,
@@ -406,7 +494,8 @@ private:
              std::owner_less<liveupdates::WebsocketHandle>>
         clients_;
 
-    std::vector<Subscription> pendingSubscriptions_;
+    /// Subscriptions waiting for a connection with room
+    std::unordered_set<Subscription> pendingSubscriptions_;
     std::atomic<bool> addingClient_{false};
     ExponentialBackoff<5> connectBackoff_{std::chrono::milliseconds(1000)};
 
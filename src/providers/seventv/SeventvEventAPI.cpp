@@ -116,17 +116,26 @@ void SeventvEventAPI::onMessage(
     websocketpp::connection_hdl hdl,
     BasicPubSubManager<Subscription>::WebsocketMessagePtr msg)
 {
-    const auto &payload = QString::fromStdString(msg->get_payload());
+    // Parsed in place, the frame isn't used afterwards
+    auto &payload = msg->get_raw_payload();
+
+    // Parsing overwrites the payload, keep a copy to log it
+    std::string original;
+    if (chatterinoSeventvEventAPI().isDebugEnabled())
+    {
+        original = payload;
+    }
 
     auto pMessage = parseBaseMessage(payload);
 
     if (!pMessage)
     {
         qCDebug(chatterinoSeventvEventAPI)
-            << "Unable to parse incoming event-api message: " << payload;
+            << "Unable to parse incoming event-api message: "
+            << QString::fromStdString(original);
         return;
     }
-    auto message = *pMessage;
+    auto &message = *pMessage;
     switch (message.op)
     {
         case Opcode::Hello: {
@@ -155,7 +164,7 @@ void SeventvEventAPI::onMessage(
             if (!dispatch)
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Malformed dispatch" << payload;
+                    << "Malformed dispatch" << message.data;
                 return;
             }
             this->handleDispatch(*dispatch);
@@ -176,7 +185,8 @@ void SeventvEventAPI::onMessage(
         }
         break;
         default: {
-            qCDebug(chatterinoSeventvEventAPI) << "Unhandled op:" << payload;
+            qCDebug(chatterinoSeventvEventAPI)
+                << "Unhandled op:" << static_cast<int>(message.op);
         }
         break;
     }
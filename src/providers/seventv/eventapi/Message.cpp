@@ -1,23 +1,29 @@
 #include "providers/seventv/eventapi/Message.hpp"
 
+#include "util/JsonFrame.hpp"
+
 namespace chatterino::seventv::eventapi {
 
-Message::Message(QJsonObject _json)
-    : data(_json["d"].toObject())
-    , op(Opcode(_json["op"].toInt()))
+std::optional<Message> parseBaseMessage(std::string &frame)
 {
-}
+    JsonFrame json(frame);
+    if (!json.isValid())
+    {
+        return std::nullopt;
+    }
 
-std::optional<Message> parseBaseMessage(const QString &blob)
-{
-    QJsonDocument jsonDoc(QJsonDocument::fromJson(blob.toUtf8()));
+    Message message{
+        .data = {},
+        .op = Opcode(JsonFrame::integer(json.root(), "op", -1)),
+    };
 
-    if (jsonDoc.isNull())
+    // Heartbeats and acks don't need their data
+    if (message.op == Opcode::Dispatch || message.op == Opcode::Hello)
     {
-        return std::nullopt;
+        message.data = JsonFrame::toQt(json.root(), "d");
     }
 
-    return Message(jsonDoc.object());
+    return message;
 }
 
 }  // namespace chatterino::seventv::eventapi
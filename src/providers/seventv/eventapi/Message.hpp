@@ -3,21 +3,20 @@
 #include "providers/seventv/eventapi/Subscription.hpp"
 
 #include <magic_enum/magic_enum.hpp>
-#include <QJsonDocument>
 #include <QJsonObject>
 #include <QString>
 
 #include <optional>
+#include <string>
 
 namespace chatterino::seventv::eventapi {
 
 struct Message {
+    /// `d`, only converted for the opcodes that use it
     QJsonObject data;
 
     Opcode op;
 
-    Message(QJsonObject _json);
-
     template <class InnerClass>
     std::optional<InnerClass> toInner();
 };
@@ -28,6 +27,7 @@ std::optional<InnerClass> Message::toInner()
     return InnerClass{this->data};
 }
 
-std::optional<Message> parseBaseMessage(const QString &blob);
+/// Parses the websocket frame @a frame in place (see JsonFrame)
+std::optional<Message> parseBaseMessage(std::string &frame);
 
 }  // namespace chatterino::seventv::eventapi
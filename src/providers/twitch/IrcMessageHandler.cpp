@@ -18,6 +18,7 @@
 #include "providers/twitch/TwitchAccountManager.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchHelpers.hpp"
+#include "providers/twitch/TwitchIrcTags.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
@@ -84,7 +85,7 @@ MessagePtr generateBannedMessage(bool confirmedBan)
     return builder.release();
 }
 
-int stripLeadingReplyMention(const QVariantMap &tags, QString &content)
+int stripLeadingReplyMention(const TwitchIrcTags &tags, QString &content)
 {
     if (!getSettings()->stripReplyMention)
     {
@@ -96,10 +97,10 @@ int stripLeadingReplyMention(const QVariantMap &tags, QString &content)
         return 0;
     }
 
-    if (const auto it = tags.find("reply-parent-display-name");
-        it != tags.end())
+    if (tags.has(TwitchIrcTags::Tag::ReplyParentDisplayName))
     {
-        auto displayName = it.value().toString();
+        auto displayName =
+            tags.value(TwitchIrcTags::Tag::ReplyParentDisplayName).toString();
 
         if (content.length() <= 1 + displayName.length())
         {
@@ -119,7 +120,7 @@ int stripLeadingReplyMention(const QVariantMap &tags, QString &content)
     return 0;
 }
 
-void checkThreadSubscription(const QVariantMap &tags,
+void checkThreadSubscription(const TwitchIrcTags &tags,
                              const QString &senderLogin,
                              std::shared_ptr<MessageThread> &thread)
 {
@@ -137,14 +138,11 @@ void checkThreadSubscription(const QVariantMap &tags,
         {
             thread->markSubscribed();
         }
-        else if (const auto it = tags.find("reply-parent-user-login");
-                 it != tags.end())
+        else if (tags.has(TwitchIrcTags::Tag::ReplyParentUserLogin) &&
+                 tags.value(TwitchIrcTags::Tag::ReplyParentUserLogin) ==
+                     currentLogin)
         {
-            auto name = it.value().toString();
-            if (name == currentLogin)
-            {
-                thread->markSubscribed();
-            }
+            thread->markSubscribed();
         }
     }
 }
@@ -353,13 +351,18 @@ void IrcMessageHandler::parsePrivMessageInto(
     Communi::IrcPrivateMessage *message, MessageSink &sink,
     TwitchChannel *channel)
 {
+    using Tag = TwitchIrcTags::Tag;
+
+    auto tags = TwitchIrcTags::fromMessage(message);
+
     auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
-    if (message->tag("user-id") == currentUser->getUserId())
+    if (tags.has(Tag::UserId) &&
+        tags.value(Tag::UserId) == currentUser->getUserId())
     {
-        auto badgesTag = message->tag("badges");
-        if (badgesTag.isValid())
+        if (tags.has(Tag::Badges))
         {
-            auto parsedBadges = parseBadges(badgesTag.toString());
+            auto parsedBadges =
+                parseBadges(tags.value(Tag::Badges).toString());
             channel->setMod(parsedBadges.contains("moderator"));
             channel->setVIP(parsedBadges.contains("vip"));
             channel->setStaff(parsedBadges.contains("staff"));
@@ -367,10 +370,11 @@ void IrcMessageHandler::parsePrivMessageInto(
     }
 
     IrcMessageHandler::addMessage(
-        message, sink, channel, unescapeZeroWidthJoiner(message->content()),
-        *getApp()->getTwitch(), false, message->isAction());
+        message, tags, sink, channel,
+        unescapeZeroWidthJoiner(message->content()), *getApp()->getTwitch(),
+        false, message->isAction());
 
-    if (message->tags().contains(u"pinned-chat-paid-amount"_s))
+    if (tags.has(Tag::PinnedChatPaidAmount))
     {
         auto ptr = MessageBuilder::buildHypeChatMessage(message);
         if (ptr)
@@ -581,8 +585,8 @@ void IrcMessageHandler::handleWhisperMessage(Communi::IrcMessage *ircMessage)
     auto *c = getApp()->getTwitch()->getWhispersChannel().get();
 
     auto [message, alert] = MessageBuilder::makeIrcMessage(
-        c, ircMessage, args, unescapeZeroWidthJoiner(ircMessage->parameter(1)),
-        0);
+        c, ircMessage, TwitchIrcTags::fromMessage(ircMessage), args,
+        unescapeZeroWidthJoiner(ircMessage->parameter(1)), 0);
     if (!message)
     {
         return;
@@ -679,8 +683,8 @@ void IrcMessageHandler::parseUserNoticeMessageInto(Communi::IrcMessage *message,
         // Messages are not required, so they might be empty
         if (!content.isEmpty())
         {
-            addMessage(message, sink, channel, content, *getApp()->getTwitch(),
-                       true, false);
+            addMessage(message, TwitchIrcTags::fromMessage(message), sink,
+                       channel, content, *getApp()->getTwitch(), true, false);
         }
     }
 
@@ -965,6 +969,7 @@ void IrcMessageHandler::handlePartMessage(Communi::IrcMessage *message)
 }
 
 void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
+                                   const TwitchIrcTags &tags,
                                    MessageSink &sink, TwitchChannel *chan,
                                    const QString &originalContent,
                                    ITwitchIrcServer &twitch, bool isSub,
@@ -985,19 +990,21 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
     }
     args.isAction = isAction;
 
-    const auto &tags = message->tags();
+    using Tag = TwitchIrcTags::Tag;
+
     QString rewardId;
-    if (const auto it = tags.find("custom-reward-id"); it != tags.end())
+    if (tags.has(Tag::CustomRewardId))
     {
-        rewardId = it.value().toString();
+        rewardId = tags.value(Tag::CustomRewardId).toString();
     }
-    else if (const auto typeIt = tags.find("msg-id"); typeIt != tags.end())
+    else if (tags.has(Tag::MsgId))
     {
         // slight hack to treat bits power-ups as channel point redemptions
-        const auto msgId = typeIt.value().toString();
-        if (msgId == "animated-message" || msgId == "gigantified-emote-message")
+        const auto msgId = tags.value(Tag::MsgId);
+        if (msgId == u"animated-message" ||
+            msgId == u"gigantified-emote-message")
         {
-            rewardId = msgId;
+            rewardId = msgId.toString();
         }
     }
     if (!rewardId.isEmpty() &&
@@ -1018,10 +1025,10 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
 
     ReplyContext replyCtx;
 
-    if (const auto it = tags.find("reply-thread-parent-msg-id");
-        it != tags.end())
+    if (tags.has(Tag::ReplyThreadParentMsgId))
     {
-        const QString replyID = it.value().toString();
+        const QString replyID =
+            tags.value(Tag::ReplyThreadParentMsgId).toString();
         auto threadIt = chan->threads().find(replyID);
         std::shared_ptr<MessageThread> rootThread;
         if (threadIt != chan->threads().end() && !threadIt->second.expired())
@@ -1049,10 +1056,10 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
             }
         }
 
-        if (const auto parentIt = tags.find("reply-parent-msg-id");
-            parentIt != tags.end())
+        if (tags.has(Tag::ReplyParentMsgId))
         {
-            const QString parentID = parentIt.value().toString();
+            const QString parentID =
+                tags.value(Tag::ReplyParentMsgId).toString();
             if (replyID == parentID)
             {
                 if (rootThread)
@@ -1085,7 +1092,7 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
 
     args.allowIgnore = !isSub;
     auto [msg, alert] = MessageBuilder::makeIrcMessage(
-        chan, message, args, content, messageOffset, replyCtx.thread,
+        chan, message, tags, args, content, messageOffset, replyCtx.thread,
         replyCtx.parent);
 
     if (msg)
@@ -1094,7 +1101,7 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
         {
             msg->flags.set(MessageFlag::Subscription);
 
-            if (tags.value("msg-id") != "announcement")
+            if (tags.value(Tag::MsgId) != u"announcement")
             {
                 // Announcements are currently tagged as subscriptions,
                 // but we want them to be able to show up in mentions
@@ -15,6 +15,7 @@ using ChannelPtr = std::shared_ptr<Channel>;
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 class TwitchChannel;
+class TwitchIrcTags;
 class TwitchMessageBuilder;
 class MessageSink;
 
@@ -59,7 +60,8 @@ public:
     void handleJoinMessage(Communi::IrcMessage *message);
     void handlePartMessage(Communi::IrcMessage *message);
 
-    static void addMessage(Communi::IrcMessage *message, MessageSink &sink,
+    static void addMessage(Communi::IrcMessage *message,
+                           const TwitchIrcTags &tags, MessageSink &sink,
                            TwitchChannel *chan, const QString &originalContent,
                            ITwitchIrcServer &twitch, bool isSub, bool isAction);
 
@@ -831,20 +831,27 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl,
 {
     this->diag.messagesReceived += 1;
 
-    const auto &payload =
-        QString::fromStdString(websocketMessage->get_payload());
+    // Parsed in place, the frame isn't used afterwards
+    auto &payload = websocketMessage->get_raw_payload();
+
+    // Parsing overwrites the payload, keep a copy to log it
+    std::string original;
+    if (chatterinoPubSub().isDebugEnabled())
+    {
+        original = payload;
+    }
 
     auto oMessage = parsePubSubBaseMessage(payload);
 
     if (!oMessage)
     {
-        qCDebug(chatterinoPubSub)
-            << "Unable to parse incoming pubsub message" << payload;
+        qCDebug(chatterinoPubSub) << "Unable to parse incoming pubsub message"
+                                  << QString::fromStdString(original);
         this->diag.messagesFailedToParse += 1;
         return;
     }
 
-    auto message = *oMessage;
+    const auto &message = *oMessage;
 
     switch (message.type)
     {
@@ -870,7 +877,8 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl,
             auto oMessageMessage = message.toInner<PubSubMessageMessage>();
             if (!oMessageMessage)
             {
-                qCDebug(chatterinoPubSub) << "Malformed MESSAGE:" << payload;
+                qCDebug(chatterinoPubSub)
+                    << "Malformed MESSAGE:" << message.topic;
                 return;
             }
 
@@ -35,6 +35,7 @@
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchCommon.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
+#include "providers/twitch/TwitchIrcTags.hpp"
 #include "providers/twitch/TwitchUsers.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/Settings.hpp"
@@ -52,6 +53,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
+#include <QRandomGenerator>
 #include <QStringBuilder>
 #include <QThread>
 #include <QTimer>
@@ -90,6 +92,35 @@ namespace {
     // Maximum number of chatters to fetch when refreshing chatters
     constexpr auto MAX_CHATTERS_TO_FETCH = 5000;
 
+    // Chatters are refreshed every 5 minutes, give or take 20% so channels
+    // joined at the same time don't refresh together
+    constexpr std::chrono::milliseconds CHATTERS_REFRESH_INTERVAL =
+        std::chrono::minutes(5);
+    constexpr auto CHATTERS_REFRESH_JITTER = CHATTERS_REFRESH_INTERVAL / 5;
+
+    // A refresh that didn't finish within a minute is considered lost (e.g. a
+    // request that never called back), the next tick starts a new one
+    constexpr auto CHATTERS_REFRESH_TIMEOUT = std::chrono::minutes(1);
+
+    // The first refresh is delayed by up to 10 seconds, so joining many
+    // channels at startup doesn't fetch all of their chatters at once
+    constexpr std::chrono::milliseconds CHATTERS_INITIAL_STAGGER =
+        std::chrono::seconds(10);
+
+    std::chrono::milliseconds randomDuration(std::chrono::milliseconds max)
+    {
+        // bounded() has no overload for chrono's rep, the durations fit
+        // into an int
+        return std::chrono::milliseconds(QRandomGenerator::global()->bounded(
+            static_cast<int>(max.count()) + 1));
+    }
+
+    std::chrono::milliseconds nextChattersRefresh()
+    {
+        return CHATTERS_REFRESH_INTERVAL - CHATTERS_REFRESH_JITTER +
+               randomDuration(2 * CHATTERS_REFRESH_JITTER);
+    }
+
     // From Twitch docs - expected size for a badge (1x)
     constexpr QSize BASE_BADGE_SIZE(18, 18);
 }  // namespace
@@ -134,12 +165,14 @@ TwitchChannel::TwitchChannel(const QString &name)
     });
 
     // timers
+    // The timer is started in initialize() and re-armed with a new jitter
+    // after every refresh
+    this->chattersListTimer_.setSingleShot(true);
     QObject::connect(&this->chattersListTimer_, &QTimer::timeout, [this] {
         this->refreshChatters();
+        this->chattersListTimer_.start(nextChattersRefresh());
     });
 
-    this->chattersListTimer_.start(5 * 60 * 1000);
-
     QObject::connect(&this->threadClearTimer_, &QTimer::timeout, [this] {
         // We periodically check for any dangling reply threads that missed
         // being cleaned up on messageRemovedFromStart. This could occur if
@@ -209,7 +242,7 @@ TwitchChannel::~TwitchChannel()
 
 void TwitchChannel::initialize()
 {
-    this->refreshChatters();
+    this->chattersListTimer_.start(randomDuration(CHATTERS_INITIAL_STAGGER));
     this->refreshBadges();
 }
 
@@ -464,8 +497,9 @@ void TwitchChannel::addChannelPointReward(const ChannelPointReward &reward)
                     VectorMessageSink sink(
                         MessageSinkTrait::AddMentionsToGlobalChannel);
                     IrcMessageHandler::instance().addMessage(
-                        msg.message.get(), sink, this, msg.originalContent,
-                        *server, false, false);
+                        msg.message.get(),
+                        TwitchIrcTags::fromMessage(msg.message.get()), sink,
+                        this, msg.originalContent, *server, false, false);
                     if (sink.messages().empty())
                     {
                         return true;
@@ -1484,6 +1518,16 @@ void TwitchChannel::refreshPubSub()
 
     auto currentAccount = getApp()->getAccounts()->twitch.getCurrent();
 
+    // Subscriptions of visible channels are sent first
+    auto priority =
+        getApp()->getWindows()->getVisibleChannelNames().contains(
+            this->getName())
+            ? eventsub::SubscriptionPriority::Visible
+            : eventsub::SubscriptionPriority::Background;
+    auto subscribe = [priority](const eventsub::SubscriptionRequest &request) {
+        return getApp()->getEventSub()->subscribe(request, priority);
+    };
+
     getApp()->getTwitchPubSub()->listenToChannelModerationActions(roomId);
     if (this->hasModRights())
     {
@@ -1491,7 +1535,7 @@ void TwitchChannel::refreshPubSub()
         getApp()->getTwitchPubSub()->listenToLowTrustUsers(roomId);
 
         this->eventSubChannelModerateHandle =
-            getApp()->getEventSub()->subscribe(eventsub::SubscriptionRequest{
+            subscribe(eventsub::SubscriptionRequest{
                 .subscriptionType = "channel.moderate",
                 .subscriptionVersion = "2",
                 .conditions =
@@ -1507,7 +1551,7 @@ void TwitchChannel::refreshPubSub()
                     },
             });
         this->eventSubAutomodMessageHoldHandle =
-            getApp()->getEventSub()->subscribe(eventsub::SubscriptionRequest{
+            subscribe(eventsub::SubscriptionRequest{
                 .subscriptionType = "automod.message.hold",
                 .subscriptionVersion = "2",
                 .conditions =
@@ -1523,7 +1567,7 @@ void TwitchChannel::refreshPubSub()
                     },
             });
         this->eventSubAutomodMessageUpdateHandle =
-            getApp()->getEventSub()->subscribe(eventsub::SubscriptionRequest{
+            subscribe(eventsub::SubscriptionRequest{
                 .subscriptionType = "automod.message.update",
                 .subscriptionVersion = "2",
                 .conditions =
@@ -1539,7 +1583,7 @@ void TwitchChannel::refreshPubSub()
                     },
             });
         this->eventSubSuspiciousUserMessageHandle =
-            getApp()->getEventSub()->subscribe(eventsub::SubscriptionRequest{
+            subscribe(eventsub::SubscriptionRequest{
                 .subscriptionType = "channel.suspicious_user.message",
                 .subscriptionVersion = "1",
                 .conditions =
@@ -1555,7 +1599,7 @@ void TwitchChannel::refreshPubSub()
                     },
             });
         this->eventSubSuspiciousUserUpdateHandle =
-            getApp()->getEventSub()->subscribe(eventsub::SubscriptionRequest{
+            subscribe(eventsub::SubscriptionRequest{
                 .subscriptionType = "channel.suspicious_user.update",
                 .subscriptionVersion = "1",
                 .conditions =
@@ -1583,7 +1627,7 @@ void TwitchChannel::refreshPubSub()
         this->eventSubSuspiciousUserUpdateHandle.reset();
 
         this->eventSubChannelChatUserMessageHoldHandle =
-            getApp()->getEventSub()->subscribe(eventsub::SubscriptionRequest{
+            subscribe(eventsub::SubscriptionRequest{
                 .subscriptionType = "channel.chat.user_message_hold",
                 .subscriptionVersion = "1",
                 .conditions =
@@ -1600,7 +1644,7 @@ void TwitchChannel::refreshPubSub()
             });
 
         this->eventSubChannelChatUserMessageUpdateHandle =
-            getApp()->getEventSub()->subscribe(eventsub::SubscriptionRequest{
+            subscribe(eventsub::SubscriptionRequest{
                 .subscriptionType = "channel.chat.user_message_update",
                 .subscriptionVersion = "1",
                 .conditions =
@@ -1617,6 +1661,41 @@ void TwitchChannel::refreshPubSub()
             });
     }
 
+    // Subscriptions to other channels' stream events count against a small
+    // budget, so only our own channel is told about instead of polled
+    if (this->isBroadcaster())
+    {
+        this->eventSubStreamOnlineHandle =
+            subscribe(eventsub::SubscriptionRequest{
+                .subscriptionType = "stream.online",
+                .subscriptionVersion = "1",
+                .conditions =
+                    {
+                        {
+                            "broadcaster_user_id",
+                            roomId,
+                        },
+                    },
+            });
+        this->eventSubStreamOfflineHandle =
+            subscribe(eventsub::SubscriptionRequest{
+                .subscriptionType = "stream.offline",
+                .subscriptionVersion = "1",
+                .conditions =
+                    {
+                        {
+                            "broadcaster_user_id",
+                            roomId,
+                        },
+                    },
+            });
+    }
+    else
+    {
+        this->eventSubStreamOnlineHandle.reset();
+        this->eventSubStreamOfflineHandle.reset();
+    }
+
     getApp()->getTwitchPubSub()->listenToChannelPointRewards(roomId);
 }
 
@@ -1640,22 +1719,58 @@ void TwitchChannel::refreshChatters()
         }
     }
 
-    // Get chatter list via helix api
-    getHelix()->getChatters(
+    // Chatters of channels nobody is looking at aren't worth the requests
+    if (!getApp()->getWindows()->getVisibleChannelNames().contains(
+            this->getName()))
+    {
+        return;
+    }
+
+    // The previous refresh is still paginating
+    if (this->chattersRefreshTimer_.isValid() &&
+        !this->chattersRefreshTimer_.hasExpired(
+            std::chrono::milliseconds(CHATTERS_REFRESH_TIMEOUT).count()))
+    {
+        return;
+    }
+    this->chattersRefreshTimer_.start();
+    // Callbacks of a lost refresh must not touch the new one
+    auto generation = ++this->chattersRefreshGeneration_;
+    this->beginOnlineChattersUpdate();
+
+    auto isCurrent = [this, weak = weakOf<Channel>(this), generation] {
+        auto shared = weak.lock();
+        return shared && this->chattersRefreshGeneration_ == generation;
+    };
+
+    // Get chatter list via helix api, each page is added as it arrives
+    getHelix()->streamChatters(
         this->roomId(),
         getApp()->getAccounts()->twitch.getCurrent()->getUserId(),
         MAX_CHATTERS_TO_FETCH,
-        [this, weak = weakOf<Channel>(this)](auto result) {
-            if (auto shared = weak.lock())
+        [this, isCurrent](auto page) {
+            if (isCurrent())
+            {
+                this->addOnlineChatters(page.chatters,
+                                        static_cast<size_t>(page.total));
+                this->chatterCount_ = page.total;
+            }
+        },
+        [this, isCurrent] {
+            if (isCurrent())
             {
-                this->updateOnlineChatters(result.chatters);
-                this->chatterCount_ = result.total;
+                this->finishOnlineChattersUpdate();
+                this->chattersRefreshTimer_.invalidate();
             }
         },
         // Refresh chatters should only be used when failing silently is an option
-        [](auto error, auto message) {
+        [this, isCurrent](auto error, auto message) {
             (void)error;
             (void)message;
+            if (isCurrent())
+            {
+                this->chattersRefreshTimer_.invalidate();
+            }
         });
 }
 
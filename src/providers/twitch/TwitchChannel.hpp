@@ -429,6 +429,9 @@ private:
     const QString channelUrl_;
     const QString popoutPlayerUrl_;
     int chatterCount_{};
+    // Valid while chatters are being refreshed
+    QElapsedTimer chattersRefreshTimer_;
+    uint64_t chattersRefreshGeneration_{};
     UniqueAccess<StreamStatus> streamStatus_;
     UniqueAccess<RoomModes> roomModes;
     bool disconnected_{};
@@ -515,6 +518,8 @@ private:
     eventsub::SubscriptionHandle eventSubSuspiciousUserUpdateHandle;
     eventsub::SubscriptionHandle eventSubChannelChatUserMessageHoldHandle;
     eventsub::SubscriptionHandle eventSubChannelChatUserMessageUpdateHandle;
+    eventsub::SubscriptionHandle eventSubStreamOnlineHandle;
+    eventsub::SubscriptionHandle eventSubStreamOfflineHandle;
 
     friend class TwitchIrcServer;
     friend class MessageBuilder;
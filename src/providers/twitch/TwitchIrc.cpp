@@ -4,46 +4,60 @@
 #include "common/Aliases.hpp"
 #include "common/QLogging.hpp"
 #include "singletons/Emotes.hpp"
-#include "util/IrcHelpers.hpp"
 
 namespace {
 
 using namespace chatterino;
 
-void appendTwitchEmoteOccurrences(const QString &emote,
+/// Returns the part of @a text before the first @a separator
+QStringView firstSection(QStringView text, char16_t separator)
+{
+    auto index = text.indexOf(separator);
+    return index < 0 ? text : text.left(index);
+}
+
+unsigned int toUInt(QStringView text)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    return text.toString().toUInt();
+#else
+    return text.toUInt();
+#endif
+}
+
+void appendTwitchEmoteOccurrences(QStringView emote,
                                   std::vector<TwitchEmoteOccurrence> &vec,
                                   const std::vector<int> &correctPositions,
                                   const QString &originalMessage,
                                   int messageOffset)
 {
     auto *app = getApp();
-    if (!emote.contains(':'))
-    {
-        return;
-    }
-
-    auto parameters = emote.split(':');
 
-    if (parameters.length() < 2)
+    // "id:from-to,from-to"
+    auto colon = emote.indexOf(u':');
+    if (colon < 0)
     {
         return;
     }
 
-    auto id = EmoteId{parameters.at(0)};
+    auto id = EmoteId{emote.left(colon).toString()};
 
-    auto occurrences = parameters.at(1).split(',');
-
-    for (const QString &occurrence : occurrences)
+    auto occurrences = firstSection(emote.mid(colon + 1), u':');
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    for (auto occurrence : occurrences.split(u','))  // creates a QList
+#else
+    for (auto occurrence : occurrences.tokenize(u','))
+#endif
     {
-        auto coords = occurrence.split('-');
-
-        if (coords.length() < 2)
+        auto dash = occurrence.indexOf(u'-');
+        if (dash < 0)
         {
             return;
         }
 
-        auto from = coords.at(0).toUInt() - messageOffset;
-        auto to = coords.at(1).toUInt() - messageOffset;
+        auto from = toUInt(occurrence.left(dash)) - messageOffset;
+        auto to = toUInt(firstSection(occurrence.mid(dash + 1), u'-')) -
+                  messageOffset;
         auto maxPositions = correctPositions.size();
         if (from > to || to >= maxPositions)
         {
@@ -85,67 +99,72 @@ void appendTwitchEmoteOccurrences(const QString &emote,
 
 namespace chatterino {
 
-std::unordered_map<QString, QString> parseBadgeInfoTag(const QVariantMap &tags)
+std::unordered_map<QString, QString> parseBadgeInfoTag(
+    const TwitchIrcTags &tags)
 {
     std::unordered_map<QString, QString> infoMap;
 
-    auto infoIt = tags.constFind("badge-info");
-    if (infoIt == tags.end())
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    for (auto badge : tags.value(TwitchIrcTags::Tag::BadgeInfo)
+                          .split(u',', Qt::SkipEmptyParts))
+#else
+    for (auto badge : tags.value(TwitchIrcTags::Tag::BadgeInfo)
+                          .tokenize(u',', Qt::SkipEmptyParts))
+#endif
     {
-        return infoMap;
-    }
-
-    auto info = infoIt.value().toString().split(',', Qt::SkipEmptyParts);
-
-    for (const QString &badge : info)
-    {
-        infoMap.emplace(slashKeyValue(badge));
+        // "foo/bar/baz" is {"foo": "bar/baz"}
+        auto slash = badge.indexOf(u'/');
+        if (slash < 0)
+        {
+            infoMap.emplace(badge.toString(), QString());
+        }
+        else
+        {
+            infoMap.emplace(badge.left(slash).toString(),
+                            badge.mid(slash + 1).toString());
+        }
     }
 
     return infoMap;
 }
 
-std::vector<Badge> parseBadgeTag(const QVariantMap &tags)
+std::vector<Badge> parseBadgeTag(const TwitchIrcTags &tags)
 {
     std::vector<Badge> b;
 
-    auto badgesIt = tags.constFind("badges");
-    if (badgesIt == tags.end())
-    {
-        return b;
-    }
-
-    auto badges = badgesIt.value().toString().split(',', Qt::SkipEmptyParts);
-
-    for (const QString &badge : badges)
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    for (auto badge : tags.value(TwitchIrcTags::Tag::Badges)
+                          .split(u',', Qt::SkipEmptyParts))
+#else
+    for (auto badge : tags.value(TwitchIrcTags::Tag::Badges)
+                          .tokenize(u',', Qt::SkipEmptyParts))
+#endif
     {
-        if (!badge.contains('/'))
+        auto slash = badge.indexOf(u'/');
+        if (slash < 0)
         {
             continue;
         }
 
-        auto pair = slashKeyValue(badge);
-        b.emplace_back(Badge{pair.first, pair.second});
+        b.emplace_back(Badge{badge.left(slash).toString(),
+                             badge.mid(slash + 1).toString()});
     }
 
     return b;
 }
 
-std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const QVariantMap &tags,
+std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const TwitchIrcTags &tags,
                                                      const QString &content,
                                                      int messageOffset)
 {
     // Twitch emotes
     std::vector<TwitchEmoteOccurrence> twitchEmotes;
 
-    auto emotesTag = tags.find("emotes");
-
-    if (emotesTag == tags.end())
+    if (!tags.has(TwitchIrcTags::Tag::Emotes))
     {
         return twitchEmotes;
     }
 
-    QStringList emoteString = emotesTag.value().toString().split('/');
     std::vector<int> correctPositions;
     for (int i = 0; i < content.size(); ++i)
     {
@@ -154,7 +173,11 @@ std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const QVariantMap &tags,
             correctPositions.push_back(i);
         }
     }
-    for (const QString &emote : emoteString)
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    for (auto emote : tags.value(TwitchIrcTags::Tag::Emotes).split(u'/'))
+#else
+    for (auto emote : tags.value(TwitchIrcTags::Tag::Emotes).tokenize(u'/'))
+#endif
     {
         appendTwitchEmoteOccurrences(emote, twitchEmotes, correctPositions,
                                      content, messageOffset);
@@ -2,9 +2,9 @@
 
 #include "messages/Emote.hpp"
 #include "providers/twitch/TwitchBadge.hpp"
+#include "providers/twitch/TwitchIrcTags.hpp"
 
 #include <QString>
-#include <QVariantMap>
 
 #include <unordered_map>
 
@@ -33,7 +33,8 @@ struct TwitchEmoteOccurrence {
 ///
 /// @param tags The tags of the IRC message
 /// @returns A map of badge-names to their values
-std::unordered_map<QString, QString> parseBadgeInfoTag(const QVariantMap &tags);
+std::unordered_map<QString, QString> parseBadgeInfoTag(
+    const TwitchIrcTags &tags);
 
 /// @brief Parses the `badges` tag of an IRC message
 ///
@@ -46,7 +47,7 @@ std::unordered_map<QString, QString> parseBadgeInfoTag(const QVariantMap &tags);
 ///
 /// @param tags The tags of the IRC message
 /// @returns A list of badges (name and version)
-std::vector<Badge> parseBadgeTag(const QVariantMap &tags);
+std::vector<Badge> parseBadgeTag(const TwitchIrcTags &tags);
 
 /// @brief Parses Twitch emotes in an IRC message
 ///
@@ -60,7 +61,7 @@ std::vector<Badge> parseBadgeTag(const QVariantMap &tags);
 ///                      original message (`@a foo` (original message) -> `foo`
 ///                      (content)).
 /// @returns A list of emotes and their positions
-std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const QVariantMap &tags,
+std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const TwitchIrcTags &tags,
                                                      const QString &content,
                                                      int messageOffset);
 
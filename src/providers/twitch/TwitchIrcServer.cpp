@@ -13,6 +13,7 @@
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/irc/IrcConnection2.hpp"
+#include "providers/irc/IrcIngest.hpp"
 #include "providers/seventv/SeventvEmotes.hpp"
 #include "providers/seventv/SeventvEventAPI.hpp"
 #include "providers/twitch/api/Helix.hpp"
@@ -37,8 +38,10 @@
 #include <QMetaEnum>
 #include <QStringList>
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
+#include <iterator>
 #include <mutex>
 
 using namespace std::chrono_literals;
@@ -49,8 +52,17 @@ namespace {
 constexpr int JOIN_RATELIMIT_BUDGET = 18;
 constexpr int JOIN_RATELIMIT_COOLDOWN = 12500;
 
+constexpr int MAX_READ_CONNECTIONS = 16;
+
 using namespace chatterino;
 
+size_t readConnectionCount()
+{
+    return static_cast<size_t>(
+        std::clamp(getSettings()->twitchReadConnections.getValue(), 1,
+                   MAX_READ_CONNECTIONS));
+}
+
 void sendHelixMessage(const std::shared_ptr<TwitchChannel> &channel,
                       const QString &message, const QString &replyParentId = {})
 {
@@ -172,7 +184,17 @@ TwitchIrcServer::TwitchIrcServer()
         {
             return;
         }
-        this->readConnection_->sendRaw("JOIN #" + message);
+
+        // Channels of a connection that isn't connected are joined once it
+        // connects
+        auto *read = this->readConnectionFor(message);
+        if (read->connected)
+        {
+            auto *connection = read->connection.get();
+            IrcIngest::runOn(connection, [connection, message] {
+                connection->sendRaw("JOIN #" + message);
+            });
+        }
     };
     this->joinBucket_.reset(new RatelimitBucket(
         JOIN_RATELIMIT_BUDGET, JOIN_RATELIMIT_COOLDOWN, actuallyJoin, this));
@@ -193,46 +215,14 @@ TwitchIrcServer::TwitchIrcServer()
             this->writeConnection_->smartReconnect();
         });
 
-    // Listen to read connection message signals
-    this->readConnection_.reset(new IrcConnection);
-    this->readConnection_->moveToThread(QCoreApplication::instance()->thread());
-
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::messageReceived, this,
-                     [this](auto msg) {
-                         this->readConnectionMessageReceived(msg);
-                     });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::privateMessageReceived, this,
-                     [this](auto msg) {
-                         this->privateMessageReceived(msg);
-                     });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::connected, this, [this] {
-                         this->onReadConnected(this->readConnection_.get());
-                     });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::disconnected, this, [this] {
-                         this->onDisconnected();
-                     });
-    this->connections_.managedConnect(
-        this->readConnection_->connectionLost, [this](bool timeout) {
-            qCDebug(chatterinoIrc)
-                << "Read connection reconnect requested. Timeout:" << timeout;
-            if (timeout)
-            {
-                // Show additional message since this is going to interrupt a
-                // connection that is still "connected"
-                this->addGlobalSystemMessage(
-                    "Server connection timed out, reconnecting");
-            }
-            this->readConnection_->smartReconnect();
-        });
-    this->connections_.managedConnect(this->readConnection_->heartbeat, [this] {
-        this->markChannelsConnected();
+    this->ingest_ = std::make_unique<IrcIngest>([this](const auto &line) {
+        this->readMessageReceived(line.connection, line.message.get());
     });
+    this->createReadConnections(readConnectionCount());
 }
 
+TwitchIrcServer::~TwitchIrcServer() = default;
+
 void TwitchIrcServer::initialize()
 {
     getApp()->getAccounts()->twitch.currentUserChanged.connect([this]() {
@@ -791,9 +781,6 @@ void TwitchIrcServer::initializeConnection(IrcConnection *connection,
         caps.push_back("twitch.tv/membership");
     }
 
-    connection->network()->setSkipCapabilityValidation(true);
-    connection->network()->setRequestedCapabilities(caps);
-
     QString username = account->getUserName();
     QString oauthToken = account->getOAuthToken();
 
@@ -802,23 +789,37 @@ void TwitchIrcServer::initializeConnection(IrcConnection *connection,
         oauthToken.prepend("oauth:");
     }
 
-    connection->setUserName(username);
-    connection->setNickName(username);
-    connection->setRealName(username);
+    auto configure = [connection, caps, username, oauthToken,
+                      isAnon = account->isAnon()] {
+        connection->network()->setSkipCapabilityValidation(true);
+        connection->network()->setRequestedCapabilities(caps);
 
-    if (!account->isAnon())
-    {
-        connection->setPassword(oauthToken);
-    }
+        connection->setUserName(username);
+        connection->setNickName(username);
+        connection->setRealName(username);
+
+        if (!isAnon)
+        {
+            connection->setPassword(oauthToken);
+        }
 
-    // https://dev.twitch.tv/docs/irc#connecting-to-the-twitch-irc-server
-    // SSL disabled: irc://irc.chat.twitch.tv:6667 (or port 80)
-    // SSL enabled: irc://irc.chat.twitch.tv:6697 (or port 443)
-    connection->setHost(Env::get().twitchServerHost);
-    connection->setPort(Env::get().twitchServerPort);
-    connection->setSecure(Env::get().twitchServerSecure);
+        // https://dev.twitch.tv/docs/irc#connecting-to-the-twitch-irc-server
+        // SSL disabled: irc://irc.chat.twitch.tv:6667 (or port 80)
+        // SSL enabled: irc://irc.chat.twitch.tv:6697 (or port 443)
+        connection->setHost(Env::get().twitchServerHost);
+        connection->setPort(Env::get().twitchServerPort);
+        connection->setSecure(Env::get().twitchServerSecure);
+    };
 
-    this->open(type);
+    if (type == ConnectionType::Read)
+    {
+        // Read connections live on the ingest thread
+        IrcIngest::runOn(connection, configure);
+    }
+    else
+    {
+        configure();
+    }
 }
 
 std::shared_ptr<Channel> TwitchIrcServer::createChannel(
@@ -861,6 +862,25 @@ void TwitchIrcServer::privateMessageReceived(
     IrcMessageHandler::instance().handlePrivMessage(message, *this);
 }
 
+void TwitchIrcServer::readMessageReceived(const IrcConnection *connection,
+                                          Communi::IrcMessage *message)
+{
+    if (message->command() == "RECONNECT")
+    {
+        // Only the connection that received this has to reconnect
+        this->reconnectReadConnection(connection);
+    }
+    else if (message->type() == Communi::IrcMessage::Type::Private)
+    {
+        this->privateMessageReceived(
+            static_cast<Communi::IrcPrivateMessage *>(message));
+    }
+    else
+    {
+        this->readConnectionMessageReceived(message);
+    }
+}
+
 void TwitchIrcServer::readConnectionMessageReceived(
     Communi::IrcMessage *message)
 {
@@ -916,9 +936,10 @@ void TwitchIrcServer::readConnectionMessageReceived(
     }
     else if (command == "RECONNECT")
     {
+        // Messages of the read connections are handled in
+        // readMessageReceived, so this is a fake message without a connection
         this->addGlobalSystemMessage(
             "Twitch Servers requested us to reconnect, reconnecting");
-        this->markChannelsConnected();
         this->connect();
     }
 }
@@ -952,31 +973,33 @@ void TwitchIrcServer::writeConnectionMessageReceived(
 
 void TwitchIrcServer::onReadConnected(IrcConnection *connection)
 {
-    (void)connection;
-
-    std::vector<ChannelPtr> activeChannels;
+    auto *read = this->findReadConnection(connection);
+    if (read == nullptr)
     {
-        std::lock_guard lock(this->channelMutex);
-
-        activeChannels.reserve(this->channels.size());
-        for (const auto &weak : this->channels)
-        {
-            if (auto channel = weak.lock())
-            {
-                activeChannels.push_back(channel);
-            }
-        }
+        // The connection was replaced in the meantime
+        return;
     }
+    read->connected = true;
+
+    auto activeChannels = this->channelsOf(connection);
 
     // put the visible channels first
     auto visible = getApp()->getWindows()->getVisibleChannelNames();
 
-    std::ranges::stable_partition(activeChannels, [&](const auto &chan) {
-        return visible.contains(chan->getName());
-    });
+    auto hidden =
+        std::ranges::stable_partition(activeChannels, [&](const auto &chan) {
+            return visible.contains(chan->getName());
+        });
 
     // join channels
-    for (const auto &channel : activeChannels)
+    // The visible channels don't wait for the channels of other connections.
+    // They're queued in front in reverse, so they keep their order.
+    for (auto it = std::make_reverse_iterator(hidden.begin());
+         it != activeChannels.rend(); it++)
+    {
+        this->joinBucket_->sendFirst((*it)->getName());
+    }
+    for (const auto &channel : hidden)
     {
         this->joinBucket_->send(channel->getName());
     }
@@ -1013,22 +1036,21 @@ void TwitchIrcServer::onWriteConnected(IrcConnection *connection)
     (void)connection;
 }
 
-void TwitchIrcServer::onDisconnected()
+void TwitchIrcServer::onDisconnected(IrcConnection *connection)
 {
-    std::lock_guard<std::mutex> lock(this->channelMutex);
+    auto *read = this->findReadConnection(connection);
+    if (read == nullptr)
+    {
+        return;
+    }
+    read->connected = false;
 
     MessageBuilder b(systemMessage, "disconnected");
     b->flags.set(MessageFlag::DisconnectedMessage);
     auto disconnectedMsg = b.release();
 
-    for (std::weak_ptr<Channel> &weak : this->channels.values())
+    for (const auto &chan : this->channelsOf(connection))
     {
-        std::shared_ptr<Channel> chan = weak.lock();
-        if (!chan)
-        {
-            continue;
-        }
-
         chan->addMessage(disconnectedMsg, MessageContext::Original);
 
         if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
@@ -1783,31 +1805,33 @@ void TwitchIrcServer::dropSeventvChannel(const QString &userID,
     }
 }
 
-void TwitchIrcServer::markChannelsConnected()
+void TwitchIrcServer::markChannelsConnected(const IrcConnection *connection)
 {
-    this->forEachChannel([](const ChannelPtr &chan) {
+    for (const auto &chan : this->channelsOf(connection))
+    {
         if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
         {
             channel->markConnected();
         }
-    });
+    }
 }
 
 void TwitchIrcServer::addFakeMessage(const QString &data)
 {
     assertInGuiThread();
 
-    auto *fakeMessage = Communi::IrcMessage::fromData(
-        data.toUtf8(), this->readConnection_.get());
+    // The read connections live on another thread, so this can't use them
+    std::unique_ptr<Communi::IrcMessage> fakeMessage(
+        Communi::IrcMessage::fromData(data.toUtf8(), nullptr));
 
     if (fakeMessage->command() == "PRIVMSG")
     {
         this->privateMessageReceived(
-            static_cast<Communi::IrcPrivateMessage *>(fakeMessage));
+            static_cast<Communi::IrcPrivateMessage *>(fakeMessage.get()));
     }
     else
     {
-        this->readConnectionMessageReceived(fakeMessage);
+        this->readConnectionMessageReceived(fakeMessage.get());
     }
 }
 
@@ -1852,17 +1876,31 @@ void TwitchIrcServer::connect()
 
     this->disconnect();
 
+    this->createReadConnections(readConnectionCount());
+
     this->initializeConnection(this->writeConnection_.get(),
                                ConnectionType::Write);
-    this->initializeConnection(this->readConnection_.get(),
-                               ConnectionType::Read);
+    for (const auto &read : this->readConnections_)
+    {
+        this->initializeConnection(read->connection.get(),
+                                   ConnectionType::Read);
+    }
+
+    this->open(ConnectionType::Write);
+    this->open(ConnectionType::Read);
 }
 
 void TwitchIrcServer::disconnect()
 {
     std::lock_guard<std::mutex> locker(this->connectionMutex_);
 
-    this->readConnection_->close();
+    for (const auto &read : this->readConnections_)
+    {
+        IrcIngest::runOn(read->connection.get(),
+                         [connection = read->connection.get()] {
+                             connection->close();
+                         });
+    }
     this->writeConnection_->close();
 }
 
@@ -1907,22 +1945,23 @@ ChannelPtr TwitchIrcServer::getOrAddChannel(const QString &dirtyChannelName)
                                << "was destroyed";
         this->channels.remove(channelName);
 
-        if (this->readConnection_)
-        {
-            this->readConnection_->sendRaw("PART #" + channelName);
-        }
+        std::lock_guard<std::mutex> lock(this->connectionMutex_);
+        auto *connection =
+            this->readConnectionFor(channelName)->connection.get();
+        IrcIngest::runOn(connection, [connection, channelName] {
+            connection->sendRaw("PART #" + channelName);
+        });
     });
 
     // join IRC channel
     {
         std::lock_guard<std::mutex> lock2(this->connectionMutex_);
 
-        if (this->readConnection_)
+        if (this->readConnectionFor(channelName)->connected)
         {
-            if (this->readConnection_->isConnected())
-            {
-                this->joinBucket_->send(channelName);
-            }
+            // This was just opened, so it shouldn't wait for channels that are
+            // being rejoined
+            this->joinBucket_->sendFirst(channelName);
         }
     }
 
@@ -1967,8 +2006,142 @@ void TwitchIrcServer::open(ConnectionType type)
     }
     if (type == ConnectionType::Read)
     {
-        this->readConnection_->open();
+        for (const auto &read : this->readConnections_)
+        {
+            IrcIngest::runOn(read->connection.get(),
+                             [connection = read->connection.get()] {
+                                 connection->open();
+                             });
+        }
+    }
+}
+
+void TwitchIrcServer::createReadConnections(size_t count)
+{
+    std::lock_guard<std::mutex> lock(this->connectionMutex_);
+
+    if (this->readConnections_.size() == count)
+    {
+        return;
+    }
+
+    // Channels would move to other connections, so start over
+    this->readConnections_.clear();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto &read = this->readConnections_.emplace_back(
+            std::make_unique<ReadConnection>());
+        read->connection.reset(new IrcConnection);
+
+        auto *connection = read->connection.get();
+
+        // Messages are handled in readMessageReceived
+        this->ingest_->add(connection);
+
+        QObject::connect(connection, &Communi::IrcConnection::connected, this,
+                         [this, connection] {
+                             this->onReadConnected(connection);
+                         });
+        QObject::connect(connection, &Communi::IrcConnection::disconnected,
+                         this, [this, connection] {
+                             this->onDisconnected(connection);
+                         });
+
+        // These are invoked on the ingest thread
+        read->signalHolder.managedConnect(
+            connection->connectionLost, [this, connection, i](bool timeout) {
+                qCDebug(chatterinoIrc)
+                    << "Read connection" << i
+                    << "reconnect requested. Timeout:" << timeout;
+                if (timeout)
+                {
+                    // Show additional message since this is going to
+                    // interrupt a connection that is still "connected"
+                    postToThread([this, connection] {
+                        auto message = makeSystemMessage(
+                            "Server connection timed out, reconnecting");
+                        for (const auto &chan : this->channelsOf(connection))
+                        {
+                            chan->addMessage(message,
+                                             MessageContext::Original);
+                        }
+                    });
+                }
+                connection->smartReconnect();
+            });
+        read->signalHolder.managedConnect(
+            connection->heartbeat, [this, connection] {
+                postToThread([this, connection] {
+                    this->markChannelsConnected(connection);
+                });
+            });
+    }
+}
+
+TwitchIrcServer::ReadConnection *TwitchIrcServer::readConnectionFor(
+    const QString &channelName) const
+{
+    // With a fixed seed, a channel always ends up on the same connection
+    auto index = qHash(channelName, 0) % this->readConnections_.size();
+    return this->readConnections_[index].get();
+}
+
+TwitchIrcServer::ReadConnection *TwitchIrcServer::findReadConnection(
+    const IrcConnection *connection) const
+{
+    for (const auto &read : this->readConnections_)
+    {
+        if (read->connection.get() == connection)
+        {
+            return read.get();
+        }
+    }
+    return nullptr;
+}
+
+std::vector<ChannelPtr> TwitchIrcServer::channelsOf(
+    const IrcConnection *connection)
+{
+    std::vector<ChannelPtr> result;
+
+    std::lock_guard lock(this->channelMutex);
+    for (auto it = this->channels.begin(); it != this->channels.end(); it++)
+    {
+        if (this->readConnectionFor(it.key())->connection.get() != connection)
+        {
+            continue;
+        }
+        if (auto channel = it.value().lock())
+        {
+            result.push_back(std::move(channel));
+        }
+    }
+
+    return result;
+}
+
+void TwitchIrcServer::reconnectReadConnection(const IrcConnection *connection)
+{
+    auto *read = this->findReadConnection(connection);
+    if (read == nullptr)
+    {
+        return;
     }
+
+    auto text = makeSystemMessage(
+        "Twitch Servers requested us to reconnect, reconnecting");
+    for (const auto &chan : this->channelsOf(connection))
+    {
+        chan->addMessage(text, MessageContext::Original);
+    }
+
+    this->markChannelsConnected(connection);
+    IrcIngest::runOn(read->connection.get(),
+                     [connection = read->connection.get()] {
+                         connection->close();
+                         connection->open();
+                     });
 }
 
 }  // namespace chatterino
\ No newline at end of file
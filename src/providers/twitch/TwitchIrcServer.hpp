@@ -10,11 +10,13 @@
 #include <pajlada/signals/signal.hpp>
 #include <pajlada/signals/signalholder.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 namespace chatterino {
 
@@ -25,6 +27,7 @@ class BttvEmotes;
 class FfzEmotes;
 class SeventvEmotes;
 class RatelimitBucket;
+class IrcIngest;
 
 class ITwitchIrcServer
 {
@@ -80,7 +83,7 @@ public:
     };
 
     TwitchIrcServer();
-    ~TwitchIrcServer() override = default;
+    ~TwitchIrcServer() override;
 
     TwitchIrcServer(const TwitchIrcServer &) = delete;
     TwitchIrcServer(TwitchIrcServer &&) = delete;
@@ -159,13 +162,15 @@ protected:
     std::shared_ptr<Channel> createChannel(const QString &channelName);
 
     void privateMessageReceived(Communi::IrcPrivateMessage *message);
+    void readMessageReceived(const IrcConnection *connection,
+                             Communi::IrcMessage *message);
     void readConnectionMessageReceived(Communi::IrcMessage *message);
     void writeConnectionMessageReceived(Communi::IrcMessage *message);
 
     void onReadConnected(IrcConnection *connection);
     void onWriteConnected(IrcConnection *connection);
-    void onDisconnected();
-    void markChannelsConnected();
+    void onDisconnected(IrcConnection *connection);
+    void markChannelsConnected(const IrcConnection *connection);
 
     std::shared_ptr<Channel> getCustomChannel(const QString &channelname);
 
@@ -178,14 +183,48 @@ private:
 
     bool prepareToSend(const std::shared_ptr<TwitchChannel> &channel);
 
+    struct ReadConnection;
+
+    /// Replaces the read connections if there aren't @a count of them
+    void createReadConnections(size_t count);
+
+    /// Returns the read connection @a channelName is joined through
+    ReadConnection *readConnectionFor(const QString &channelName) const;
+
+    /// Returns the read connection of @a connection or nullptr if it's gone
+    ReadConnection *findReadConnection(const IrcConnection *connection) const;
+
+    /// Returns the channels joined through @a connection
+    std::vector<ChannelPtr> channelsOf(const IrcConnection *connection);
+
+    /// Reconnects @a connection after Twitch asked us to
+    void reconnectReadConnection(const IrcConnection *connection);
+
     QMap<QString, std::weak_ptr<Channel>> channels;
     std::mutex channelMutex;
 
     QObjectPtr<IrcConnection> writeConnection_ = nullptr;
-    QObjectPtr<IrcConnection> readConnection_ = nullptr;
+
+    /// Reads the read connections on its own thread. This has to outlive
+    /// them.
+    std::unique_ptr<IrcIngest> ingest_;
+
+    struct ReadConnection {
+        /// Lives on the ingest thread
+        QObjectPtr<IrcConnection> connection;
+        /// Whether the connection is connected (as seen from the GUI thread)
+        std::atomic<bool> connected{false};
+        pajlada::Signals::SignalHolder signalHolder;
+    };
+
+    /// Channels are spread across the read connections by their name. Each
+    /// connection joins, reconnects and rejoins on its own, and all messages
+    /// of a channel arrive through the same connection (in order).
+    std::vector<std::unique_ptr<ReadConnection>> readConnections_;
 
     // Our rate limiting bucket for the Twitch join rate limits
     // https://dev.twitch.tv/docs/irc/guide#rate-limits
+    // The limit applies to the account, so all read connections share it.
     QObjectPtr<RatelimitBucket> joinBucket_;
 
     QTimer reconnectTimer_;
@@ -0,0 +1,260 @@
+#include "providers/twitch/TwitchIrcTags.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <IrcMessage>
+#include <QHash>
+
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino;
+using Tag = TwitchIrcTags::Tag;
+
+constexpr std::array<std::pair<QStringView, Tag>,
+                     static_cast<size_t>(Tag::Count)>
+    KNOWN_TAGS{{
+        {u"badge-info", Tag::BadgeInfo},
+        {u"badges", Tag::Badges},
+        {u"bits", Tag::Bits},
+        {u"client-nonce", Tag::ClientNonce},
+        {u"color", Tag::Color},
+        {u"custom-reward-id", Tag::CustomRewardId},
+        {u"display-name", Tag::DisplayName},
+        {u"emotes", Tag::Emotes},
+        {u"first-msg", Tag::FirstMsg},
+        {u"historical", Tag::Historical},
+        {u"id", Tag::Id},
+        {u"login", Tag::Login},
+        {u"msg-id", Tag::MsgId},
+        {u"pinned-chat-paid-amount", Tag::PinnedChatPaidAmount},
+        {u"reply-parent-display-name", Tag::ReplyParentDisplayName},
+        {u"reply-parent-msg-body", Tag::ReplyParentMsgBody},
+        {u"reply-parent-msg-id", Tag::ReplyParentMsgId},
+        {u"reply-parent-user-id", Tag::ReplyParentUserId},
+        {u"reply-parent-user-login", Tag::ReplyParentUserLogin},
+        {u"reply-thread-parent-msg-id", Tag::ReplyThreadParentMsgId},
+        {u"rm-deleted", Tag::RmDeleted},
+        {u"rm-received-ts", Tag::RmReceivedTs},
+        {u"room-id", Tag::RoomId},
+        {u"source-room-id", Tag::SourceRoomId},
+        {u"time", Tag::Time},
+        {u"tmi-sent-ts", Tag::TmiSentTs},
+        {u"user-id", Tag::UserId},
+        {u"user-type", Tag::UserType},
+    }};
+
+struct ViewHash {
+    size_t operator()(QStringView view) const
+    {
+        return qHash(view);
+    }
+};
+
+const boost::unordered_flat_map<QStringView, Tag, ViewHash> &knownTags()
+{
+    static const auto tags = [] {
+        boost::unordered_flat_map<QStringView, Tag, ViewHash> map;
+        for (const auto &[key, tag] : KNOWN_TAGS)
+        {
+            map.emplace(key, tag);
+        }
+        return map;
+    }();
+    return tags;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+TwitchIrcTags TwitchIrcTags::fromMessage(const Communi::IrcMessage *message)
+{
+    TwitchIrcTags tags;
+
+    auto data = message->toData();
+    if (!data.startsWith('@'))
+    {
+        return tags;
+    }
+
+    auto end = data.indexOf(' ');
+    if (end < 0)
+    {
+        end = data.size();
+    }
+
+    tags.buffer_ = QString::fromUtf8(data.constData() + 1, end - 1);
+    tags.parse();
+    return tags;
+}
+
+TwitchIrcTags TwitchIrcTags::fromLine(QStringView line)
+{
+    TwitchIrcTags tags;
+
+    if (!line.startsWith(u'@'))
+    {
+        return tags;
+    }
+
+    auto end = line.indexOf(u' ');
+    if (end < 0)
+    {
+        end = line.size();
+    }
+
+    tags.buffer_ = line.mid(1, end - 1).toString();
+    tags.parse();
+    return tags;
+}
+
+QString TwitchIrcTags::unescape(QStringView value)
+{
+    auto escape = value.indexOf(u'\\');
+    if (escape < 0)
+    {
+        return value.toString();
+    }
+
+    QString output;
+    output.reserve(value.size());
+    output.append(value.data(), escape);
+
+    for (auto i = escape; i < value.size(); i++)
+    {
+        auto c = value[i];
+        if (c != u'\\')
+        {
+            output.append(c);
+            continue;
+        }
+
+        i++;
+        if (i == value.size())
+        {
+            // A trailing backslash is dropped
+            break;
+        }
+
+        switch (value[i].unicode())
+        {
+            case u':':
+                output.append(u';');
+                break;
+            case u's':
+                output.append(u' ');
+                break;
+            case u'r':
+                output.append(u'\r');
+                break;
+            case u'n':
+                output.append(u'\n');
+                break;
+            default:
+                // Includes "\\"
+                output.append(value[i]);
+                break;
+        }
+    }
+
+    return output;
+}
+
+bool TwitchIrcTags::has(Tag tag) const
+{
+    return !this->known_[static_cast<size_t>(tag)].isNull();
+}
+
+bool TwitchIrcTags::has(QStringView key) const
+{
+    auto it = knownTags().find(key);
+    if (it != knownTags().end())
+    {
+        return this->has(it->second);
+    }
+
+    return std::any_of(this->other_.begin(), this->other_.end(),
+                       [&](const auto &pair) {
+                           return pair.first == key;
+                       });
+}
+
+QStringView TwitchIrcTags::value(Tag tag) const
+{
+    return this->known_[static_cast<size_t>(tag)];
+}
+
+QStringView TwitchIrcTags::value(QStringView key) const
+{
+    auto it = knownTags().find(key);
+    if (it != knownTags().end())
+    {
+        return this->value(it->second);
+    }
+
+    // Later tags replace earlier ones
+    for (auto pair = this->other_.rbegin(); pair != this->other_.rend(); pair++)
+    {
+        if (pair->first == key)
+        {
+            return pair->second;
+        }
+    }
+    return {};
+}
+
+qint64 TwitchIrcTags::integer(Tag tag, bool *ok) const
+{
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    return this->value(tag).toString().toLongLong(ok);
+#else
+    return this->value(tag).toLongLong(ok);
+#endif
+}
+
+QString TwitchIrcTags::unescaped(Tag tag) const
+{
+    return TwitchIrcTags::unescape(this->value(tag));
+}
+
+QString TwitchIrcTags::unescaped(QStringView key) const
+{
+    return TwitchIrcTags::unescape(this->value(key));
+}
+
+void TwitchIrcTags::parse()
+{
+    const auto &known = knownTags();
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    for (auto tag : QStringView(this->buffer_).split(u';'))  // creates a QList
+#else
+    for (auto tag : QStringView(this->buffer_).tokenize(u';'))
+#endif
+    {
+        if (tag.isEmpty())
+        {
+            continue;
+        }
+
+        // A tag without a value is set, but empty. Its (empty) value still
+        // points into the buffer, so it's not null.
+        auto separator = tag.indexOf(u'=');
+        auto key = separator < 0 ? tag : tag.left(separator);
+        auto value = separator < 0 ? tag.mid(tag.size())
+                                   : tag.mid(separator + 1);
+
+        auto it = known.find(key);
+        if (it != known.end())
+        {
+            this->known_[static_cast<size_t>(it->second)] = value;
+        }
+        else
+        {
+            this->other_.emplace_back(key, value);
+        }
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Communi {
+class IrcMessage;
+}  // namespace Communi
+
+namespace chatterino {
+
+/// @brief The IRCv3 tags of a message received from Twitch
+///
+/// The tag section of the raw line is copied once. Values are views into that
+/// copy and are only unescaped when they're read through #unescaped. Tags
+/// Twitch sends with chat messages are resolved to fixed slots while parsing,
+/// so looking them up doesn't compare any strings.
+///
+/// Unlike `Communi::IrcMessage::tags`, this doesn't build a map of variants
+/// for every message.
+class TwitchIrcTags
+{
+public:
+    enum class Tag : uint8_t {
+        BadgeInfo,
+        Badges,
+        Bits,
+        ClientNonce,
+        Color,
+        CustomRewardId,
+        DisplayName,
+        Emotes,
+        FirstMsg,
+        Historical,
+        Id,
+        Login,
+        MsgId,
+        PinnedChatPaidAmount,
+        ReplyParentDisplayName,
+        ReplyParentMsgBody,
+        ReplyParentMsgId,
+        ReplyParentUserId,
+        ReplyParentUserLogin,
+        ReplyThreadParentMsgId,
+        RmDeleted,
+        RmReceivedTs,
+        RoomId,
+        SourceRoomId,
+        Time,
+        TmiSentTs,
+        UserId,
+        UserType,
+
+        Count,
+    };
+
+    /// Parses the tags of @a message, which has to be created from a raw
+    /// line (like all messages received from a connection)
+    static TwitchIrcTags fromMessage(const Communi::IrcMessage *message);
+
+    /// Parses the tags of the raw IRC line @a line (starting with '@')
+    static TwitchIrcTags fromLine(QStringView line);
+
+    /// Unescapes an IRCv3 tag value
+    static QString unescape(QStringView value);
+
+    TwitchIrcTags() = default;
+    ~TwitchIrcTags() = default;
+
+    TwitchIrcTags(const TwitchIrcTags &) = delete;
+    TwitchIrcTags &operator=(const TwitchIrcTags &) = delete;
+
+    TwitchIrcTags(TwitchIrcTags &&) = default;
+    TwitchIrcTags &operator=(TwitchIrcTags &&) = default;
+
+    bool has(Tag tag) const;
+    bool has(QStringView key) const;
+
+    /// Returns the value of @a tag as sent (still escaped).
+    /// Returns an empty view if the tag is missing.
+    QStringView value(Tag tag) const;
+    QStringView value(QStringView key) const;
+
+    /// Returns the value of @a tag as a number.
+    /// Returns 0 and sets @a ok to false if it's missing or not a number.
+    qint64 integer(Tag tag, bool *ok = nullptr) const;
+
+    /// Returns the unescaped value of @a tag
+    QString unescaped(Tag tag) const;
+    QString unescaped(QStringView key) const;
+
+private:
+    void parse();
+
+    /// The tag section of the line without the leading '@'
+    QString buffer_;
+    std::array<QStringView, static_cast<size_t>(Tag::Count)> known_{};
+    /// Tags without a fixed slot
+    std::vector<std::pair<QStringView, QStringView>> other_;
+};
+
+}  // namespace chatterino
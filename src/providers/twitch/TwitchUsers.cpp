@@ -3,13 +3,39 @@
 #include "common/QLogging.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/TwitchUser.hpp"
+#include "providers/twitch/TwitchUsersCache.hpp"
+#include "singletons/Paths.hpp"
+#include "util/CombinePath.hpp"
+#include "util/PostToThread.hpp"
 
 #include <boost/unordered/unordered_flat_map.hpp>
+#include <QDateTime>
+#include <QFuture>
 #include <QStringList>
+#include <QtConcurrent>
 #include <QTimer>
 
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
 namespace {
 
+using namespace chatterino;
+using namespace chatterino::twitchusers::detail;
+
+/// Users are resolved again once their data is this old
+constexpr std::chrono::days USER_TTL{7};
+
+/// Maximum number of users in one Helix request
+constexpr qsizetype BATCH_SIZE = 100;
+
+/// At most this many Helix requests are made at the same time
+constexpr size_t MAX_REQUESTS_IN_FLIGHT = 4;
+
+/// Changes are written to the cache this often
+constexpr std::chrono::seconds SAVE_INTERVAL{60};
+
 auto withSelf(auto *ptr, auto cb)
 {
     return [weak{ptr->weak_from_this()}, cb = std::move(cb)](auto &&...args) {
@@ -30,107 +56,162 @@ class TwitchUsersPrivate
     : public std::enable_shared_from_this<TwitchUsersPrivate>
 {
 public:
-    TwitchUsersPrivate();
+    explicit TwitchUsersPrivate(QString cachePath);
 
 private:
-    boost::unordered_flat_map<UserId, std::shared_ptr<TwitchUser>> cache;
+    struct Entry {
+        std::shared_ptr<TwitchUser> user;
+
+        /// When the user was resolved through Helix, invalid if it wasn't
+        QDateTime resolvedAt;
+
+        /// Set while the user is queued or being requested
+        bool isPending = false;
+    };
+
+    boost::unordered_flat_map<UserId, Entry> cache;
     QStringList unresolved;
     QTimer nextBatchTimer;
-    bool isResolving = false;
+    size_t requestsInFlight = 0;
+
+    const QString cachePath;
+    QTimer saveTimer;
+    /// Requests wait until the cache is loaded
+    bool isLoaded = false;
+    /// Set if the cache changed since it was last written
+    bool isDirty = false;
+    bool isSaving = false;
+    /// The write of the last save, which might still be running
+    QFuture<void> saveFuture;
 
+    std::shared_ptr<TwitchUser> resolve(const UserId &id);
     std::shared_ptr<TwitchUser> makeUnresolved(const UserId &id);
-    void makeNextRequest();
+    void enqueue(const QString &id, Entry &entry);
+    void makeNextRequests();
     void updateUsers(const std::vector<HelixUser> &users);
+    void onRequestFinished(const QStringList &ids);
+
+    void load();
+    void onLoaded(const std::vector<CachedUser> &users);
+    std::vector<CachedUser> snapshot() const;
+    void save();
 
     friend TwitchUsers;
 };
 
-TwitchUsers::TwitchUsers()
-    : private_(new TwitchUsersPrivate)
+TwitchUsers::TwitchUsers(const Paths &paths)
+    : private_(std::make_shared<TwitchUsersPrivate>(
+          combinePath(paths.cacheDirectory(), "twitch-users.json")))
 {
+    this->private_->load();
 }
 
-TwitchUsers::~TwitchUsers() = default;
-
-std::shared_ptr<TwitchUser> TwitchUsers::resolveID(const UserId &id)
+TwitchUsers::~TwitchUsers()
 {
-    auto cached = this->private_->cache.find(id);
-    if (cached != this->private_->cache.end())
+    // A partially loaded cache must not replace the one on disk
+    if (this->private_->isLoaded && this->private_->isDirty)
     {
-        return cached->second;
+        // Otherwise, the older snapshot could be written last
+        this->private_->saveFuture.waitForFinished();
+        saveUserCache(this->private_->cachePath, this->private_->snapshot());
     }
-    return this->private_->makeUnresolved(id);
 }
 
-TwitchUsersPrivate::TwitchUsersPrivate()
+std::shared_ptr<TwitchUser> TwitchUsers::resolveID(const UserId &id)
+{
+    return this->private_->resolve(id);
+}
+
+TwitchUsersPrivate::TwitchUsersPrivate(QString cachePath)
+    : cachePath(std::move(cachePath))
 {
     this->nextBatchTimer.setSingleShot(true);
     // Wait for multiple request batches to come in before making a request
     this->nextBatchTimer.setInterval(250);
 
     QObject::connect(&this->nextBatchTimer, &QTimer::timeout, [this] {
-        this->makeNextRequest();
+        this->makeNextRequests();
+    });
+
+    QObject::connect(&this->saveTimer, &QTimer::timeout, [this] {
+        this->save();
     });
+    this->saveTimer.start(SAVE_INTERVAL);
+}
+
+std::shared_ptr<TwitchUser> TwitchUsersPrivate::resolve(const UserId &id)
+{
+    auto cached = this->cache.find(id);
+    if (cached == this->cache.end())
+    {
+        return this->makeUnresolved(id);
+    }
+
+    auto &entry = cached->second;
+    if (!entry.isPending && entry.resolvedAt.isValid() &&
+        isOlderThan(entry.resolvedAt, USER_TTL,
+                    QDateTime::currentDateTimeUtc()))
+    {
+        // Keep showing the old name until the request finishes
+        this->enqueue(id.string, entry);
+    }
+    return entry.user;
 }
 
 std::shared_ptr<TwitchUser> TwitchUsersPrivate::makeUnresolved(const UserId &id)
 {
     // assumption: Cache entry is empty so neither a shared pointer was created
     //             nor an entry in the unresolved list was added.
-    auto ptr = this->cache
-                   .emplace(id, std::make_shared<TwitchUser>(TwitchUser{
-                                    .id = id.string,
-                                    .name = {},
-                                    .displayName = {},
-                                }))
-                   .first->second;
-    if (id.string.isEmpty())
+    auto user = std::make_shared<TwitchUser>(TwitchUser{
+        .id = id.string,
+        .name = {},
+        .displayName = {},
+    });
+    auto &entry = this->cache.emplace(id, Entry{.user = user}).first->second;
+    if (!id.string.isEmpty())
     {
-        return ptr;
+        this->enqueue(id.string, entry);
     }
+    return entry.user;
+}
 
-    this->unresolved.append(id.string);
-    if (!this->isResolving && !this->nextBatchTimer.isActive())
+void TwitchUsersPrivate::enqueue(const QString &id, Entry &entry)
+{
+    entry.isPending = true;
+    this->unresolved.append(id);
+    if (this->isLoaded && !this->nextBatchTimer.isActive())
     {
         this->nextBatchTimer.start();
     }
-    return ptr;
 }
 
-void TwitchUsersPrivate::makeNextRequest()
+void TwitchUsersPrivate::makeNextRequests()
 {
-    if (this->unresolved.empty())
+    while (!this->unresolved.empty() &&
+           this->requestsInFlight < MAX_REQUESTS_IN_FLIGHT)
     {
-        return;
-    }
+        auto ids = this->unresolved.mid(0, BATCH_SIZE);
+        this->unresolved.erase(this->unresolved.begin(),
+                               this->unresolved.begin() + ids.size());
+        this->requestsInFlight++;
 
-    if (this->isResolving)
-    {
-        qCWarning(chatterinoTwitch) << "Tried to start request while resolving";
-        return;
+        getHelix()->fetchUsers(
+            ids, {},
+            withSelf(this,
+                     [ids](auto self, const auto &users) {
+                         self->updateUsers(users);
+                         self->onRequestFinished(ids);
+                     }),
+            withSelf(this, [ids](auto self) {
+                qCWarning(chatterinoTwitch) << "Failed to load users";
+                self->onRequestFinished(ids);
+            }));
     }
-    this->isResolving = true;
-
-    auto ids = this->unresolved.mid(
-        0, std::min<qsizetype>(this->unresolved.size(), 100));
-    this->unresolved = this->unresolved.mid(ids.length());
-    getHelix()->fetchUsers(ids, {},
-                           withSelf(this,
-                                    [](auto self, const auto &users) {
-                                        self->updateUsers(users);
-                                        self->isResolving = false;
-                                        self->makeNextRequest();
-                                    }),
-                           withSelf(this, [](auto self) {
-                               qCWarning(chatterinoTwitch)
-                                   << "Failed to load users";
-                               self->isResolving = false;
-                               self->makeNextRequest();
-                           }));
 }
 
 void TwitchUsersPrivate::updateUsers(const std::vector<HelixUser> &users)
 {
+    auto now = QDateTime::currentDateTimeUtc();
     for (const auto &user : users)
     {
         auto cached = this->cache.find(UserId{user.id});
@@ -140,8 +221,141 @@ void TwitchUsersPrivate::updateUsers(const std::vector<HelixUser> &users)
                                         << "with id" << user.id << "in cache";
             continue;
         }
-        cached->second->update(user);
+        cached->second.user->update(user);
+        cached->second.resolvedAt = now;
+    }
+
+    if (!users.empty())
+    {
+        this->isDirty = true;
+    }
+}
+
+void TwitchUsersPrivate::onRequestFinished(const QStringList &ids)
+{
+    for (const auto &id : ids)
+    {
+        auto cached = this->cache.find(UserId{id});
+        if (cached != this->cache.end())
+        {
+            cached->second.isPending = false;
+        }
+    }
+
+    this->requestsInFlight--;
+    this->makeNextRequests();
+}
+
+void TwitchUsersPrivate::load()
+{
+    auto onLoaded =
+        withSelf(this, [](auto self, const std::vector<CachedUser> &users) {
+            self->onLoaded(users);
+        });
+
+    std::ignore = QtConcurrent::run(
+        [path = this->cachePath, onLoaded = std::move(onLoaded)]() mutable {
+            postToGuiThread([onLoaded = std::move(onLoaded),
+                             users = loadUserCache(path)] {
+                onLoaded(users);
+            });
+        });
+}
+
+void TwitchUsersPrivate::onLoaded(const std::vector<CachedUser> &users)
+{
+    for (const auto &cachedUser : users)
+    {
+        auto &entry = this->cache[UserId{cachedUser.id}];
+        if (entry.resolvedAt.isValid())
+        {
+            // We resolved the user while the cache was loading
+            continue;
+        }
+
+        if (entry.user)
+        {
+            // The user was requested while the cache was loading
+            entry.user->name = cachedUser.login;
+            entry.user->displayName = cachedUser.displayName;
+        }
+        else
+        {
+            entry.user = std::make_shared<TwitchUser>(TwitchUser{
+                .id = cachedUser.id,
+                .name = cachedUser.login,
+                .displayName = cachedUser.displayName,
+            });
+        }
+        entry.resolvedAt = cachedUser.resolvedAt;
+    }
+
+    this->isLoaded = true;
+
+    // Users requested while the cache was loading don't need a request
+    // anymore if the cache knows them
+    auto now = QDateTime::currentDateTimeUtc();
+    auto known = std::remove_if(
+        this->unresolved.begin(), this->unresolved.end(),
+        [&](const QString &id) {
+            auto cached = this->cache.find(UserId{id});
+            if (cached == this->cache.end() ||
+                isOlderThan(cached->second.resolvedAt, USER_TTL, now))
+            {
+                return false;
+            }
+            cached->second.isPending = false;
+            return true;
+        });
+    this->unresolved.erase(known, this->unresolved.end());
+
+    if (!this->unresolved.empty())
+    {
+        this->nextBatchTimer.start();
+    }
+}
+
+std::vector<CachedUser> TwitchUsersPrivate::snapshot() const
+{
+    std::vector<CachedUser> users;
+    users.reserve(this->cache.size());
+    for (const auto &[id, entry] : this->cache)
+    {
+        if (!entry.resolvedAt.isValid() || entry.user->name.isEmpty())
+        {
+            continue;
+        }
+
+        users.push_back({
+            .id = entry.user->id,
+            .login = entry.user->name,
+            .displayName = entry.user->displayName,
+            .resolvedAt = entry.resolvedAt,
+        });
     }
+    return users;
+}
+
+void TwitchUsersPrivate::save()
+{
+    if (!this->isLoaded || !this->isDirty || this->isSaving)
+    {
+        return;
+    }
+
+    this->isDirty = false;
+    this->isSaving = true;
+
+    auto onSaved = withSelf(this, [](auto self) {
+        self->isSaving = false;
+    });
+
+    this->saveFuture = QtConcurrent::run(
+        [path = this->cachePath, users = this->snapshot(),
+         onSaved = std::move(onSaved)]() mutable {
+            saveUserCache(path, std::move(users));
+            postToGuiThread(std::move(onSaved));
+        });
 }
 
 }  // namespace chatterino
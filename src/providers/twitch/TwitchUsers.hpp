@@ -8,6 +8,7 @@ namespace chatterino {
 
 struct TwitchUser;
 class TwitchChannel;
+class Paths;
 
 class ITwitchUsers
 {
@@ -32,10 +33,17 @@ public:
 };
 
 class TwitchUsersPrivate;
+
+/// @brief Resolves Twitch users by their ID
+///
+/// Resolved users are stored in the cache directory and loaded in the
+/// background on startup, so names are known right away. Users whose data is
+/// older than a few days are resolved again when they're used. Unresolved
+/// users are requested in batches of 100, with a few requests in parallel.
 class TwitchUsers : public ITwitchUsers
 {
 public:
-    TwitchUsers();
+    explicit TwitchUsers(const Paths &paths);
     ~TwitchUsers() override;
     TwitchUsers(const TwitchUsers &) = delete;
     TwitchUsers(TwitchUsers &&) = delete;
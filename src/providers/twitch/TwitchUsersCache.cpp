@@ -0,0 +1,136 @@
+#include "providers/twitch/TwitchUsersCache.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <algorithm>
+
+namespace {
+
+constexpr int CACHE_VERSION = 1;
+
+QDateTime secondsToDateTime(const QJsonValue &value)
+{
+    return QDateTime::fromSecsSinceEpoch(value.toVariant().toLongLong());
+}
+
+}  // namespace
+
+namespace chatterino::twitchusers::detail {
+
+bool isOlderThan(const QDateTime &time, std::chrono::seconds age,
+                 const QDateTime &now)
+{
+    return !time.isValid() || time.secsTo(now) >= age.count();
+}
+
+std::vector<CachedUser> parseUserCache(const QByteArray &data,
+                                       const QDateTime &now)
+{
+    QJsonParseError error;
+    auto document = QJsonDocument::fromJson(data, &error);
+    if (error.error != QJsonParseError::NoError)
+    {
+        qCWarning(chatterinoTwitch)
+            << "Failed to parse the user cache:" << error.errorString();
+        return {};
+    }
+
+    auto root = document.object();
+    if (root.value("version").toInt() != CACHE_VERSION)
+    {
+        return {};
+    }
+
+    auto jsonUsers = root.value("users").toArray();
+
+    std::vector<CachedUser> users;
+    users.reserve(static_cast<size_t>(jsonUsers.size()));
+    for (const auto &jsonUser : jsonUsers)
+    {
+        auto object = jsonUser.toObject();
+        CachedUser user{
+            .id = object.value("id").toString(),
+            .login = object.value("login").toString(),
+            .displayName = object.value("displayName").toString(),
+            .resolvedAt = secondsToDateTime(object.value("resolvedAt")),
+        };
+        if (user.id.isEmpty() || user.login.isEmpty() ||
+            isOlderThan(user.resolvedAt, USER_EXPIRY, now))
+        {
+            continue;
+        }
+
+        users.emplace_back(std::move(user));
+    }
+
+    return users;
+}
+
+QByteArray serializeUserCache(std::vector<CachedUser> users)
+{
+    if (users.size() > MAX_CACHED_USERS)
+    {
+        // Keep the users that were resolved most recently
+        auto last =
+            users.begin() + static_cast<std::ptrdiff_t>(MAX_CACHED_USERS);
+        std::ranges::nth_element(users, last, [](const auto &a, const auto &b) {
+            return a.resolvedAt > b.resolvedAt;
+        });
+        users.resize(MAX_CACHED_USERS);
+    }
+
+    QJsonArray jsonUsers;
+    for (const auto &user : users)
+    {
+        jsonUsers.append(QJsonObject{
+            {"id", user.id},
+            {"login", user.login},
+            {"displayName", user.displayName},
+            {"resolvedAt", user.resolvedAt.toSecsSinceEpoch()},
+        });
+    }
+
+    return QJsonDocument(QJsonObject{
+                             {"version", CACHE_VERSION},
+                             {"users", jsonUsers},
+                         })
+        .toJson(QJsonDocument::Compact);
+}
+
+std::vector<CachedUser> loadUserCache(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        // There's no cache yet
+        return {};
+    }
+
+    auto users =
+        parseUserCache(file.readAll(), QDateTime::currentDateTimeUtc());
+
+    qCDebug(chatterinoTwitch)
+        << "Loaded" << users.size() << "users from the cache";
+
+    return users;
+}
+
+void saveUserCache(const QString &path, std::vector<CachedUser> users)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(chatterinoTwitch) << "Failed to write the user cache" << path;
+        return;
+    }
+    file.write(serializeUserCache(std::move(users)));
+    file.commit();
+}
+
+}  // namespace chatterino::twitchusers::detail
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace chatterino::twitchusers::detail {
+
+/// Users that weren't resolved for this long aren't loaded from the cache
+constexpr std::chrono::days USER_EXPIRY{30};
+
+/// At most this many users are written to the cache
+constexpr size_t MAX_CACHED_USERS = 20000;
+
+/// A user as it's stored in the cache
+struct CachedUser {
+    QString id;
+    QString login;
+    QString displayName;
+
+    /// When the user was resolved through Helix
+    QDateTime resolvedAt;
+};
+
+/// Returns true if @a time is invalid or at least @a age before @a now
+bool isOlderThan(const QDateTime &time, std::chrono::seconds age,
+                 const QDateTime &now);
+
+/// Parses the contents of a cache file. Users that expired at @a now are
+/// skipped.
+std::vector<CachedUser> parseUserCache(const QByteArray &data,
+                                       const QDateTime &now);
+
+/// Serializes @a users for the cache file. Only the MAX_CACHED_USERS users
+/// that were resolved most recently are kept.
+QByteArray serializeUserCache(std::vector<CachedUser> users);
+
+/// Reads the cache file at @a path. Returns no users if it doesn't exist.
+std::vector<CachedUser> loadUserCache(const QString &path);
+
+/// Replaces the cache file at @a path
+void saveUserCache(const QString &path, std::vector<CachedUser> users);
+
+}  // namespace chatterino::twitchusers::detail
@@ -2073,35 +2073,43 @@ void Helix::updateChatSettings(
         .execute();
 }
 
-void Helix::onFetchChattersSuccess(
-    std::shared_ptr<HelixChatters> finalChatters, QString broadcasterID,
-    QString moderatorID, size_t maxChattersToFetch,
-    ResultCallback<HelixChatters> successCallback,
+void Helix::onFetchChattersPage(
+    size_t fetchedChatters, QString broadcasterID, QString moderatorID,
+    size_t maxChattersToFetch, ResultCallback<HelixChatters> pageCallback,
+    ResultCallback<> finishedCallback,
     FailureCallback<HelixGetChattersError, QString> failureCallback,
     HelixChatters chatters)
 {
     qCDebug(chatterinoTwitch)
         << "Fetched" << chatters.chatters.size() << "chatters";
 
-    finalChatters->chatters.merge(chatters.chatters);
-    finalChatters->total = chatters.total;
+    fetchedChatters += chatters.chatters.size();
+
+    // Done paginating?
+    auto isLastPage =
+        chatters.cursor.isEmpty() || fetchedChatters >= maxChattersToFetch;
 
-    if (chatters.cursor.isEmpty() ||
-        finalChatters->chatters.size() >= maxChattersToFetch)
+    if (!isLastPage)
     {
-        // Done paginating
-        successCallback(*finalChatters);
-        return;
+        // Request the next page before handing this one out, so the request
+        // is in flight while the page is handled
+        this->fetchChatters(
+            broadcasterID, moderatorID, NUM_CHATTERS_TO_FETCH, chatters.cursor,
+            [=, this](auto chatters) {
+                this->onFetchChattersPage(
+                    fetchedChatters, broadcasterID, moderatorID,
+                    maxChattersToFetch, pageCallback, finishedCallback,
+                    failureCallback, chatters);
+            },
+            failureCallback);
     }
 
-    this->fetchChatters(
-        broadcasterID, moderatorID, NUM_CHATTERS_TO_FETCH, chatters.cursor,
-        [=, this](auto chatters) {
-            this->onFetchChattersSuccess(
-                finalChatters, broadcasterID, moderatorID, maxChattersToFetch,
-                successCallback, failureCallback, chatters);
-        },
-        failureCallback);
+    pageCallback(std::move(chatters));
+
+    if (isLastPage)
+    {
+        finishedCallback();
+    }
 }
 
 // https://dev.twitch.tv/docs/api/reference#get-chatters
@@ -2196,19 +2204,19 @@ void Helix::onFetchModeratorsSuccess(
     qCDebug(chatterinoTwitch)
         << "Fetched " << moderators.moderators.size() << " moderators";
 
-    std::for_each(moderators.moderators.begin(), moderators.moderators.end(),
-                  [finalModerators](auto mod) {
-                      finalModerators->push_back(mod);
-                  });
-
     if (moderators.cursor.isEmpty() ||
-        finalModerators->size() >= maxModeratorsToFetch)
+        finalModerators->size() + moderators.moderators.size() >=
+            maxModeratorsToFetch)
     {
         // Done paginating
+        finalModerators->insert(finalModerators->end(),
+                                moderators.moderators.begin(),
+                                moderators.moderators.end());
         successCallback(*finalModerators);
         return;
     }
 
+    // Request the next page before collecting this one
     this->fetchModerators(
         broadcasterID, NUM_MODERATORS_TO_FETCH_PER_REQUEST, moderators.cursor,
         [=, this](auto moderators) {
@@ -2217,6 +2225,10 @@ void Helix::onFetchModeratorsSuccess(
                 successCallback, failureCallback, moderators);
         },
         failureCallback);
+
+    finalModerators->insert(finalModerators->end(),
+                            moderators.moderators.begin(),
+                            moderators.moderators.end());
 }
 
 // https://dev.twitch.tv/docs/api/reference#get-moderators
@@ -2631,13 +2643,33 @@ void Helix::getChatters(
 {
     auto finalChatters = std::make_shared<HelixChatters>();
 
+    this->streamChatters(
+        broadcasterID, moderatorID, maxChattersToFetch,
+        [finalChatters](auto chatters) {
+            finalChatters->chatters.merge(chatters.chatters);
+            finalChatters->total = chatters.total;
+        },
+        [finalChatters, successCallback] {
+            successCallback(*finalChatters);
+        },
+        failureCallback);
+}
+
+// https://dev.twitch.tv/docs/api/reference#get-chatters
+void Helix::streamChatters(
+    QString broadcasterID, QString moderatorID, size_t maxChattersToFetch,
+    ResultCallback<HelixChatters> pageCallback,
+    ResultCallback<> finishedCallback,
+    FailureCallback<HelixGetChattersError, QString> failureCallback)
+{
     // Initiate the recursive calls
     this->fetchChatters(
         broadcasterID, moderatorID, NUM_CHATTERS_TO_FETCH, "",
         [=, this](auto chatters) {
-            this->onFetchChattersSuccess(
-                finalChatters, broadcasterID, moderatorID, maxChattersToFetch,
-                successCallback, failureCallback, chatters);
+            this->onFetchChattersPage(0, broadcasterID, moderatorID,
+                                      maxChattersToFetch, pageCallback,
+                                      finishedCallback, failureCallback,
+                                      chatters);
         },
         failureCallback);
 }
@@ -3546,11 +3578,33 @@ NetworkRequest Helix::makeRequest(const QString &url, const QUrlQuery &urlQuery,
 
     fullUrl.setQuery(urlQuery);
 
+    // All requests share one rate limit, the scheduler holds back less
+    // important ones when it runs low
+    auto priority = helixPriorityOf(url, type);
+
     return NetworkRequest(fullUrl, type)
         .timeout(5 * 1000)
         .header("Accept", "application/json")
         .header("Client-ID", this->clientId)
         .header("Authorization", "Bearer " + this->oauthToken)
+        .gate([scheduler = this->scheduler_, priority](auto send) {
+            scheduler->schedule(priority, std::move(send));
+        })
+        // Waiting requests are owned by the scheduler, so they must not keep
+        // it alive
+        .observeResult([scheduler = std::weak_ptr(this->scheduler_)](
+                           const auto &result) {
+            if (auto locked = scheduler.lock())
+            {
+                locked->observe(result);
+            }
+        })
+        .released([scheduler = std::weak_ptr(this->scheduler_)] {
+            if (auto locked = scheduler.lock())
+            {
+                locked->released();
+            }
+        })
 #ifndef NDEBUG
         .ignoreSslErrors(ignoreSslErrors)
 #endif
@@ -3640,6 +3694,11 @@ void Helix::paginate(
         .execute();
 }
 
+HelixRatelimit::State Helix::getRatelimit() const
+{
+    return this->scheduler_->ratelimit();
+}
+
 void Helix::update(QString clientId, QString oauthToken)
 {
     this->clientId = std::move(clientId);
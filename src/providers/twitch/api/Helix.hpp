@@ -2,6 +2,8 @@
 
 #include "common/Aliases.hpp"
 #include "common/network/NetworkRequest.hpp"
+#include "providers/twitch/api/HelixRatelimit.hpp"
+#include "providers/twitch/api/HelixScheduler.hpp"
 #include "providers/twitch/eventsub/SubscriptionRequest.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
 #include "util/Helpers.hpp"
@@ -17,6 +19,7 @@
 #include <QUrlQuery>
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <unordered_set>
 #include <vector>
@@ -1191,6 +1194,16 @@ public:
         ResultCallback<HelixChatters> successCallback,
         FailureCallback<HelixGetChattersError, QString> failureCallback) = 0;
 
+    // Get Chatters from the `broadcasterID` channel page by page
+    // `pageCallback` is called for every page while the next one is requested
+    // already, `finishedCallback` is called after the last page
+    // https://dev.twitch.tv/docs/api/reference#get-chatters
+    virtual void streamChatters(
+        QString broadcasterID, QString moderatorID, size_t maxChattersToFetch,
+        ResultCallback<HelixChatters> pageCallback,
+        ResultCallback<> finishedCallback,
+        FailureCallback<HelixGetChattersError, QString> failureCallback) = 0;
+
     // Get moderators from the `broadcasterID` channel
     // This will follow the returned cursor
     // https://dev.twitch.tv/docs/api/reference#get-moderators
@@ -1273,6 +1286,9 @@ public:
         const QString &subscriptionID, ResultCallback<> successCallback,
         FailureCallback<QString> failureCallback) = 0;
 
+    /// The rate limit bucket as of the last response that reported it
+    virtual HelixRatelimit::State getRatelimit() const = 0;
+
     virtual void update(QString clientId, QString oauthToken) = 0;
 
 protected:
@@ -1568,6 +1584,16 @@ public:
         ResultCallback<HelixChatters> successCallback,
         FailureCallback<HelixGetChattersError, QString> failureCallback) final;
 
+    // Get Chatters from the `broadcasterID` channel page by page
+    // `pageCallback` is called for every page while the next one is requested
+    // already, `finishedCallback` is called after the last page
+    // https://dev.twitch.tv/docs/api/reference#get-chatters
+    void streamChatters(
+        QString broadcasterID, QString moderatorID, size_t maxChattersToFetch,
+        ResultCallback<HelixChatters> pageCallback,
+        ResultCallback<> finishedCallback,
+        FailureCallback<HelixGetChattersError, QString> failureCallback) final;
+
     // Get moderators from the `broadcasterID` channel
     // This will follow the returned cursor
     // https://dev.twitch.tv/docs/api/reference#get-moderators
@@ -1649,6 +1675,8 @@ public:
         const QString &subscriptionID, ResultCallback<> successCallback,
         FailureCallback<QString> failureCallback) final;
 
+    HelixRatelimit::State getRatelimit() const final;
+
     void update(QString clientId, QString oauthToken) final;
 
     static void initialize();
@@ -1662,10 +1690,10 @@ protected:
         final;
 
     // Recursive boy
-    void onFetchChattersSuccess(
-        std::shared_ptr<HelixChatters> finalChatters, QString broadcasterID,
-        QString moderatorID, size_t maxChattersToFetch,
-        ResultCallback<HelixChatters> successCallback,
+    void onFetchChattersPage(
+        size_t fetchedChatters, QString broadcasterID, QString moderatorID,
+        size_t maxChattersToFetch, ResultCallback<HelixChatters> pageCallback,
+        ResultCallback<> finishedCallback,
         FailureCallback<HelixGetChattersError, QString> failureCallback,
         HelixChatters chatters);
 
@@ -1711,6 +1739,9 @@ private:
 
     QString clientId;
     QString oauthToken;
+
+    std::shared_ptr<HelixScheduler> scheduler_ =
+        std::make_shared<HelixScheduler>();
 };
 
 // initializeHelix sets the helix instance to _instance
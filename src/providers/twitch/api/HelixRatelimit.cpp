@@ -0,0 +1,47 @@
+#include "providers/twitch/api/HelixRatelimit.hpp"
+
+#include "common/network/NetworkResult.hpp"
+
+namespace chatterino {
+
+std::optional<int64_t> HelixRatelimit::State::remainingAt(
+    Clock::time_point now) const
+{
+    if (now >= this->reset)
+    {
+        return std::nullopt;
+    }
+    return this->remaining;
+}
+
+void HelixRatelimit::update(const NetworkResult &result)
+{
+    bool remainingOk = false;
+    bool resetOk = false;
+    auto remaining =
+        result.rawHeader("Ratelimit-Remaining").toLongLong(&remainingOk);
+    auto reset = result.rawHeader("Ratelimit-Reset").toLongLong(&resetOk);
+    if (!remainingOk || !resetOk)
+    {
+        return;
+    }
+
+    bool limitOk = false;
+    auto limit = result.rawHeader("Ratelimit-Limit").toLongLong(&limitOk);
+
+    std::lock_guard lock(this->mutex_);
+    if (limitOk)
+    {
+        this->state_.limit = limit;
+    }
+    this->state_.remaining = remaining;
+    this->state_.reset = Clock::time_point(std::chrono::seconds(reset));
+}
+
+HelixRatelimit::State HelixRatelimit::state() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->state_;
+}
+
+}  // namespace chatterino
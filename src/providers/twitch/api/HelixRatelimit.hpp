@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace chatterino {
+
+class NetworkResult;
+
+/// @brief Tracks the Helix rate limit bucket from response headers
+///
+/// Helix gives every client ID and user a bucket of points (800 per minute by
+/// default). Each response tells how many points are left and when the bucket
+/// is refilled, see https://dev.twitch.tv/docs/api/guide/#twitch-rate-limits
+///
+/// The state can be read from any thread.
+class HelixRatelimit
+{
+public:
+    using Clock = std::chrono::system_clock;
+
+    struct State {
+        /// Size of the bucket, unknown before the first response
+        std::optional<int64_t> limit;
+        /// Points left in the bucket, unknown before the first response
+        std::optional<int64_t> remaining;
+        /// When the bucket is refilled
+        Clock::time_point reset;
+
+        /// Returns the points left at @a now.
+        /// Returns std::nullopt if that's unknown or the bucket was refilled.
+        std::optional<int64_t> remainingAt(Clock::time_point now) const;
+    };
+
+    /// Updates the state from the `Ratelimit-*` headers of @a result.
+    /// Responses without these headers are ignored.
+    void update(const NetworkResult &result);
+
+    State state() const;
+
+private:
+    mutable std::mutex mutex_;
+    State state_;
+};
+
+}  // namespace chatterino
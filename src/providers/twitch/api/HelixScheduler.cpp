@@ -0,0 +1,253 @@
+#include "providers/twitch/api/HelixScheduler.hpp"
+
+#include "common/network/NetworkResult.hpp"
+#include "common/QLogging.hpp"
+#include "util/DebugCount.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <ranges>
+#include <vector>
+
+namespace {
+
+using namespace chatterino;
+
+size_t indexOf(HelixPriority priority)
+{
+    return static_cast<size_t>(priority);
+}
+
+/// Used until a response tells us the size of the bucket
+constexpr int64_t DEFAULT_BUCKET_SIZE = 800;
+
+/// Time we wait after the bucket should be refilled, to account for clock skew
+constexpr std::chrono::milliseconds RESET_MARGIN{250};
+
+}  // namespace
+
+namespace chatterino {
+
+HelixPriority helixPriorityOf(QStringView url, NetworkRequestType type)
+{
+    if (type != NetworkRequestType::Get)
+    {
+        // Subscriptions are already queued by the EventSub controller
+        if (url == u"eventsub/subscriptions")
+        {
+            return HelixPriority::Normal;
+        }
+        return HelixPriority::Interactive;
+    }
+
+    static constexpr std::array<QStringView, 12> background{
+        u"bits/cheermotes",
+        u"chat/badges",
+        u"chat/badges/global",
+        u"chat/chatters",
+        u"chat/color",
+        u"chat/emotes",
+        u"chat/emotes/set",
+        u"chat/emotes/user",
+        u"moderation/moderators",
+        u"streams",
+        u"users",
+        u"users/blocks",
+    };
+    if (std::ranges::find(background, url) != background.end())
+    {
+        return HelixPriority::Background;
+    }
+    return HelixPriority::Normal;
+}
+
+HelixScheduler::HelixScheduler()
+{
+    this->resetTimer_.setSingleShot(true);
+    QObject::connect(&this->resetTimer_, &QTimer::timeout, &this->resetTimer_,
+                     [this] {
+                         this->sendWaiting();
+                     });
+}
+
+void HelixScheduler::schedule(HelixPriority priority,
+                              std::function<void()> send)
+{
+    auto now = HelixRatelimit::Clock::now();
+    auto state = this->ratelimit_.state();
+
+    {
+        std::unique_lock lock(this->mutex_);
+
+        // Requests of the same or a higher priority that wait go first
+        bool othersWaiting = std::ranges::any_of(
+            this->waiting_ | std::views::drop(indexOf(priority)),
+            [](const auto &queue) {
+                return !queue.empty();
+            });
+
+        if (othersWaiting ||
+            !HelixScheduler::maySend(priority, state, this->inFlight_, now))
+        {
+            qCDebug(chatterinoTwitch)
+                << "Helix rate limit is low, delaying a request of priority"
+                << static_cast<int>(priority);
+            this->waiting_[indexOf(priority)].push_back({
+                .priority = priority,
+                .send = std::move(send),
+            });
+            lock.unlock();
+
+            this->waitForReset(state.reset);
+            this->updateStats();
+            return;
+        }
+
+        this->inFlight_++;
+    }
+
+    send();
+    this->updateStats();
+}
+
+void HelixScheduler::observe(const NetworkResult &result)
+{
+    this->ratelimit_.update(result);
+}
+
+void HelixScheduler::released()
+{
+    bool anyWaiting = false;
+    {
+        std::lock_guard lock(this->mutex_);
+        assert(this->inFlight_ > 0);
+        if (this->inFlight_ > 0)
+        {
+            this->inFlight_--;
+        }
+        anyWaiting = std::ranges::any_of(this->waiting_, [](const auto &queue) {
+            return !queue.empty();
+        });
+    }
+
+    if (anyWaiting)
+    {
+        // This is called on the network thread while it's handling another
+        // request (or any other thread), so send the waiting ones from the
+        // scheduler's thread
+        QMetaObject::invokeMethod(
+            &this->resetTimer_,
+            [this] {
+                this->sendWaiting();
+            },
+            Qt::QueuedConnection);
+    }
+    this->updateStats();
+}
+
+HelixRatelimit::State HelixScheduler::ratelimit() const
+{
+    return this->ratelimit_.state();
+}
+
+size_t HelixScheduler::waiting() const
+{
+    std::lock_guard lock(this->mutex_);
+
+    size_t count = 0;
+    for (const auto &queue : this->waiting_)
+    {
+        count += queue.size();
+    }
+    return count;
+}
+
+bool HelixScheduler::maySend(HelixPriority priority,
+                             const HelixRatelimit::State &state,
+                             size_t inFlight,
+                             HelixRatelimit::Clock::time_point now)
+{
+    auto remaining = state.remainingAt(now);
+    if (!remaining)
+    {
+        // Unknown or refilled
+        return true;
+    }
+
+    auto reserve = state.limit.value_or(DEFAULT_BUCKET_SIZE) *
+                   RESERVE_PERCENT.at(indexOf(priority)) / 100;
+    // Requests in flight will take their points too
+    return *remaining - static_cast<int64_t>(inFlight) > reserve;
+}
+
+void HelixScheduler::sendWaiting()
+{
+    auto now = HelixRatelimit::Clock::now();
+    auto state = this->ratelimit_.state();
+
+    std::vector<std::function<void()>> toSend;
+    bool stillWaiting = false;
+    {
+        std::lock_guard lock(this->mutex_);
+
+        // Highest priority first, lower ones don't overtake waiting requests
+        for (auto it = this->waiting_.rbegin(); it != this->waiting_.rend();
+             ++it)
+        {
+            auto &queue = *it;
+            while (!queue.empty() &&
+                   HelixScheduler::maySend(queue.front().priority, state,
+                                           this->inFlight_, now))
+            {
+                toSend.emplace_back(std::move(queue.front().send));
+                queue.pop_front();
+                this->inFlight_++;
+            }
+
+            if (!queue.empty())
+            {
+                stillWaiting = true;
+                break;
+            }
+        }
+    }
+
+    if (stillWaiting)
+    {
+        this->waitForReset(state.reset);
+    }
+
+    for (auto &send : toSend)
+    {
+        send();
+    }
+    this->updateStats();
+}
+
+void HelixScheduler::waitForReset(HelixRatelimit::Clock::time_point reset)
+{
+    auto delay = std::max(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            reset - HelixRatelimit::Clock::now()),
+        std::chrono::milliseconds{0});
+    auto ms = static_cast<int>((delay + RESET_MARGIN).count());
+
+    QMetaObject::invokeMethod(
+        &this->resetTimer_,
+        [this, ms] {
+            if (!this->resetTimer_.isActive() ||
+                this->resetTimer_.remainingTime() > ms)
+            {
+                this->resetTimer_.start(ms);
+            }
+        },
+        Qt::QueuedConnection);
+}
+
+void HelixScheduler::updateStats() const
+{
+    DebugCount::set("Helix requests waiting for the rate limit",
+                    static_cast<int64_t>(this->waiting()));
+}
+
+}  // namespace chatterino
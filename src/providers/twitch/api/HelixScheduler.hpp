@@ -0,0 +1,107 @@
+#pragma once
+
+#include "common/network/NetworkCommon.hpp"
+#include "providers/twitch/api/HelixRatelimit.hpp"
+
+#include <QStringView>
+#include <QTimer>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace chatterino {
+
+/// Order in which Helix requests are sent when the rate limit runs low
+enum class HelixPriority : uint8_t {
+    /// Polling and lookups nobody is waiting for (e.g. live status,
+    /// chatters, badges)
+    Background,
+    /// Requests made to show something (e.g. the channel of a user card)
+    Normal,
+    /// Actions of the user (e.g. bans, timeouts, sending messages)
+    Interactive,
+};
+
+/// Returns the priority of a request to the Helix endpoint @a url
+HelixPriority helixPriorityOf(QStringView url, NetworkRequestType type);
+
+/// @brief Decides when Helix requests are sent
+///
+/// All Helix requests share one rate limit bucket (see HelixRatelimit).
+/// While it has plenty of points, every request is sent right away.
+/// Once it runs low, lower priorities have to wait until it's refilled,
+/// so they don't take the points interactive actions need. Waiting requests
+/// are sent by priority, in the order they were made.
+///
+/// Requests can be scheduled from any thread.
+class HelixScheduler
+{
+public:
+    /// Points that have to be left for a request of the given priority
+    /// to be sent, in 1/100 of the bucket size
+    static constexpr std::array<int64_t, 3> RESERVE_PERCENT{
+        25,  // Background
+        5,   // Normal
+        0,   // Interactive
+    };
+
+    HelixScheduler();
+    ~HelixScheduler() = default;
+
+    HelixScheduler(const HelixScheduler &) = delete;
+    HelixScheduler(HelixScheduler &&) = delete;
+    HelixScheduler &operator=(const HelixScheduler &) = delete;
+    HelixScheduler &operator=(HelixScheduler &&) = delete;
+
+    /// Calls @a send now or once the rate limit allows it.
+    /// Every sent request has to be reported to #released once it's done.
+    void schedule(HelixPriority priority, std::function<void()> send);
+
+    /// Updates the rate limit from the response @a result
+    void observe(const NetworkResult &result);
+
+    /// Reports that a sent request is done and sends waiting requests.
+    /// Has to be called for every sent request, even if it got no response.
+    void released();
+
+    HelixRatelimit::State ratelimit() const;
+
+    /// Number of requests waiting for the rate limit
+    size_t waiting() const;
+
+    /// Returns true if a request with @a priority may be sent while
+    /// @a inFlight requests are in flight
+    static bool maySend(HelixPriority priority,
+                        const HelixRatelimit::State &state, size_t inFlight,
+                        HelixRatelimit::Clock::time_point now);
+
+private:
+    struct Waiting {
+        HelixPriority priority;
+        std::function<void()> send;
+    };
+
+    /// Sends waiting requests the rate limit allows.
+    /// Must be called without holding the mutex.
+    void sendWaiting();
+
+    /// Starts the timer for when the bucket is refilled
+    void waitForReset(HelixRatelimit::Clock::time_point reset);
+
+    void updateStats() const;
+
+    HelixRatelimit ratelimit_;
+
+    mutable std::mutex mutex_;
+    /// One queue per priority
+    std::array<std::deque<Waiting>, 3> waiting_;
+    size_t inFlight_ = 0;
+
+    /// Lives on the thread the scheduler was created on
+    QTimer resetTimer_;
+};
+
+}  // namespace chatterino
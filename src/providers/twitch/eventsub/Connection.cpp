@@ -1,9 +1,11 @@
 #include "providers/twitch/eventsub/Connection.hpp"
 
 #include "Application.hpp"
+#include "common/Literals.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/highlights/HighlightController.hpp"
+#include "controllers/twitch/LiveController.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/eventsub/Controller.hpp"
@@ -24,11 +26,14 @@
 #include <twitch-eventsub-ws/session.hpp>
 
 #include <chrono>
+#include <optional>
+#include <string>
 
 namespace {
 
 using namespace chatterino;
 using namespace chatterino::eventsub;
+using namespace chatterino::literals;
 
 namespace channel_moderate = lib::payload::channel_moderate::v2;
 
@@ -50,6 +55,56 @@ concept CanHandleModMessage =
         handleModerateMessage(channel, time, event, action);
     };
 
+/// Lets the live controller know which channels EventSub tells us about when
+/// they go online or offline
+void setStreamEventSubscribed(const SubscriptionRequest &request,
+                              bool subscribed)
+{
+    std::optional<ITwitchLiveController::StreamEvent> event;
+    if (request.subscriptionType == u"stream.online"_s)
+    {
+        event = ITwitchLiveController::StreamEvent::Online;
+    }
+    else if (request.subscriptionType == u"stream.offline"_s)
+    {
+        event = ITwitchLiveController::StreamEvent::Offline;
+    }
+    else
+    {
+        return;
+    }
+
+    for (const auto &[key, value] : request.conditions)
+    {
+        if (key != u"broadcaster_user_id"_s)
+        {
+            continue;
+        }
+
+        runInGuiThread([channelID = value, event = *event, subscribed] {
+            auto *app = tryGetApp();
+            if (!app)
+            {
+                return;
+            }
+            app->getTwitchLiveController()->setStreamEventSubscribed(
+                channelID, event, subscribed);
+        });
+    }
+}
+
+void onStreamEvent(const std::string &broadcasterUserID)
+{
+    runInGuiThread([channelID = QString::fromStdString(broadcasterUserID)] {
+        auto *app = tryGetApp();
+        if (!app)
+        {
+            return;
+        }
+        app->getTwitchLiveController()->onStreamEvent(channelID);
+    });
+}
+
 }  // namespace
 
 namespace chatterino::eventsub {
@@ -81,6 +136,15 @@ void Connection::onClose(std::unique_ptr<lib::Listener> self,
         return;
     }
 
+    if (!reconnectURL)
+    {
+        // Our subscriptions are gone until they're recreated
+        for (const auto &request : this->subscriptions)
+        {
+            setStreamEventSubscribed(request, false);
+        }
+    }
+
     app->getEventSub()->reconnectConnection(std::move(self), reconnectURL,
                                             this->subscriptions);
 }
@@ -101,6 +165,8 @@ void Connection::onStreamOnline(
     (void)metadata;
     qCDebug(LOG) << "On stream online event for channel"
                  << payload.event.broadcasterUserLogin.c_str();
+
+    onStreamEvent(payload.event.broadcasterUserID);
 }
 
 void Connection::onStreamOffline(
@@ -110,6 +176,8 @@ void Connection::onStreamOffline(
     (void)metadata;
     qCDebug(LOG) << "On stream offline event for channel"
                  << payload.event.broadcasterUserLogin.c_str();
+
+    onStreamEvent(payload.event.broadcasterUserID);
 }
 
 void Connection::onChannelChatNotification(
@@ -399,11 +467,13 @@ bool Connection::isSubscribedTo(const SubscriptionRequest &request) const
 void Connection::markRequestSubscribed(const SubscriptionRequest &request)
 {
     this->subscriptions.emplace(request);
+    setStreamEventSubscribed(request, true);
 }
 
 void Connection::markRequestUnsubscribed(const SubscriptionRequest &request)
 {
     this->subscriptions.erase(request);
+    setStreamEventSubscribed(request, false);
 }
 
 }  // namespace chatterino::eventsub
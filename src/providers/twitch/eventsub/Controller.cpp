@@ -2,10 +2,12 @@
 
 #include "Application.hpp"
 #include "common/Args.hpp"
+#include "common/Literals.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/eventsub/Connection.hpp"
+#include "util/DebugCount.hpp"
 #include "util/RenameThread.hpp"
 
 #include <boost/asio/io_context.hpp>
@@ -14,12 +16,15 @@
 #include <boost/certify/https_verification.hpp>
 #include <twitch-eventsub-ws/session.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <tuple>
 #include <utility>
 
 namespace {
 
 using namespace chatterino;
+using namespace chatterino::literals;
 
 std::tuple<std::string, std::string, std::string> getEventSubHost()
 {
@@ -33,6 +38,23 @@ std::tuple<std::string, std::string, std::string> getEventSubHost()
     return {"eventsub.wss.twitch.tv", "443", "/ws"};
 }
 
+/// Requests with a higher importance are sent first if their priority is the
+/// same. Moderation events go first, then the user's own held messages.
+int importanceOf(const eventsub::SubscriptionRequest &request)
+{
+    const auto &type = request.subscriptionType;
+    if (type == u"channel.moderate"_s || type == u"automod.message.hold"_s)
+    {
+        return 2;
+    }
+    if (type.startsWith(u"automod."_s) ||
+        type.startsWith(u"channel.chat.user_message_"_s))
+    {
+        return 1;
+    }
+    return 0;
+}
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 const auto &LOG = chatterinoTwitchEventSub;
 
@@ -77,6 +99,12 @@ Controller::~Controller()
         connection->close();
     }
 
+    boost::asio::post(this->ioContext, [this] {
+        // Don't wait for the rate limit anymore
+        this->queueTimer.reset();
+        this->queue.clear();
+    });
+
     this->subscriptions.clear();
 
     this->work.reset();
@@ -157,7 +185,8 @@ void Controller::setQuitting()
     this->quitting = true;
 }
 
-SubscriptionHandle Controller::subscribe(const SubscriptionRequest &request)
+SubscriptionHandle Controller::subscribe(const SubscriptionRequest &request,
+                                         SubscriptionPriority priority)
 {
     assert(!this->quitting &&
            "Subscribe cannot be called while we are quitting");
@@ -201,11 +230,15 @@ SubscriptionHandle Controller::subscribe(const SubscriptionRequest &request)
 
             // Ensure retries can work as expected since this is a fresh subscription
             subscription.retryAttempts = 0;
+            subscription.priority = priority;
 
             assert(subscription.retryTimer == nullptr &&
                    "A new subscription should not have a retry timer created");
         }
 
+        // A queued request is sent earlier if another reference needs it more
+        subscription.priority = std::max(subscription.priority, priority);
+
         subscription.refCount++;
         qCDebug(LOG) << "Added ref for" << request << subscription.refCount
                      << needToSubscribe
@@ -296,6 +329,146 @@ void Controller::subscribe(const SubscriptionRequest &request, bool isRetry)
         assert(subscription.retryTimer == nullptr);
     }
 
+    this->enqueue(request);
+    this->sendQueued();
+}
+
+void Controller::enqueue(const SubscriptionRequest &request)
+{
+    this->threadGuard->guard();
+
+    auto it = std::ranges::find(this->queue, request, &QueuedRequest::request);
+    if (it != this->queue.end())
+    {
+        qCDebug(LOG) << "Request" << request << "is already queued";
+        return;
+    }
+
+    this->queue.push_back({
+        .request = request,
+        .sequence = this->nextQueueSequence++,
+    });
+}
+
+void Controller::sendQueued()
+{
+    this->threadGuard->guard();
+
+    while (!this->queue.empty() &&
+           this->requestsInFlight < MAX_REQUESTS_IN_FLIGHT)
+    {
+        if (this->queueTimer)
+        {
+            // Already waiting for the bucket to be refilled
+            break;
+        }
+
+        auto now = HelixRatelimit::Clock::now();
+        auto ratelimit = getHelix()->getRatelimit();
+        auto remaining = ratelimit.remainingAt(now);
+        // Requests in flight aren't part of the last response yet
+        auto inFlight = static_cast<int64_t>(this->requestsInFlight);
+        if (remaining && *remaining - inFlight <= RATELIMIT_RESERVE)
+        {
+            auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+                ratelimit.reset - now);
+            qCDebug(LOG) << "Rate limit has" << *remaining
+                         << "points left, waiting" << delay.count()
+                         << "ms with" << this->queue.size()
+                         << "queued requests";
+
+            this->queueTimer =
+                std::make_unique<boost::asio::deadline_timer>(this->ioContext);
+            this->queueTimer->expires_from_now(
+                boost::posix_time::milliseconds(delay.count() + 100));
+            this->queueTimer->async_wait([this](const auto &ec) {
+                if (ec)
+                {
+                    return;
+                }
+                this->queueTimer.reset();
+                this->sendQueued();
+            });
+            break;
+        }
+
+        auto request = this->takeNextQueued();
+        if (this->createSubscription(request))
+        {
+            this->requestsInFlight++;
+        }
+    }
+
+    this->updateQueueStats();
+}
+
+SubscriptionRequest Controller::takeNextQueued()
+{
+    assert(!this->queue.empty());
+
+    auto best = this->queue.begin();
+    {
+        std::lock_guard lock(this->subscriptionsMutex);
+
+        auto rank = [this](const QueuedRequest &queued) {
+            auto it = this->subscriptions.find(queued.request);
+            auto priority = it == this->subscriptions.end()
+                                ? SubscriptionPriority::Background
+                                : it->second.priority;
+            // Earlier requests have a higher (negated) sequence
+            return std::make_tuple(priority, importanceOf(queued.request),
+                                   -static_cast<int64_t>(queued.sequence));
+        };
+
+        auto bestRank = rank(*best);
+        for (auto it = std::next(best); it != this->queue.end(); ++it)
+        {
+            auto itRank = rank(*it);
+            if (itRank > bestRank)
+            {
+                best = it;
+                bestRank = itRank;
+            }
+        }
+    }
+
+    auto request = std::move(best->request);
+    this->queue.erase(best);
+    return request;
+}
+
+void Controller::onCreateSubscriptionFinished()
+{
+    this->threadGuard->guard();
+
+    assert(this->requestsInFlight > 0);
+    this->requestsInFlight--;
+    this->sendQueued();
+}
+
+void Controller::updateQueueStats() const
+{
+    DebugCount::set("EventSub queued subscription requests",
+                    static_cast<int64_t>(this->queue.size()));
+    DebugCount::set("EventSub subscription requests in flight",
+                    static_cast<int64_t>(this->requestsInFlight));
+}
+
+bool Controller::createSubscription(const SubscriptionRequest &request)
+{
+    {
+        std::lock_guard lock(this->subscriptionsMutex);
+        auto &subscription = this->subscriptions[request];
+        if (subscription.refCount == 0)
+        {
+            qCDebug(LOG) << "No one is interested in the queued request"
+                         << request << "anymore";
+            qCDebug(LOG) << "Set state to unsubscribed" << request;
+            subscription.state = Subscription::State::Unsubscribed;
+            return false;
+        }
+    }
+
     uint32_t openButNotReadyConnections = 0;
 
     // 2. Check if any currently open connection can handle this subscription
@@ -319,8 +492,15 @@ void Controller::subscribe(const SubscriptionRequest &request, bool isRetry)
                 qCDebug(LOG) << "Subscription success" << request;
                 this->markRequestSubscribed(request, weakConnection,
                                             res.subscriptionID);
+                boost::asio::post(this->ioContext, [this] {
+                    this->onCreateSubscriptionFinished();
+                });
             },
             [this, request](const auto &error, const auto &errorString) {
+                boost::asio::post(this->ioContext, [this] {
+                    this->onCreateSubscriptionFinished();
+                });
+
                 using Error = HelixCreateEventSubSubscriptionError;
                 switch (error)
                 {
@@ -351,7 +531,12 @@ void Controller::subscribe(const SubscriptionRequest &request, bool isRetry)
 
                     case Error::Ratelimited:
                         qCDebug(LOG) << "Ratelimited" << errorString << request;
-                        break;
+                        // The queue waits until the bucket is refilled
+                        boost::asio::post(this->ioContext, [this, request] {
+                            this->enqueue(request);
+                            this->sendQueued();
+                        });
+                        return;
 
                     case Error::Forwarded:
                     default:
@@ -369,7 +554,7 @@ void Controller::subscribe(const SubscriptionRequest &request, bool isRetry)
                 this->markRequestFailed(request);
             });
 
-        return;
+        return true;
     }
 
     if (openButNotReadyConnections == 0)
@@ -389,6 +574,8 @@ void Controller::subscribe(const SubscriptionRequest &request, bool isRetry)
         // At least one connection is open, but it has not gotten the welcome message yet
         this->retrySubscription(request, boost::posix_time::millisec(250), 10);
     }
+
+    return false;
 }
 
 std::optional<std::shared_ptr<lib::Session>> Controller::getViableConnection(
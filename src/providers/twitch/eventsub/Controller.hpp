@@ -18,9 +18,19 @@
 #include <string>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace chatterino::eventsub {
 
+/// Order in which queued subscription requests are sent to Helix.
+/// Within the same priority, requests for moderation events go first.
+enum class SubscriptionPriority : uint8_t {
+    /// The channel isn't visible in any split
+    Background,
+    /// The channel is visible
+    Visible,
+};
+
 class IController
 {
 public:
@@ -36,15 +46,19 @@ public:
     /// This lets us simplify some logic with unsubscriptions (i.e. we ignore it instead)
     virtual void setQuitting() = 0;
 
-    /// Subscribe will make a request to each open connection and ask them to
-    /// add this subscription.
+    /// Subscribe will queue a request to add this subscription to an open
+    /// connection.
     ///
-    /// If this subscription already exists, this call is a no-op.
+    /// If this subscription already exists, this call only adds a reference.
+    /// If it's still queued, it's sent with the higher of both priorities.
+    ///
+    /// Queued requests are sent by priority while the Helix rate limit has
+    /// room, the rest wait until the bucket is refilled.
     ///
     /// If no open connection has room for this subscription, this function will
     /// create a new connection and queue up the subscription to run again after X seconds.
     [[nodiscard]] virtual SubscriptionHandle subscribe(
-        const SubscriptionRequest &request) = 0;
+        const SubscriptionRequest &request, SubscriptionPriority priority) = 0;
 
     virtual void reconnectConnection(
         std::unique_ptr<lib::Listener> connection,
@@ -63,16 +77,39 @@ public:
     void setQuitting() override;
 
     [[nodiscard]] SubscriptionHandle subscribe(
-        const SubscriptionRequest &request) override;
+        const SubscriptionRequest &request,
+        SubscriptionPriority priority) override;
 
     void reconnectConnection(
         std::unique_ptr<lib::Listener> connection,
         const std::optional<std::string> &reconnectURL,
         const std::unordered_set<SubscriptionRequest> &subs) override;
 
+    /// At most this many subscription requests are sent at the same time
+    static constexpr size_t MAX_REQUESTS_IN_FLIGHT = 8;
+
+    /// Points of the Helix rate limit bucket we leave to everything else
+    static constexpr int64_t RATELIMIT_RESERVE = 40;
+
 private:
     void subscribe(const SubscriptionRequest &request, bool isRetry);
 
+    /// Adds @a request to the queue unless it's queued already
+    void enqueue(const SubscriptionRequest &request);
+
+    /// Sends queued requests while the rate limit allows it
+    void sendQueued();
+
+    /// Removes and returns the queued request that should be sent next
+    SubscriptionRequest takeNextQueued();
+
+    /// @return true if a Helix request was made
+    bool createSubscription(const SubscriptionRequest &request);
+
+    void onCreateSubscriptionFinished();
+
+    void updateQueueStats() const;
+
     void createConnection();
     void createConnection(std::string host, std::string port, std::string path,
                           std::unique_ptr<lib::Listener> listener);
@@ -140,11 +177,26 @@ private:
         /// The timer, if any, for retrying the subscription creation
         std::unique_ptr<boost::asio::deadline_timer> retryTimer;
         int32_t retryAttempts = 0;
+
+        /// The highest priority any reference asked for
+        SubscriptionPriority priority = SubscriptionPriority::Background;
     };
 
     std::mutex subscriptionsMutex;
     std::unordered_map<SubscriptionRequest, Subscription> subscriptions;
 
+    // The queue is only used from the EventSub thread
+    struct QueuedRequest {
+        SubscriptionRequest request;
+        /// Requests queued earlier are sent first if everything else is equal
+        uint64_t sequence = 0;
+    };
+    std::vector<QueuedRequest> queue;
+    uint64_t nextQueueSequence = 0;
+    size_t requestsInFlight = 0;
+    /// Set while we wait for the rate limit bucket to be refilled
+    std::unique_ptr<boost::asio::deadline_timer> queueTimer;
+
     std::atomic<bool> quitting = false;
 };
 
@@ -164,9 +216,11 @@ public:
     }
 
     [[nodiscard]] SubscriptionHandle subscribe(
-        const SubscriptionRequest &request) override
+        const SubscriptionRequest &request,
+        SubscriptionPriority priority) override
     {
         (void)request;
+        (void)priority;
         return {};
     }
 
@@ -1,33 +1,46 @@
 #include "providers/twitch/pubsubmessages/Base.hpp"
 
+#include "util/JsonFrame.hpp"
 #include "util/QMagicEnum.hpp"
 
 namespace chatterino {
 
-PubSubMessage::PubSubMessage(QJsonObject _object)
-
-    : object(std::move(_object))
-    , nonce(this->object.value("nonce").toString())
-    , error(this->object.value("error").toString())
-    , typeString(this->object.value("type").toString())
+std::optional<PubSubMessage> parsePubSubBaseMessage(std::string &frame)
 {
-    auto oType = qmagicenum::enumCast<Type>(this->typeString);
-    if (oType.has_value())
+    JsonFrame json(frame);
+    if (!json.isValid())
     {
-        this->type = oType.value();
+        return std::nullopt;
     }
-}
 
-std::optional<PubSubMessage> parsePubSubBaseMessage(const QString &blob)
-{
-    QJsonDocument jsonDoc(QJsonDocument::fromJson(blob.toUtf8()));
+    const auto &root = json.root();
+
+    PubSubMessage message;
+    message.nonce = JsonFrame::qString(root, "nonce");
+    message.error = JsonFrame::qString(root, "error");
+    message.typeString = JsonFrame::qString(root, "type");
+    message.type = qmagicenum::enumCast<PubSubMessage::Type>(message.typeString)
+                       .value_or(PubSubMessage::Type::INVALID);
 
-    if (jsonDoc.isNull())
+    const auto *data = JsonFrame::member(root, "data");
+    if (data != nullptr && data->IsObject())
     {
-        return std::nullopt;
+        message.hasData = true;
+        message.topic = JsonFrame::qString(*data, "topic");
+
+        // The inner message was unescaped in place, so it's JSON already
+        auto payload = JsonFrame::string(*data, "message");
+        message.payload = QByteArray(payload.data(),
+                                     static_cast<qsizetype>(payload.size()));
     }
 
-    return PubSubMessage(jsonDoc.object());
+    return message;
+}
+
+std::optional<PubSubMessage> parsePubSubBaseMessage(const QString &blob)
+{
+    auto frame = blob.toStdString();
+    return parsePubSubBaseMessage(frame);
 }
 
 }  // namespace chatterino
@@ -1,11 +1,11 @@
 #pragma once
 
 #include <magic_enum/magic_enum.hpp>
-#include <QJsonDocument>
-#include <QJsonObject>
+#include <QByteArray>
 #include <QString>
 
 #include <optional>
+#include <string>
 
 namespace chatterino {
 
@@ -18,33 +18,36 @@ struct PubSubMessage {
         INVALID,
     };
 
-    QJsonObject object;
-
     QString nonce;
     QString error;
     QString typeString;
-    Type type;
+    Type type = Type::INVALID;
 
-    PubSubMessage(QJsonObject _object);
+    /// Whether the message had a `data` object
+    bool hasData = false;
+    /// `data.topic`
+    QString topic;
+    /// `data.message`, which is JSON itself and only parsed when it's used
+    QByteArray payload;
 
     template <class InnerClass>
-    std::optional<InnerClass> toInner();
+    std::optional<InnerClass> toInner() const;
 };
 
 template <class InnerClass>
-std::optional<InnerClass> PubSubMessage::toInner()
+std::optional<InnerClass> PubSubMessage::toInner() const
 {
-    auto dataValue = this->object.value("data");
-    if (!dataValue.isObject())
+    if (!this->hasData)
     {
         return std::nullopt;
     }
 
-    auto data = dataValue.toObject();
-
-    return InnerClass{this->nonce, data};
+    return InnerClass{this->nonce, this->topic, this->payload};
 }
 
+/// Parses the websocket frame @a frame in place (see JsonFrame)
+std::optional<PubSubMessage> parsePubSubBaseMessage(std::string &frame);
+
 std::optional<PubSubMessage> parsePubSubBaseMessage(const QString &blob);
 
 }  // namespace chatterino
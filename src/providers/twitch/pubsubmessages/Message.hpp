@@ -2,6 +2,7 @@
 
 #include "common/QLogging.hpp"
 
+#include <QByteArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QString>
@@ -16,13 +17,12 @@ struct PubSubMessageMessage {
 
     QJsonObject messageObject;
 
-    PubSubMessageMessage(QString _nonce, const QJsonObject &data)
+    PubSubMessageMessage(QString _nonce, QString _topic,
+                         const QByteArray &payload)
         : nonce(std::move(_nonce))
-        , topic(data.value("topic").toString())
+        , topic(std::move(_topic))
     {
-        auto messagePayload = data.value("message").toString().toUtf8();
-
-        auto messageDoc = QJsonDocument::fromJson(messagePayload);
+        auto messageDoc = QJsonDocument::fromJson(payload);
 
         if (messageDoc.isNull())
         {
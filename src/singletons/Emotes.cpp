@@ -1,12 +1,17 @@
 #include "singletons/Emotes.hpp"
 
+#include "controllers/completion/sources/EmoteIndex.hpp"
+
 namespace chatterino {
 
 Emotes::Emotes()
+    : emoteIndexCache(std::make_unique<completion::EmoteIndexCache>())
 {
     this->emojis.load();
 
     this->gifTimer.initialize();
 }
 
+Emotes::~Emotes() = default;
+
 }  // namespace chatterino
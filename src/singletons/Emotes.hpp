@@ -4,8 +4,14 @@
 #include "providers/twitch/TwitchEmotes.hpp"
 #include "singletons/helper/GifTimer.hpp"
 
+#include <memory>
+
 namespace chatterino {
 
+namespace completion {
+    class EmoteIndexCache;
+}  // namespace completion
+
 class IEmotes
 {
 public:
@@ -14,12 +20,20 @@ public:
     virtual ITwitchEmotes *getTwitchEmotes() = 0;
     virtual IEmojis *getEmojis() = 0;
     virtual GIFTimer &getGIFTimer() = 0;
+    virtual completion::EmoteIndexCache &getEmoteIndexCache() = 0;
 };
 
 class Emotes final : public IEmotes
 {
 public:
     Emotes();
+    ~Emotes() override;
+
+    Emotes(const Emotes &) = delete;
+    Emotes &operator=(const Emotes &) = delete;
+
+    Emotes(Emotes &&) = delete;
+    Emotes &operator=(Emotes &&) = delete;
 
     ITwitchEmotes *getTwitchEmotes() final
     {
@@ -36,10 +50,17 @@ public:
         return this->gifTimer;
     }
 
+    completion::EmoteIndexCache &getEmoteIndexCache() final
+    {
+        return *this->emoteIndexCache;
+    }
+
     TwitchEmotes twitch;
     Emojis emojis;
 
     GIFTimer gifTimer;
+
+    std::unique_ptr<completion::EmoteIndexCache> emoteIndexCache;
 };
 
 }  // namespace chatterino
@@ -70,6 +70,7 @@ Fonts::Fonts(Settings &settings)
         {
             map.clear();
         }
+        this->wordWidths_.clear();
         this->fontChanged.invoke();
     });
     this->fontChangedListener.addSetting(settings.chatFontFamily);
@@ -87,6 +88,11 @@ QFontMetrics Fonts::getFontMetrics(FontStyle type, float scale)
     return this->getOrCreateFontData(type, scale).metrics;
 }
 
+WordWidthCache &Fonts::getWordWidths()
+{
+    return this->wordWidths_;
+}
+
 Fonts::FontData &Fonts::getOrCreateFontData(FontStyle type, float scale)
 {
     assertInGuiThread();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "messages/layouts/WordWidthCache.hpp"
 #include "pajlada/settings/settinglistener.hpp"
 
 #include <pajlada/signals/signal.hpp>
@@ -46,6 +47,9 @@ public:
     QFont getFont(FontStyle type, float scale);
     QFontMetrics getFontMetrics(FontStyle type, float scale);
 
+    /// Widths of words in chat fonts, cleared when the fonts change
+    WordWidthCache &getWordWidths();
+
     pajlada::Signals::NoArgSignal fontChanged;
 
 private:
@@ -77,6 +81,7 @@ private:
     FontData createFontData(FontStyle type, float scale);
 
     std::vector<std::unordered_map<float, FontData>> fontsByType_;
+    WordWidthCache wordWidths_;
 
     pajlada::SettingListener fontChangedListener;
 };
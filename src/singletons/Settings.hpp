@@ -307,6 +307,9 @@ public:
         "/behaviour/autocompletion/prefixOnlyCompletion", true};
     BoolSetting userCompletionOnlyWithAt = {
         "/behaviour/autocompletion/userCompletionOnlyWithAt", false};
+    /// Number of recent chatters remembered per channel for completion
+    IntSetting chatterCompletionLimit = {
+        "/behaviour/autocompletion/chatterLimit", 2000};
     BoolSetting emoteCompletionWithColon = {
         "/behaviour/autocompletion/emoteCompletionWithColon", true};
     BoolSetting showUsernameCompletionMenu = {
@@ -612,6 +615,11 @@ public:
         "/misc/scrollback/usercardLimit",
         1000,
     };
+    /// Maximum size of the message drawing buffers of a split in MiB
+    IntSetting messageBufferCacheSize = {
+        "/misc/messageBufferCacheSize",
+        64,
+    };
 
     EnumStringSetting<ChatSendProtocol> chatSendProtocol = {
         "/misc/chatSendProtocol", ChatSendProtocol::Default};
@@ -677,6 +685,12 @@ public:
         "/misc/twitch/lowRateLimitDelay",
         1100,
     };
+    /// Number of connections joined channels are spread across.
+    /// Changes apply the next time we connect.
+    IntSetting twitchReadConnections = {
+        "/misc/twitch/readConnections",
+        1,
+    };
     BoolSetting ignoreMaxMessageRateLimit = {
       "/misc/twitch/ignoreMaxMessageRateLimit", false};
     BoolSetting useBotLimitsJoin = {"/misc/botLimitsJoin", false};
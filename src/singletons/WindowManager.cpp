@@ -15,6 +15,7 @@
 #include "widgets/AccountSwitchPopup.hpp"
 #include "widgets/dialogs/SettingsDialog.hpp"
 #include "widgets/FramelessEmbedWindow.hpp"
+#include "widgets/helper/FrameScheduler.hpp"
 #include "widgets/helper/NotebookTab.hpp"
 #include "widgets/Notebook.hpp"
 #include "widgets/OverlayWindow.hpp"
@@ -30,6 +31,7 @@
 #include <QMessageBox>
 #include <QSaveFile>
 #include <QScreen>
+#include <QThreadPool>
 
 #include <chrono>
 #include <optional>
@@ -110,6 +112,8 @@ WindowManager::WindowManager(const Paths &paths, Settings &settings,
     , repaintVisibleChatWidgetsListener([this] {
         this->repaintVisibleChatWidgets();
     })
+    , frameScheduler_(std::make_unique<FrameScheduler>())
+    , searchPool_(std::make_unique<QThreadPool>())
 {
     qCDebug(chatterinoWindowmanager) << "init WindowManager";
 
@@ -168,7 +172,12 @@ WindowManager::WindowManager(const Paths &paths, Settings &settings,
     this->updateWordTypeMask();
 }
 
-WindowManager::~WindowManager() = default;
+WindowManager::~WindowManager()
+{
+    // Searches are cancelled when their popups close, so this doesn't block
+    // for long
+    this->searchPool_->waitForDone();
+}
 
 MessageElementFlags WindowManager::getWordFlags()
 {
@@ -618,6 +627,16 @@ std::set<QString> WindowManager::getVisibleChannelNames() const
     return visible;
 }
 
+FrameScheduler &WindowManager::getFrameScheduler()
+{
+    return *this->frameScheduler_;
+}
+
+QThreadPool &WindowManager::getSearchPool()
+{
+    return *this->searchPool_;
+}
+
 void WindowManager::encodeTab(SplitContainer *tab, bool isSelected,
                               QJsonObject &obj)
 {
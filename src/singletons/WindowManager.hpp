@@ -11,6 +11,8 @@
 #include <memory>
 #include <set>
 
+class QThreadPool;
+
 namespace chatterino {
 
 class Settings;
@@ -34,6 +36,7 @@ enum class WindowType;
 
 enum class SettingsDialogPreference;
 class FramelessEmbedWindow;
+class FrameScheduler;
 
 class WindowManager final
 {
@@ -134,6 +137,12 @@ public:
 
     std::set<QString> getVisibleChannelNames() const;
 
+    /// Returns the scheduler that lays out and repaints all ChannelViews
+    FrameScheduler &getFrameScheduler();
+
+    /// Returns the pool the search popups run their searches on
+    QThreadPool &getSearchPool();
+
     /// Signals
     pajlada::Signals::NoArgSignal gifRepaintRequested;
 
@@ -187,6 +196,9 @@ private:
     SignalListener invalidateChannelViewBuffersListener;
     SignalListener repaintVisibleChatWidgetsListener;
 
+    std::unique_ptr<FrameScheduler> frameScheduler_;
+    std::unique_ptr<QThreadPool> searchPool_;
+
     friend class Window;  // this is for selectedWindow_
 };
 
@@ -0,0 +1,632 @@
+#include "singletons/helper/LogIndex.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+using namespace chatterino;
+
+const QByteArray SEGMENT_MAGIC("CLOGIDX1");
+const QString MANIFEST_NAME = QStringLiteral("manifest");
+const QString SEGMENTS_KEY = QStringLiteral("segments");
+
+/// Matches the daily logs written by LoggingChannel (stream logs are skipped,
+/// they contain the same lines)
+const QRegularExpression DAILY_LOG_REGEX(
+    QStringLiteral(R"(-(\d{4}-\d{2}-\d{2})\.log$)"));
+
+/// Matches a logged line, mentions and automod lines start with the channel
+const QRegularExpression LINE_REGEX(
+    QStringLiteral(R"(^(#\S+ )?\[(\d{2}:\d{2}:\d{2})\] (.*)$)"));
+
+void writeVarint(QByteArray &out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.append(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+void writeBytes(QByteArray &out, const QByteArray &bytes)
+{
+    writeVarint(out, static_cast<uint64_t>(bytes.size()));
+    out.append(bytes);
+}
+
+class Reader
+{
+public:
+    explicit Reader(const QByteArray &data)
+        : it_(data.constData())
+        , end_(data.constData() + data.size())
+    {
+    }
+
+    uint64_t varint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (this->it_ == this->end_)
+            {
+                break;
+            }
+
+            auto byte = static_cast<uint8_t>(*this->it_++);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+
+        this->ok_ = false;
+        return 0;
+    }
+
+    QByteArray bytes()
+    {
+        auto size = this->varint();
+        if (size > static_cast<uint64_t>(this->end_ - this->it_))
+        {
+            this->ok_ = false;
+            return {};
+        }
+
+        QByteArray bytes(this->it_, static_cast<qsizetype>(size));
+        this->it_ += size;
+        return bytes;
+    }
+
+    bool ok() const
+    {
+        return this->ok_;
+    }
+
+private:
+    const char *it_;
+    const char *end_;
+    bool ok_ = true;
+};
+
+/// Decodes the delta-encoded line numbers in @a postings into @a out
+void decodePostings(const QByteArray &postings, std::vector<uint32_t> &out)
+{
+    Reader reader(postings);
+    uint32_t line = 0;
+    while (true)
+    {
+        auto delta = reader.varint();
+        if (!reader.ok())
+        {
+            break;
+        }
+        line += static_cast<uint32_t>(delta);
+        out.push_back(line);
+    }
+}
+
+/// Returns the part of @a line after its timestamp
+QStringView messagePart(QStringView line)
+{
+    auto end = line.indexOf(u"] ");
+    if (end < 0)
+    {
+        return line;
+    }
+    return line.mid(end + 2);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+struct LogIndex::Segment {
+    struct Line {
+        uint32_t file = 0;
+        qint64 offset = 0;
+    };
+
+    QStringList files;
+    std::vector<Line> lines;
+    /// Sorted UTF-8 tokens
+    std::vector<QByteArray> terms;
+    /// Delta and varint encoded line numbers of each term
+    std::vector<QByteArray> postings;
+
+    /// Returns the lines containing a token starting with @a prefix
+    std::vector<uint32_t> find(const QByteArray &prefix) const
+    {
+        std::vector<uint32_t> result;
+
+        auto it = std::lower_bound(this->terms.begin(), this->terms.end(),
+                                   prefix);
+        for (; it != this->terms.end() && it->startsWith(prefix); ++it)
+        {
+            decodePostings(this->postings[it - this->terms.begin()], result);
+        }
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+};
+
+struct LogIndex::SegmentBuilder {
+    QStringList files;
+    std::vector<Segment::Line> lines;
+    std::map<QByteArray, std::vector<uint32_t>> postings;
+
+    void add(const QString &file, qint64 offset, QStringView text)
+    {
+        if (this->files.isEmpty() || this->files.back() != file)
+        {
+            this->files.append(file);
+        }
+
+        auto line = static_cast<uint32_t>(this->lines.size());
+        this->lines.push_back({
+            .file = static_cast<uint32_t>(this->files.size() - 1),
+            .offset = offset,
+        });
+
+        for (const auto &token : tokenize(messagePart(text)))
+        {
+            auto &termLines = this->postings[token.toUtf8()];
+            if (termLines.empty() || termLines.back() != line)
+            {
+                termLines.push_back(line);
+            }
+        }
+    }
+
+    QByteArray serialize() const
+    {
+        QByteArray out = SEGMENT_MAGIC;
+
+        writeVarint(out, static_cast<uint64_t>(this->files.size()));
+        for (const auto &file : this->files)
+        {
+            writeBytes(out, file.toUtf8());
+        }
+
+        writeVarint(out, this->lines.size());
+        for (const auto &line : this->lines)
+        {
+            writeVarint(out, line.file);
+            writeVarint(out, static_cast<uint64_t>(line.offset));
+        }
+
+        writeVarint(out, this->postings.size());
+        for (const auto &[term, termLines] : this->postings)
+        {
+            writeBytes(out, term);
+
+            QByteArray encoded;
+            uint32_t previous = 0;
+            for (auto line : termLines)
+            {
+                writeVarint(encoded, line - previous);
+                previous = line;
+            }
+            writeBytes(out, encoded);
+        }
+
+        return out;
+    }
+};
+
+std::shared_ptr<LogIndex> LogIndex::forDirectory(const QString &logDirectory)
+{
+    static std::mutex mutex;
+    static std::map<QString, std::weak_ptr<LogIndex>> indices;
+
+    std::lock_guard lock(mutex);
+    auto &weak = indices[logDirectory];
+    auto index = weak.lock();
+    if (!index)
+    {
+        index = std::make_shared<LogIndex>(logDirectory);
+        weak = index;
+    }
+    return index;
+}
+
+LogIndex::LogIndex(QString logDirectory)
+    : logDirectory_(std::move(logDirectory))
+    , indexDirectory_(this->logDirectory_ + QDir::separator() + ".index")
+{
+}
+
+LogIndex::~LogIndex() = default;
+
+void LogIndex::update(const CancellationToken &token)
+{
+    std::lock_guard lock(this->mutex_);
+    this->loadManifest();
+
+    const auto logFiles = QDir(this->logDirectory_)
+                              .entryList({QStringLiteral("*.log")}, QDir::Files,
+                                         QDir::Name);
+
+    // Read positions are only committed with the segment containing their
+    // lines, so lines of a segment that couldn't be written are read again
+    auto indexedBytes = this->indexedBytes_;
+    SegmentBuilder builder;
+    auto flush = [&] {
+        if (builder.lines.empty())
+        {
+            // Only "# ..." lines were read
+            this->indexedBytes_ = indexedBytes;
+            return true;
+        }
+
+        if (!this->writeSegment(builder))
+        {
+            return false;
+        }
+        this->indexedBytes_ = indexedBytes;
+        this->saveManifest();
+        builder = {};
+        return true;
+    };
+
+    for (const auto &name : logFiles)
+    {
+        if (token.isCancelled())
+        {
+            return;
+        }
+
+        if (!DAILY_LOG_REGEX.match(name).hasMatch())
+        {
+            continue;
+        }
+
+        QFile file(this->logDirectory_ + QDir::separator() + name);
+        auto &indexed = indexedBytes[name];
+        if (file.size() <= indexed || !file.open(QIODevice::ReadOnly) ||
+            !file.seek(indexed))
+        {
+            continue;
+        }
+
+        while (!file.atEnd())
+        {
+            auto line = file.readLine();
+            if (!line.endsWith('\n'))
+            {
+                // The line is still being written
+                break;
+            }
+
+            auto offset = indexed;
+            indexed += line.size();
+            if (line.startsWith("# "))
+            {
+                // "# Start logging at ..." and "# Stop logging at ..."
+                continue;
+            }
+
+            builder.add(name, offset, QString::fromUtf8(line).trimmed());
+            if (builder.lines.size() >= SEGMENT_LINES)
+            {
+                if (!flush() || token.isCancelled())
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    flush();
+}
+
+std::vector<LogSearchResult> LogIndex::search(const QStringList &words,
+                                              size_t limit,
+                                              const CancellationToken &token)
+{
+    std::vector<QByteArray> prefixes;
+    for (const auto &word : words)
+    {
+        for (const auto &part : tokenize(word))
+        {
+            prefixes.push_back(part.toUtf8());
+        }
+    }
+    if (prefixes.empty())
+    {
+        return {};
+    }
+
+    std::lock_guard lock(this->mutex_);
+    this->loadManifest();
+
+    std::vector<LogSearchResult> results;
+    QFile file;
+    QDate fileDate;
+
+    // Newer lines are in newer segments
+    for (auto number = this->segmentCount_; number-- > 0;)
+    {
+        if (token.isCancelled())
+        {
+            break;
+        }
+
+        const auto *segment = this->segment(number);
+        if (segment == nullptr)
+        {
+            continue;
+        }
+
+        auto lines = segment->find(prefixes.front());
+        for (size_t i = 1; i < prefixes.size() && !lines.empty(); i++)
+        {
+            auto other = segment->find(prefixes[i]);
+            std::vector<uint32_t> both;
+            std::set_intersection(lines.begin(), lines.end(), other.begin(),
+                                  other.end(), std::back_inserter(both));
+            lines = std::move(both);
+        }
+
+        for (auto it = lines.rbegin(); it != lines.rend(); ++it)
+        {
+            if (*it >= segment->lines.size())
+            {
+                continue;
+            }
+
+            const auto &position = segment->lines[*it];
+            if (position.file >= static_cast<uint32_t>(segment->files.size()))
+            {
+                continue;
+            }
+
+            auto path = this->logDirectory_ + QDir::separator() +
+                        segment->files[position.file];
+            if (file.fileName() != path)
+            {
+                file.close();
+                file.setFileName(path);
+                if (!file.open(QIODevice::ReadOnly))
+                {
+                    continue;
+                }
+                fileDate = QDate::fromString(
+                    DAILY_LOG_REGEX.match(path).captured(1), "yyyy-MM-dd");
+            }
+            if (!file.isOpen() || !file.seek(position.offset))
+            {
+                continue;
+            }
+
+            auto line = QString::fromUtf8(file.readLine()).trimmed();
+            auto matchesAll = std::all_of(
+                words.begin(), words.end(), [&](const auto &word) {
+                    return line.contains(word, Qt::CaseInsensitive);
+                });
+            auto match = LINE_REGEX.match(line);
+            if (!matchesAll || !match.hasMatch())
+            {
+                // The log was changed after it was indexed
+                continue;
+            }
+
+            results.push_back({
+                .time = QDateTime(fileDate, QTime::fromString(match.captured(2),
+                                                              "HH:mm:ss")),
+                .text = match.captured(1) + match.captured(3),
+            });
+            if (results.size() >= limit)
+            {
+                return results;
+            }
+        }
+    }
+
+    return results;
+}
+
+size_t LogIndex::segmentCount()
+{
+    std::lock_guard lock(this->mutex_);
+    this->loadManifest();
+    return this->segmentCount_;
+}
+
+std::vector<QString> LogIndex::tokenize(QStringView text)
+{
+    std::vector<QString> tokens;
+
+    auto isWordCharacter = [](QChar c) {
+        return c.isLetterOrNumber() || c == u'_';
+    };
+
+    qsizetype start = -1;
+    for (qsizetype i = 0; i <= text.size(); i++)
+    {
+        if (i < text.size() && isWordCharacter(text[i]))
+        {
+            if (start < 0)
+            {
+                start = i;
+            }
+            continue;
+        }
+
+        if (start >= 0 && i - start >= MIN_TOKEN_LENGTH)
+        {
+            tokens.push_back(text.mid(start, std::min(i - start,
+                                                      MAX_TOKEN_LENGTH))
+                                 .toString()
+                                 .toCaseFolded());
+        }
+        start = -1;
+    }
+
+    return tokens;
+}
+
+void LogIndex::loadManifest()
+{
+    if (this->manifestLoaded_)
+    {
+        return;
+    }
+    this->manifestLoaded_ = true;
+
+    QFile file(this->indexDirectory_ + QDir::separator() + MANIFEST_NAME);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    while (!file.atEnd())
+    {
+        auto line = QString::fromUtf8(file.readLine()).trimmed();
+        auto tab = line.indexOf('\t');
+        if (tab < 0)
+        {
+            continue;
+        }
+
+        auto key = line.mid(tab + 1);
+        auto value = line.left(tab).toLongLong();
+        if (key == SEGMENTS_KEY)
+        {
+            this->segmentCount_ = static_cast<size_t>(value);
+        }
+        else
+        {
+            this->indexedBytes_[key] = value;
+        }
+    }
+}
+
+void LogIndex::saveManifest() const
+{
+    QSaveFile file(this->indexDirectory_ + QDir::separator() + MANIFEST_NAME);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(chatterinoHelper)
+            << "Failed to write log index manifest" << file.fileName();
+        return;
+    }
+
+    QByteArray contents;
+    contents += QByteArray::number(static_cast<qulonglong>(this->segmentCount_)) +
+                '\t' + SEGMENTS_KEY.toUtf8() + '\n';
+    for (const auto &[name, bytes] : this->indexedBytes_)
+    {
+        contents += QByteArray::number(bytes) + '\t' + name.toUtf8() + '\n';
+    }
+    file.write(contents);
+    file.commit();
+}
+
+QString LogIndex::segmentPath(size_t number) const
+{
+    return this->indexDirectory_ + QDir::separator() +
+           QString::number(static_cast<qulonglong>(number)) + ".seg";
+}
+
+bool LogIndex::writeSegment(const SegmentBuilder &builder)
+{
+    if (!QDir().mkpath(this->indexDirectory_))
+    {
+        qCWarning(chatterinoHelper)
+            << "Unable to create log index path" << this->indexDirectory_;
+        return false;
+    }
+
+    QSaveFile file(this->segmentPath(this->segmentCount_));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(chatterinoHelper)
+            << "Failed to write log index segment" << file.fileName();
+        return false;
+    }
+    file.write(qCompress(builder.serialize()));
+    if (!file.commit())
+    {
+        qCWarning(chatterinoHelper)
+            << "Failed to write log index segment" << file.fileName();
+        return false;
+    }
+
+    this->segmentCount_++;
+    return true;
+}
+
+const LogIndex::Segment *LogIndex::segment(size_t number)
+{
+    if (number < this->segments_.size() && this->segments_[number])
+    {
+        return this->segments_[number].get();
+    }
+
+    QFile file(this->segmentPath(number));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return nullptr;
+    }
+
+    auto data = qUncompress(file.readAll());
+    if (!data.startsWith(SEGMENT_MAGIC))
+    {
+        qCWarning(chatterinoHelper)
+            << "Ignoring invalid log index segment" << file.fileName();
+        return nullptr;
+    }
+
+    Reader body(data.mid(SEGMENT_MAGIC.size()));
+    auto segment = std::make_unique<Segment>();
+
+    auto fileCount = body.varint();
+    for (uint64_t i = 0; i < fileCount && body.ok(); i++)
+    {
+        segment->files.append(QString::fromUtf8(body.bytes()));
+    }
+
+    auto lineCount = body.varint();
+    for (uint64_t i = 0; i < lineCount && body.ok(); i++)
+    {
+        auto fileIndex = static_cast<uint32_t>(body.varint());
+        auto offset = static_cast<qint64>(body.varint());
+        segment->lines.push_back({.file = fileIndex, .offset = offset});
+    }
+
+    auto termCount = body.varint();
+    for (uint64_t i = 0; i < termCount && body.ok(); i++)
+    {
+        segment->terms.push_back(body.bytes());
+        segment->postings.push_back(body.bytes());
+    }
+
+    if (!body.ok())
+    {
+        qCWarning(chatterinoHelper)
+            << "Ignoring truncated log index segment" << file.fileName();
+        return nullptr;
+    }
+
+    if (this->segments_.size() <= number)
+    {
+        this->segments_.resize(number + 1);
+    }
+    this->segments_[number] = std::move(segment);
+    return this->segments_[number].get();
+}
+
+}  // namespace chatterino
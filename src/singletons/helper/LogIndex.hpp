@@ -0,0 +1,111 @@
+#pragma once
+
+#include "util/CancellationToken.hpp"
+
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+struct LogSearchResult {
+    /// When the line was logged (local time)
+    QDateTime time;
+    /// The logged line without its timestamp
+    QString text;
+};
+
+/// @brief Full-text index over the daily log files in one log directory
+///
+/// The index is stored in a `.index` directory next to the logs. It consists
+/// of immutable zlib-compressed segments, which map the words of logged lines
+/// to the lines' positions in the log files, and a manifest recording how much
+/// of each log file is indexed. #update only indexes what was appended to the
+/// logs since the last update. Segments are never rewritten.
+///
+/// A query word matches all words it's a prefix of (case-insensitively).
+/// Matching lines are read from the logs and checked to contain every query
+/// word before they're returned, so deleted or edited logs never produce
+/// wrong results.
+///
+/// All methods are thread-safe.
+class LogIndex
+{
+public:
+    /// Number of lines after which a segment is written
+    static constexpr size_t SEGMENT_LINES = 1 << 15;
+    /// Words shorter than this aren't indexed
+    static constexpr qsizetype MIN_TOKEN_LENGTH = 2;
+    /// Words are indexed up to this length
+    static constexpr qsizetype MAX_TOKEN_LENGTH = 32;
+
+    /// Returns the index of @a logDirectory, shared with everyone who uses it
+    /// at the same time
+    static std::shared_ptr<LogIndex> forDirectory(const QString &logDirectory);
+
+    explicit LogIndex(QString logDirectory);
+    ~LogIndex();
+
+    LogIndex(const LogIndex &) = delete;
+    LogIndex &operator=(const LogIndex &) = delete;
+
+    LogIndex(LogIndex &&) = delete;
+    LogIndex &operator=(LogIndex &&) = delete;
+
+    /// @brief Indexes all lines that were appended to the logs since the last
+    /// update
+    ///
+    /// @param token stops the update after the current segment when it's
+    ///              cancelled. The remaining lines are indexed next time.
+    void update(const CancellationToken &token);
+
+    /// @brief Returns the newest lines that contain all @a words
+    ///
+    /// Words are matched case-insensitively. Words shorter than
+    /// MIN_TOKEN_LENGTH can't be looked up and are only checked on lines
+    /// matching the other words. If there's no word that can be looked up,
+    /// nothing is returned.
+    ///
+    /// @param limit the maximum number of lines to return
+    /// @param token stops the search early when it's cancelled
+    std::vector<LogSearchResult> search(const QStringList &words, size_t limit,
+                                        const CancellationToken &token);
+
+    /// Returns the number of segments (used in tests)
+    size_t segmentCount();
+
+    /// Splits @a text into the case-folded words that get indexed
+    static std::vector<QString> tokenize(QStringView text);
+
+private:
+    struct Segment;
+    struct SegmentBuilder;
+
+    void loadManifest();
+    void saveManifest() const;
+
+    QString segmentPath(size_t number) const;
+    /// Writes the next segment. Returns false if it couldn't be written.
+    bool writeSegment(const SegmentBuilder &builder);
+    const Segment *segment(size_t number);
+
+    const QString logDirectory_;
+    const QString indexDirectory_;
+
+    std::mutex mutex_;
+    bool manifestLoaded_ = false;
+    /// Number of indexed bytes by log file name
+    std::map<QString, qint64> indexedBytes_;
+    size_t segmentCount_ = 0;
+    /// Segments loaded so far, by number
+    std::vector<std::unique_ptr<Segment>> segments_;
+};
+
+}  // namespace chatterino
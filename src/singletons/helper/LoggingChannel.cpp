@@ -60,38 +60,56 @@ LoggingChannel::LoggingChannel(QString _channelName, QString _platform)
     : channelName(std::move(_channelName))
     , platform(std::move(_platform))
 {
-    if (this->channelName.startsWith("/whispers"))
+    this->subDirectory = subDirectoryFor(this->channelName, this->platform);
+
+    getSettings()->logPath.connect([this](const QString &logPath, auto) {
+        this->baseDirectory = baseDirectoryFor(logPath);
+        this->openLogFile();
+    });
+}
+
+QString LoggingChannel::directoryFor(const QString &channelName,
+                                     const QString &platform)
+{
+    return baseDirectoryFor(getSettings()->logPath.getValue()) +
+           QDir::separator() + subDirectoryFor(channelName, platform);
+}
+
+QString LoggingChannel::subDirectoryFor(const QString &channelName,
+                                        const QString &platform)
+{
+    QString subDirectory;
+    if (channelName.startsWith("/whispers"))
     {
-        this->subDirectory = "Whispers";
+        subDirectory = "Whispers";
     }
     else if (channelName.startsWith("/mentions"))
     {
-        this->subDirectory = "Mentions";
+        subDirectory = "Mentions";
     }
     else if (channelName.startsWith("/live"))
     {
-        this->subDirectory = "Live";
+        subDirectory = "Live";
     }
     else if (channelName.startsWith("/automod"))
     {
-        this->subDirectory = "AutoMod";
+        subDirectory = "AutoMod";
     }
     else
     {
-        this->subDirectory =
+        subDirectory =
             QStringLiteral("Channels") + QDir::separator() + channelName;
     }
 
     // enforce capitalized platform names
-    this->subDirectory = platform[0].toUpper() + platform.mid(1).toLower() +
-                         QDir::separator() + this->subDirectory;
+    return platform[0].toUpper() + platform.mid(1).toLower() +
+           QDir::separator() + subDirectory;
+}
 
-    getSettings()->logPath.connect([this](const QString &logPath, auto) {
-        this->baseDirectory = logPath.isEmpty()
-                                  ? getApp()->getPaths().messageLogDirectory
-                                  : logPath;
-        this->openLogFile();
-    });
+QString LoggingChannel::baseDirectoryFor(const QString &logPath)
+{
+    return logPath.isEmpty() ? getApp()->getPaths().messageLogDirectory
+                             : logPath;
 }
 
 LoggingChannel::~LoggingChannel()
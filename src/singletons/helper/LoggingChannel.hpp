@@ -26,7 +26,16 @@ public:
 
     void addMessage(const MessagePtr &message, const QString &streamID);
 
+    /// Returns the directory the logs of @a channelName on @a platform are
+    /// written to
+    static QString directoryFor(const QString &channelName,
+                                const QString &platform);
+
 private:
+    static QString subDirectoryFor(const QString &channelName,
+                                   const QString &platform);
+    static QString baseDirectoryFor(const QString &logPath);
+
     void openLogFile();
     void openStreamLogFile(const QString &streamID);
 
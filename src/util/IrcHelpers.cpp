@@ -1,39 +1,41 @@
 #include "util/IrcHelpers.hpp"
 
 #include "Application.hpp"
+#include "providers/twitch/TwitchIrcTags.hpp"
 
 namespace {
 
 using namespace chatterino;
 
-QDateTime calculateMessageTimeBase(const Communi::IrcMessage *message)
+QDateTime calculateMessageTimeBase(const TwitchIrcTags &tags)
 {
+    using Tag = TwitchIrcTags::Tag;
+
     // Check if message is from recent-messages API
-    if (message->tags().contains("historical"))
+    if (tags.has(Tag::Historical))
     {
         bool customReceived = false;
-        auto ts =
-            message->tags().value("rm-received-ts").toLongLong(&customReceived);
+        auto ts = tags.integer(Tag::RmReceivedTs, &customReceived);
         if (!customReceived)
         {
-            ts = message->tags().value("tmi-sent-ts").toLongLong();
+            ts = tags.integer(Tag::TmiSentTs);
         }
 
         return QDateTime::fromMSecsSinceEpoch(ts);
     }
 
     // If present, handle tmi-sent-ts tag and use it as timestamp
-    if (message->tags().contains("tmi-sent-ts"))
+    if (tags.has(Tag::TmiSentTs))
     {
-        auto ts = message->tags().value("tmi-sent-ts").toLongLong();
+        auto ts = tags.integer(Tag::TmiSentTs);
         return QDateTime::fromMSecsSinceEpoch(ts);
     }
 
     // Some IRC Servers might have server-time tag containing UTC date in ISO format, use it as timestamp
     // See: https://ircv3.net/irc/#server-time
-    if (message->tags().contains("time"))
+    if (tags.has(Tag::Time))
     {
-        QString timedate = message->tags().value("time").toString();
+        QString timedate = tags.value(Tag::Time).toString();
 
         auto date = QDateTime::fromString(timedate, Qt::ISODate);
         date.setTimeZone(QTimeZone::utc());
@@ -57,7 +59,12 @@ namespace chatterino {
 
 QDateTime calculateMessageTime(const Communi::IrcMessage *message)
 {
-    auto dt = calculateMessageTimeBase(message);
+    return calculateMessageTime(TwitchIrcTags::fromMessage(message));
+}
+
+QDateTime calculateMessageTime(const TwitchIrcTags &tags)
+{
+    auto dt = calculateMessageTimeBase(tags);
 
 #ifdef CHATTERINO_WITH_TESTS
     if (getApp()->isTest())
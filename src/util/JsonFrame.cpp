@@ -0,0 +1,129 @@
+#include "util/JsonFrame.hpp"
+
+#include <QJsonArray>
+
+namespace chatterino {
+
+JsonFrame::JsonFrame(std::string &payload)
+{
+    // std::string is always null-terminated
+    this->document_.ParseInsitu(payload.data());
+}
+
+bool JsonFrame::isValid() const
+{
+    return !this->document_.HasParseError() && this->document_.IsObject();
+}
+
+const rapidjson::Value &JsonFrame::root() const
+{
+    return this->document_;
+}
+
+const rapidjson::Value *JsonFrame::member(const rapidjson::Value &object,
+                                          const char *key)
+{
+    if (!object.IsObject())
+    {
+        return nullptr;
+    }
+
+    auto it = object.FindMember(key);
+    if (it == object.MemberEnd())
+    {
+        return nullptr;
+    }
+    return &it->value;
+}
+
+std::string_view JsonFrame::string(const rapidjson::Value &object,
+                                   const char *key)
+{
+    const auto *value = JsonFrame::member(object, key);
+    if (value == nullptr || !value->IsString())
+    {
+        return {};
+    }
+    return {value->GetString(), value->GetStringLength()};
+}
+
+QString JsonFrame::qString(const rapidjson::Value &object, const char *key)
+{
+    auto value = JsonFrame::string(object, key);
+    return QString::fromUtf8(value.data(), static_cast<qsizetype>(value.size()));
+}
+
+int64_t JsonFrame::integer(const rapidjson::Value &object, const char *key,
+                           int64_t fallback)
+{
+    const auto *value = JsonFrame::member(object, key);
+    if (value == nullptr || !value->IsInt64())
+    {
+        return fallback;
+    }
+    return value->GetInt64();
+}
+
+QJsonObject JsonFrame::toQt(const rapidjson::Value &object, const char *key)
+{
+    const auto *value = JsonFrame::member(object, key);
+    if (value == nullptr || !value->IsObject())
+    {
+        return {};
+    }
+    return JsonFrame::toQt(*value).toObject();
+}
+
+QJsonValue JsonFrame::toQt(const rapidjson::Value &value)
+{
+    switch (value.GetType())
+    {
+        case rapidjson::kNullType:
+            return QJsonValue::Null;
+
+        case rapidjson::kFalseType:
+            return false;
+
+        case rapidjson::kTrueType:
+            return true;
+
+        case rapidjson::kStringType:
+            return QString::fromUtf8(
+                value.GetString(),
+                static_cast<qsizetype>(value.GetStringLength()));
+
+        case rapidjson::kNumberType:
+            // Like QJsonDocument, keep integers exact
+            if (value.IsInt64())
+            {
+                return static_cast<qint64>(value.GetInt64());
+            }
+            return value.GetDouble();
+
+        case rapidjson::kArrayType: {
+            QJsonArray array;
+            for (const auto &item : value.GetArray())
+            {
+                array.append(JsonFrame::toQt(item));
+            }
+            return array;
+        }
+
+        case rapidjson::kObjectType: {
+            QJsonObject object;
+            for (const auto &member : value.GetObject())
+            {
+                object.insert(
+                    QString::fromUtf8(
+                        member.name.GetString(),
+                        static_cast<qsizetype>(member.name.GetStringLength())),
+                    JsonFrame::toQt(member.value));
+            }
+            return object;
+        }
+    }
+
+    return {};
+}
+
+}  // namespace chatterino
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <rapidjson/document.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace chatterino {
+
+/// @brief A JSON object parsed in place from the payload of a websocket frame
+///
+/// The payload is parsed with rapidjson's in-situ mode. Strings are unescaped
+/// inside the payload, so reading a field doesn't copy it, and the payload
+/// doesn't have to be converted to a QString first. Messages can dispatch on
+/// a field and only convert the parts they use to Qt's types.
+///
+/// The payload is modified while parsing and has to outlive the frame.
+class JsonFrame
+{
+public:
+    /// Parses @a payload in place
+    explicit JsonFrame(std::string &payload);
+    ~JsonFrame() = default;
+
+    JsonFrame(const JsonFrame &) = delete;
+    JsonFrame(JsonFrame &&) = delete;
+    JsonFrame &operator=(const JsonFrame &) = delete;
+    JsonFrame &operator=(JsonFrame &&) = delete;
+
+    /// Returns true if the payload is a JSON object
+    bool isValid() const;
+
+    const rapidjson::Value &root() const;
+
+    /// Returns the member @a key of @a object or nullptr if it's missing
+    static const rapidjson::Value *member(const rapidjson::Value &object,
+                                          const char *key);
+
+    /// Returns the string member @a key of @a object as a view into the
+    /// payload. Returns an empty view if it's missing or not a string.
+    static std::string_view string(const rapidjson::Value &object,
+                                   const char *key);
+
+    /// Returns the string member @a key of @a object.
+    /// Returns an empty string if it's missing or not a string.
+    static QString qString(const rapidjson::Value &object, const char *key);
+
+    /// Returns the integer member @a key of @a object or @a fallback if it's
+    /// missing or not an integer
+    static int64_t integer(const rapidjson::Value &object, const char *key,
+                           int64_t fallback = 0);
+
+    /// Converts the object member @a key of @a object to a QJsonObject.
+    /// Returns an empty object if it's missing or not an object.
+    static QJsonObject toQt(const rapidjson::Value &object, const char *key);
+
+    /// Converts @a value to a QJsonValue
+    static QJsonValue toQt(const rapidjson::Value &value);
+
+private:
+    rapidjson::Document document_;
+};
+
+}  // namespace chatterino
@@ -16,6 +16,11 @@ RatelimitBucket::RatelimitBucket(int budget, int cooldown,
 
 void RatelimitBucket::send(QString channel)
 {
+    if (this->queue_.contains(channel))
+    {
+        return;
+    }
+
     this->queue_.append(channel);
 
     if (this->budget_ > 0)
@@ -24,6 +29,17 @@ void RatelimitBucket::send(QString channel)
     }
 }
 
+void RatelimitBucket::sendFirst(QString channel)
+{
+    this->queue_.removeOne(channel);
+    this->queue_.prepend(channel);
+
+    if (this->budget_ > 0)
+    {
+        this->handleOne();
+    }
+}
+
 void RatelimitBucket::handleOne()
 {
     if (queue_.isEmpty())
@@ -14,8 +14,14 @@ public:
     RatelimitBucket(int budget, int cooldown,
                     std::function<void(QString)> callback, QObject *parent);
 
+    /// Queues @a channel behind everything that's already waiting.
+    /// Does nothing if @a channel is already queued.
     void send(QString channel);
 
+    /// Queues @a channel in front of everything that's already waiting.
+    /// Moves @a channel to the front if it's already queued.
+    void sendFirst(QString channel);
+
 private:
     /**
      * @brief budget_ denotes the amount of calls that can be handled before we need to wait for the cooldown
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace chatterino {
+
+/// @brief A bounded lock-free queue between one producer and one consumer
+///
+/// #tryPush must only be called from one thread and #tryPop from one (other)
+/// thread. #size can be called from anywhere, but it's only a snapshot.
+template <typename T>
+class SpscQueue
+{
+public:
+    /// @a capacity is rounded up to the next power of two
+    explicit SpscQueue(size_t capacity)
+        : capacity_(std::bit_ceil(std::max<size_t>(capacity, 2)))
+        , mask_(this->capacity_ - 1)
+        , slots_(std::make_unique<std::optional<T>[]>(this->capacity_))
+    {
+    }
+
+    ~SpscQueue() = default;
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue(SpscQueue &&) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+    SpscQueue &operator=(SpscQueue &&) = delete;
+
+    /// Appends @a value.
+    /// Returns false (and leaves @a value untouched) if the queue is full.
+    bool tryPush(T &&value)
+    {
+        auto tail = this->tail_.load(std::memory_order_relaxed);
+        if (tail - this->head_.load(std::memory_order_acquire) ==
+            this->capacity_)
+        {
+            return false;
+        }
+
+        this->slots_[tail & this->mask_].emplace(std::move(value));
+        this->tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Removes and returns the first value.
+    /// Returns std::nullopt if the queue is empty.
+    std::optional<T> tryPop()
+    {
+        auto head = this->head_.load(std::memory_order_relaxed);
+        if (head == this->tail_.load(std::memory_order_acquire))
+        {
+            return std::nullopt;
+        }
+
+        auto &slot = this->slots_[head & this->mask_];
+        std::optional<T> value = std::move(slot);
+        slot.reset();
+        this->head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    size_t size() const
+    {
+        // The tail is never behind the head, so load the head first
+        auto head = this->head_.load(std::memory_order_acquire);
+        return this->tail_.load(std::memory_order_acquire) - head;
+    }
+
+    size_t capacity() const
+    {
+        return this->capacity_;
+    }
+
+private:
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<std::optional<T>[]> slots_;
+
+    // Both sides only write their own index, so keep them on separate cache
+    // lines
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+}  // namespace chatterino
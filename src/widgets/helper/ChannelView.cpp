@@ -8,6 +8,7 @@
 #include "controllers/commands/CommandController.hpp"
 #include "controllers/filters/FilterSet.hpp"
 #include "debug/Benchmark.hpp"
+#include "debug/Profiler.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/layouts/MessageLayout.hpp"
@@ -39,6 +40,7 @@
 #include "widgets/dialogs/SettingsDialog.hpp"
 #include "widgets/dialogs/UserInfoPopup.hpp"
 #include "widgets/helper/EffectLabel.hpp"
+#include "widgets/helper/FrameScheduler.hpp"
 #include "widgets/helper/ScrollbarHighlight.hpp"
 #include "widgets/helper/SearchPopup.hpp"
 #include "widgets/Scrollbar.hpp"
@@ -68,6 +70,8 @@
 #include <cmath>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <utility>
 
 namespace {
 
@@ -319,6 +323,10 @@ ChannelView::ChannelView(InternalCtor /*tag*/, QWidget *parent, Split *split,
     this->cursors_.up = QCursor(getResources().scrolling.upScroll);
     this->cursors_.down = QCursor(getResources().scrolling.downScroll);
 
+    QObject::connect(&this->refilterTimer_, &QTimer::timeout, this, [this] {
+        this->refilterNextChunk();
+    });
+
     this->pauseTimer_.setSingleShot(true);
     QObject::connect(&this->pauseTimer_, &QTimer::timeout, this, [this] {
         // remove elements that are finite
@@ -362,7 +370,17 @@ ChannelView::ChannelView(InternalCtor /*tag*/, QWidget *parent, Split *split,
     this->highlightAnimation_.setEasingCurve(curve);
     QObject::connect(&this->highlightAnimation_,
                      &QVariantAnimation::valueChanged, this, [this] {
-                         this->queueUpdate();
+                         for (const auto &visible : this->visibleMessages_)
+                         {
+                             if (visible.layout.get() ==
+                                 this->highlightedMessage_)
+                             {
+                                 this->queueUpdate(
+                                     QRect(0, visible.y, this->width(),
+                                           visible.height));
+                                 return;
+                             }
+                         }
                      });
 
     this->messageColors_.applyTheme(getTheme(), this->isOverlay_,
@@ -396,7 +414,6 @@ void ChannelView::initializeScrollbar()
         if (this->isVisible())
         {
             this->performLayout(true);
-            this->queueUpdate();
         }
         else
         {
@@ -452,6 +469,13 @@ void ChannelView::initializeSignals()
                                        [this] {
                                            this->queueLayout();
                                        });
+
+    getSettings()->messageBufferCacheSize.connect(
+        [this](const int &sizeMiB, auto) {
+            this->bufferAtlas_.setMaxBytes(static_cast<int64_t>(sizeMiB) *
+                                           1024 * 1024);
+        },
+        this->signalHolder_);
 }
 
 Scrollbar *ChannelView::scrollbar()
@@ -632,12 +656,12 @@ void ChannelView::scaleChangedEvent(float scale)
 
 void ChannelView::queueUpdate()
 {
-    this->update();
+    getApp()->getWindows()->getFrameScheduler().requestUpdate(this);
 }
 
-void ChannelView::queueUpdate(const QRect &area)
+void ChannelView::queueUpdate(const QRegion &area)
 {
-    this->update(area);
+    getApp()->getWindows()->getFrameScheduler().requestUpdate(this, area);
 }
 
 void ChannelView::invalidateBuffers()
@@ -650,7 +674,8 @@ void ChannelView::queueLayout()
 {
     if (this->isVisible())
     {
-        this->performLayout();
+        this->layoutScheduled_ = true;
+        getApp()->getWindows()->getFrameScheduler().requestLayout(this);
     }
     else
     {
@@ -668,9 +693,13 @@ void ChannelView::showEvent(QShowEvent * /*event*/)
 
 void ChannelView::performLayout(bool causedByScrollbar, bool causedByShow)
 {
-    // BenchmarkGuard benchmark("layout");
+    ProfileGuard profile(ProfileScope::ViewLayout,
+                         Profiler::instance().isOverlayEnabled()
+                             ? &this->lastLayoutNs_
+                             : nullptr);
 
     this->layoutQueued_ = false;
+    this->layoutScheduled_ = false;
 
     /// Get messages and check if there are at least 1
     const auto &messages = this->getMessagesSnapshot();
@@ -685,6 +714,8 @@ void ChannelView::performLayout(bool causedByScrollbar, bool causedByShow)
     /// Update scrollbar
     this->updateScrollbar(messages, causedByScrollbar, causedByShow);
 
+    this->queueDamage(messages);
+
     this->goToBottom_->setVisible(this->enableScrollingToBottom_ &&
                                   this->scrollBar_->isVisible() &&
                                   !this->scrollBar_->isAtBottom());
@@ -696,7 +727,6 @@ void ChannelView::layoutVisibleMessages(
     const auto start = size_t(this->scrollBar_->getRelativeCurrentValue());
     const auto layoutWidth = this->getLayoutWidth();
     const auto flags = this->getFlags();
-    auto redrawRequired = false;
 
     if (messages.size() > start)
     {
@@ -707,7 +737,7 @@ void ChannelView::layoutVisibleMessages(
         {
             const auto &message = messages[i];
 
-            redrawRequired |= message->layout(
+            auto relaid = message->layout(
                 {
                     .messageColors = this->messageColors_,
                     .flags = flags,
@@ -717,16 +747,15 @@ void ChannelView::layoutVisibleMessages(
                                   static_cast<float>(this->devicePixelRatio()),
                 },
                 this->bufferInvalidationQueued_);
+            if (relaid)
+            {
+                this->relaidMessages_.push_back(message.get());
+            }
 
             y += message->getHeight();
         }
     }
     this->bufferInvalidationQueued_ = false;
-
-    if (redrawRequired)
-    {
-        this->queueUpdate();
-    }
 }
 
 void ChannelView::updateScrollbar(
@@ -794,10 +823,198 @@ void ChannelView::updateScrollbar(
     }
 }
 
+void ChannelView::queueDamage(
+    const LimitedQueueSnapshot<MessageLayoutPtr> &messages)
+{
+    std::vector<VisibleMessage> visible;
+    const auto start = size_t(this->scrollBar_->getRelativeCurrentValue());
+    if (messages.size() > start)
+    {
+        auto y = int(-(messages[start]->getHeight() *
+                       (fmod(this->scrollBar_->getRelativeCurrentValue(), 1))));
+        for (auto i = start; i < messages.size() && y <= this->height(); i++)
+        {
+            visible.push_back({
+                .layout = messages[i],
+                .y = y,
+                .height = messages[i]->getHeight(),
+            });
+            y += messages[i]->getHeight();
+        }
+    }
+
+    auto previous = std::exchange(this->visibleMessages_, std::move(visible));
+    auto relaid = std::exchange(this->relaidMessages_, {});
+    const auto &current = this->visibleMessages_;
+
+    if (!this->isVisible())
+    {
+        // We get fully repainted when we're shown again
+        return;
+    }
+
+    auto wasRelaid = [&](const MessageLayout *layout) {
+        return std::find(relaid.begin(), relaid.end(), layout) != relaid.end();
+    };
+    auto findPrevious = [&](const MessageLayout *layout) {
+        return std::find_if(previous.begin(), previous.end(),
+                            [&](const auto &it) {
+                                return it.layout.get() == layout;
+                            });
+    };
+    auto rowRect = [this](const VisibleMessage &row) {
+        return QRect(0, row.y, this->width(), row.height);
+    };
+
+    // Check if the messages that stay on screen all moved by the same offset
+    // while their contents stayed the same.
+    std::optional<int> offset;
+    // Overlays are translucent and the paused indicator and frame times are
+    // drawn at a fixed position, they'd be moved with the messages.
+    bool canScroll = !this->isOverlay_ && !this->paused() &&
+                     !Profiler::instance().isOverlayEnabled();
+    for (const auto &row : current)
+    {
+        if (!canScroll)
+        {
+            break;
+        }
+
+        auto it = findPrevious(row.layout.get());
+        if (it == previous.end())
+        {
+            continue;
+        }
+
+        canScroll = it->height == row.height && !wasRelaid(row.layout.get()) &&
+                    (!offset || *offset == row.y - it->y);
+        offset = row.y - it->y;
+    }
+
+    QRegion damage;
+    if (canScroll && offset && *offset != 0 &&
+        std::abs(*offset) < this->height())
+    {
+        // The scrollbar is a child, it's not scrolled with us and repaints
+        // on its own, but it's drawn on top of our background.
+        auto scrolled = this->rect();
+        if (this->scrollBar_->isVisible())
+        {
+            scrolled.setRight(this->scrollBar_->x() - 1);
+            damage += QRect(this->scrollBar_->x(), 0, this->scrollBar_->width(),
+                            this->height());
+        }
+
+        // This moves the pixels we've already drawn and repaints the area
+        // that was uncovered.
+        this->scroll(0, *offset, scrolled);
+        getApp()->getWindows()->getFrameScheduler().scrolled(this, *offset);
+        this->animationArea_ =
+            this->animationArea_.translated(0, *offset).intersected(
+                this->rect());
+
+        for (const auto &row : current)
+        {
+            if (findPrevious(row.layout.get()) == previous.end())
+            {
+                damage += rowRect(row);
+            }
+        }
+    }
+    else
+    {
+        for (const auto &row : current)
+        {
+            auto it = findPrevious(row.layout.get());
+            if (it == previous.end() || it->y != row.y ||
+                it->height != row.height || wasRelaid(row.layout.get()))
+            {
+                damage += rowRect(row);
+                if (it != previous.end())
+                {
+                    damage += rowRect(*it);
+                }
+            }
+        }
+        for (const auto &row : previous)
+        {
+            auto it = std::find_if(current.begin(), current.end(),
+                                   [&](const auto &c) {
+                                       return c.layout == row.layout;
+                                   });
+            if (it == current.end())
+            {
+                damage += rowRect(row);
+            }
+        }
+    }
+
+    damage &= this->rect();
+    if (!damage.isEmpty())
+    {
+        this->queueUpdate(damage);
+    }
+}
+
+QRegion ChannelView::messagesRegion(size_t first, size_t last)
+{
+    const auto &messages = this->getMessagesSnapshot();
+    const auto start = size_t(this->scrollBar_->getRelativeCurrentValue());
+    if (start >= messages.size())
+    {
+        return {};
+    }
+
+    QRegion region;
+    auto y = int(-(messages[start]->getHeight() *
+                   (fmod(this->scrollBar_->getRelativeCurrentValue(), 1))));
+    for (auto i = start;
+         i < messages.size() && i <= last && y <= this->height(); i++)
+    {
+        auto height = messages[i]->getHeight();
+        if (i >= first)
+        {
+            region += QRect(0, y, this->width(), height);
+        }
+        y += height;
+    }
+    return region;
+}
+
+QRegion ChannelView::selectionDamage(const Selection &before,
+                                     const Selection &after)
+{
+    auto wholeSelection = [this](const Selection &selection) {
+        return this->messagesRegion(selection.selectionMin.messageIndex,
+                                    selection.selectionMax.messageIndex);
+    };
+    if (before.isEmpty())
+    {
+        return after.isEmpty() ? QRegion() : wholeSelection(after);
+    }
+    if (after.isEmpty())
+    {
+        return wholeSelection(before);
+    }
+
+    // Only the messages between the old and new ends of the selection change
+    auto between = [this](const SelectionItem &a, const SelectionItem &b) {
+        if (a == b)
+        {
+            return QRegion();
+        }
+        return this->messagesRegion(std::min(a.messageIndex, b.messageIndex),
+                                    std::max(a.messageIndex, b.messageIndex));
+    };
+    return between(before.selectionMin, after.selectionMin) +
+           between(before.selectionMax, after.selectionMax);
+}
+
 void ChannelView::clearMessages()
 {
     // Clear all stored messages in this chat widget
     this->messages_.clear();
+    this->refilter_.reset();
     this->scrollBar_->clearHighlights();
     this->scrollBar_->resetBounds();
     this->scrollBar_->setMaximum(0);
@@ -866,6 +1083,7 @@ bool ChannelView::hasSelection()
 
 void ChannelView::clearSelection()
 {
+    this->queueUpdate(this->selectionDamage(this->selection_, {}));
     this->selection_ = Selection();
     queueLayout();
 }
@@ -963,6 +1181,9 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
     this->channelConnections_.managedConnect(
         underlyingChannel->messagesAddedAtStart,
         [this](std::vector<MessagePtr> &messages) {
+            // These are older than the messages that are being refiltered
+            this->finishRefilter();
+
             std::vector<MessagePtr> filtered;
             std::copy_if(messages.begin(), messages.end(),
                          std::back_inserter(filtered), [this](const auto &msg) {
@@ -986,6 +1207,8 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
 
     this->channelConnections_.managedConnect(
         underlyingChannel->filledInMessages, [this](const auto &messages) {
+            this->finishRefilter();
+
             std::vector<MessagePtr> filtered;
             filtered.reserve(messages.size());
             std::copy_if(messages.begin(), messages.end(),
@@ -1103,6 +1326,11 @@ void ChannelView::setFilters(const QList<QUuid> &ids)
     this->channelFilters_ = std::make_shared<FilterSet>(ids);
 
     this->updateID();
+
+    if (this->underlyingChannel_)
+    {
+        this->refilterMessages();
+    }
 }
 
 QList<QUuid> ChannelView::getFilterIds() const
@@ -1137,6 +1365,103 @@ bool ChannelView::shouldIncludeMessage(const MessagePtr &m) const
     return true;
 }
 
+void ChannelView::refilterMessages()
+{
+    // The proxy keeps messages the underlying channel already evicted and
+    // the day change messages
+    std::vector<MessagePtr> shown;
+    if (this->refilter_)
+    {
+        shown = this->refilter_->messages.remainingShown();
+    }
+    for (const auto &message : this->channel_->getMessageSnapshot())
+    {
+        shown.push_back(message);
+    }
+
+    Refilter refilter{
+        .messages = MessageRefilter(
+            shown, this->underlyingChannel_->getMessageSnapshot(),
+            this->messages_.limit()),
+    };
+
+    // Messages passing the old and the new filters keep their layout
+    if (this->refilter_)
+    {
+        refilter.layouts = std::move(this->refilter_->layouts);
+    }
+    for (const auto &layout : this->messages_.getSnapshot())
+    {
+        refilter.layouts.emplace(layout->getMessagePtr().get(), layout);
+    }
+
+    this->channel_->clearMessages();
+    this->clearMessages();
+    this->refilter_ = std::move(refilter);
+
+    // Show the newest messages right away
+    this->refilterNextChunk();
+    if (auto last = this->messages_.last())
+    {
+        this->lastMessageHasAlternateBackground_ =
+            !(*last)->flags.has(MessageLayoutFlag::AlternateBackground);
+    }
+
+    if (this->refilter_)
+    {
+        this->refilterTimer_.start(0);
+    }
+}
+
+void ChannelView::refilterNextChunk()
+{
+    if (!this->refilter_)
+    {
+        this->refilterTimer_.stop();
+        return;
+    }
+
+    auto filtered =
+        this->refilter_->messages.nextChunk([this](const MessagePtr &message) {
+            return this->shouldIncludeMessage(message);
+        });
+
+    if (!filtered.empty())
+    {
+        this->channel_->addMessagesAtStart(filtered);
+    }
+
+    if (this->refilter_->messages.isDone())
+    {
+        this->refilter_.reset();
+        this->refilterTimer_.stop();
+    }
+}
+
+void ChannelView::finishRefilter()
+{
+    while (this->refilter_)
+    {
+        this->refilterNextChunk();
+    }
+}
+
+MessageLayoutPtr ChannelView::makeLayout(const MessagePtr &message)
+{
+    if (this->refilter_)
+    {
+        auto it = this->refilter_->layouts.find(message.get());
+        if (it != this->refilter_->layouts.end())
+        {
+            auto layout = std::move(it->second);
+            this->refilter_->layouts.erase(it);
+            return layout;
+        }
+    }
+
+    return std::make_shared<MessageLayout>(message);
+}
+
 ChannelPtr ChannelView::sourceChannel() const
 {
     return this->sourceChannel_;
@@ -1225,6 +1550,24 @@ void ChannelView::messageAppended(MessagePtr &message,
         this->scrollBar_->addHighlight(message->getScrollBarHighlight());
     }
 
+    if (this->isVisible())
+    {
+        // Measure the text of the message on the layout pool first, so laying
+        // it out on the GUI thread only has to look up the widths.
+        auto measuring = MessageLayout::measureAhead(
+            *message, this->getFlags(), this->scale(),
+            [self = QPointer<ChannelView>(this)] {
+                if (self)
+                {
+                    self->queueLayout();
+                }
+            });
+        if (measuring)
+        {
+            return;
+        }
+    }
+
     this->queueLayout();
 }
 
@@ -1237,13 +1580,11 @@ void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
     for (size_t i = 0; i < messages.size(); i++)
     {
         auto message = messages.at(i);
-        auto layout = std::make_shared<MessageLayout>(message);
+        auto layout = this->makeLayout(message);
 
         // alternate color
-        if (!this->lastMessageHasAlternateBackgroundReverse_)
-        {
-            layout->flags.set(MessageLayoutFlag::AlternateBackground);
-        }
+        layout->flags.set(MessageLayoutFlag::AlternateBackground,
+                          !this->lastMessageHasAlternateBackgroundReverse_);
         this->lastMessageHasAlternateBackgroundReverse_ =
             !this->lastMessageHasAlternateBackgroundReverse_;
 
@@ -1373,9 +1714,10 @@ void ChannelView::setSelection(const Selection &newSelection)
 {
     if (this->selection_ != newSelection)
     {
+        auto damage = this->selectionDamage(this->selection_, newSelection);
         this->selection_ = newSelection;
         this->selectionChanged.invoke();
-        this->update();
+        this->queueUpdate(damage);
     }
 }
 
@@ -1536,7 +1878,18 @@ void ChannelView::scrollToMessageLayout(MessageLayout *layout,
 
 void ChannelView::paintEvent(QPaintEvent *event)
 {
-    //    BenchmarkGuard benchmark("paint");
+    ProfileGuard profile(ProfileScope::Paint,
+                         Profiler::instance().isOverlayEnabled()
+                             ? &this->lastPaintNs_
+                             : nullptr);
+
+    // Laying out can scroll and resize children, which mustn't happen while
+    // we're painting. A layout that was deferred while the window was covered
+    // runs in the next frame, which repaints what changed.
+    if (this->layoutQueued_ && !this->layoutScheduled_)
+    {
+        this->queueLayout();
+    }
 
     QPainter painter(this);
 
@@ -1553,6 +1906,28 @@ void ChannelView::paintEvent(QPaintEvent *event)
         painter.fillRect(QRectF(5, a / 4, a / 4, a), brush);
         painter.fillRect(QRectF(15, a / 4, a / 4, a), brush);
     }
+
+    if (Profiler::instance().isOverlayEnabled())
+    {
+        this->drawProfilerOverlay(painter);
+    }
+}
+
+void ChannelView::drawProfilerOverlay(QPainter &painter)
+{
+    // The times are from the previous frame, since this frame isn't done yet
+    auto text = QString("layout %1 ms | paint %2 ms")
+                    .arg(double(this->lastLayoutNs_) / 1'000'000.0, 0, 'f', 2)
+                    .arg(double(this->lastPaintNs_) / 1'000'000.0, 0, 'f', 2);
+
+    painter.setFont(
+        getApp()->getFonts()->getFont(FontStyle::ChatSmall, this->scale()));
+    auto rect = painter.fontMetrics().boundingRect(text).adjusted(-4, -2, 4, 2);
+    rect.moveTopRight({this->width() - this->scrollBar_->width() - 4, 4});
+
+    painter.fillRect(rect, QColor(0, 0, 0, 180));
+    painter.setPen(Qt::white);
+    painter.drawText(rect, Qt::AlignCenter, text);
 }
 
 // if overlays is false then it draws the message, if true then it draws things
@@ -1570,6 +1945,9 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
 
     MessageLayout *end = nullptr;
 
+    this->bufferAtlas_.setGeometry(this->width(), this->height(),
+                                   this->devicePixelRatioF());
+
     MessagePaintContext ctx = {
         .painter = painter,
         .selection = this->selection_,
@@ -1581,6 +1959,7 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
         .isWindowFocused = this->window() == QApplication::activeWindow(),
         .isMentions = this->underlyingChannel_ ==
                       getApp()->getTwitch()->getMentionsChannel(),
+        .bufferAtlas = &this->bufferAtlas_,
 
         .y = int(-(messagesSnapshot[start]->getHeight() *
                    (fmod(this->scrollBar_->getRelativeCurrentValue(), 1)))),
@@ -1657,6 +2036,12 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
     {
         this->animationArea_ = animationArea;
     }
+    else if (!animationArea.isNull())
+    {
+        // Messages painted in a partial repaint (e.g. after scrolling) might
+        // have animated elements too.
+        this->animationArea_ = this->animationArea_.united(animationArea);
+    }
 #ifdef FOURTF
     else
     {
@@ -1684,9 +2069,10 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
     }
 
     // delete the message buffers that aren't on screen
+    // buffers in the atlas are kept until the atlas needs the space
     for (const std::shared_ptr<MessageLayout> &item : this->messagesOnScreen_)
     {
-        item->deleteBuffer();
+        item->releaseBuffer();
     }
 
     this->messagesOnScreen_.clear();
@@ -2212,7 +2598,7 @@ void ChannelView::mousePressEvent(QMouseEvent *event)
 void ChannelView::mouseReleaseEvent(QMouseEvent *event)
 {
     // find message
-    this->queueLayout();
+    this->performLayout();
 
     std::shared_ptr<MessageLayout> layout;
     QPoint relativePos;
@@ -2820,6 +3206,7 @@ void ChannelView::hideEvent(QHideEvent * /*event*/)
     }
 
     this->messagesOnScreen_.clear();
+    this->bufferAtlas_.clear();
 }
 
 void ChannelView::showUserInfoPopup(const QString &userName,
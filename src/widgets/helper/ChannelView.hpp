@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/FlagsEnum.hpp"
+#include "messages/layouts/MessageBufferAtlas.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/LimitedQueue.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
@@ -8,8 +9,10 @@
 #include "messages/Selection.hpp"
 #include "util/ThreadGuard.hpp"
 #include "widgets/BaseWidget.hpp"
+#include "widgets/helper/MessageRefilter.hpp"
 #include "widgets/TooltipWidget.hpp"
 
+#include <boost/unordered/unordered_flat_map.hpp>
 #include <pajlada/signals/signal.hpp>
 #include <QGestureEvent>
 #include <QMenu>
@@ -21,6 +24,7 @@
 #include <QWheelEvent>
 #include <QWidget>
 
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -98,7 +102,7 @@ public:
                          size_t messagesLimit = 1000);
 
     void queueUpdate();
-    void queueUpdate(const QRect &area);
+    void queueUpdate(const QRegion &area);
     Scrollbar &getScrollBar();
 
     QString getSelectedText();
@@ -262,6 +266,8 @@ protected:
                          QPoint &relativePos, int &index);
 
 private:
+    friend class FrameScheduler;
+
     struct InternalCtor {
     };
 
@@ -286,8 +292,19 @@ private:
         const LimitedQueueSnapshot<MessageLayoutPtr> &messages);
     void updateScrollbar(const LimitedQueueSnapshot<MessageLayoutPtr> &messages,
                          bool causedByScrollbar, bool causedByShow);
+    /// Repaints what changed on screen since the last layout
+    ///
+    /// If all messages that stay on screen only moved by the same offset,
+    /// the pixels of the view are scrolled and only the uncovered area is
+    /// painted. Otherwise, only the changed messages are repainted.
+    void queueDamage(const LimitedQueueSnapshot<MessageLayoutPtr> &messages);
+    /// Returns the area of the messages from @a first to @a last (inclusive)
+    /// that's currently on screen
+    QRegion messagesRegion(size_t first, size_t last);
+    QRegion selectionDamage(const Selection &before, const Selection &after);
 
     void drawMessages(QPainter &painter, const QRect &area);
+    void drawProfilerOverlay(QPainter &painter);
     void setSelection(const SelectionItem &start, const SelectionItem &end);
     void setSelection(const Selection &newSelection);
     void selectWholeMessage(MessageLayout *layout, int &messageIndex);
@@ -326,7 +343,11 @@ private:
     void updateID();
     ChannelViewID id_{};
 
+    /// Set if a layout is pending while we're not visible or our window is
+    /// covered
     bool layoutQueued_ = false;
+    /// Set if a layout is pending in the next frame of the FrameScheduler
+    bool layoutScheduled_ = false;
     bool bufferInvalidationQueued_ = false;
 
     bool lastMessageHasAlternateBackground_ = false;
@@ -336,6 +357,17 @@ private:
     /// If this is empty (QRect::isEmpty()), no animated element is shown.
     QRect animationArea_;
 
+    struct VisibleMessage {
+        MessageLayoutPtr layout;
+        int y = 0;
+        int height = 0;
+    };
+    /// The messages on screen as of the last layout
+    std::vector<VisibleMessage> visibleMessages_;
+    /// Messages that had to be laid out again since the last layout (their
+    /// buffer changed)
+    std::vector<const MessageLayout *> relaidMessages_;
+
     bool pausable_ = false;
     QTimer pauseTimer_;
     std::unordered_map<PauseReason, std::optional<SteadyClock::time_point>>
@@ -389,6 +421,27 @@ private:
     // Returns true if message should be included
     bool shouldIncludeMessage(const MessagePtr &message) const;
 
+    /// Applies the filters to the messages of the underlying channel again
+    ///
+    /// Messages only the proxy channel has are kept. The newest messages are checked right away, older ones are checked in
+    /// chunks in the following event loop iterations.
+    void refilterMessages();
+    /// Checks the next (older) chunk of messages while refiltering
+    void refilterNextChunk();
+    /// Checks all remaining messages while refiltering
+    void finishRefilter();
+    /// Returns the layout of @a message from before the filters changed, or a
+    /// new layout
+    MessageLayoutPtr makeLayout(const MessagePtr &message);
+
+    struct Refilter {
+        MessageRefilter messages;
+        /// Layouts from before the filters changed
+        boost::unordered_flat_map<const Message *, MessageLayoutPtr> layouts;
+    };
+    std::optional<Refilter> refilter_;
+    QTimer refilterTimer_;
+
     // Returns whether the scrollbar should have highlights
     bool showScrollbarHighlights() const;
 
@@ -441,6 +494,14 @@ private:
 
     std::unordered_set<std::shared_ptr<MessageLayout>> messagesOnScreen_;
 
+    /// Drawing buffers of the messages in this view
+    MessageBufferAtlas bufferAtlas_;
+
+    /// Duration of the last layout and paint, shown in the profiler overlay
+    /// (only measured while the overlay is enabled)
+    int64_t lastLayoutNs_ = 0;
+    int64_t lastPaintNs_ = 0;
+
     MessageColors messageColors_;
     MessagePreferences messagePreferences_;
 
@@ -1,10 +1,18 @@
 #include "widgets/helper/DebugPopup.hpp"
 
+#include "Application.hpp"
 #include "common/Literals.hpp"
+#include "common/QLogging.hpp"
+#include "debug/Profiler.hpp"
+#include "singletons/WindowManager.hpp"
 #include "util/Clipboard.hpp"
 #include "util/DebugCount.hpp"
 
+#include <QCheckBox>
+#include <QFile>
+#include <QFileDialog>
 #include <QFontDatabase>
+#include <QHBoxLayout>
 #include <QLabel>
 #include <QPushButton>
 #include <QTimer>
@@ -18,23 +26,77 @@ DebugPopup::DebugPopup()
 {
     auto *layout = new QVBoxLayout(this);
     auto *text = new QLabel(this);
+    auto *profilerText = new QLabel(this);
     auto *timer = new QTimer(this);
     auto *copyButton = new QPushButton(u"&Copy"_s);
 
-    QObject::connect(timer, &QTimer::timeout, [text] {
+    auto *recordTimings = new QCheckBox(u"&Record timings"_s);
+    auto *showOverlay = new QCheckBox(u"Show frame times in &splits"_s);
+    auto *resetButton = new QPushButton(u"&Reset timings"_s);
+    auto *exportButton = new QPushButton(u"&Export trace..."_s);
+
+    auto &profiler = Profiler::instance();
+    recordTimings->setChecked(profiler.isEnabled());
+    showOverlay->setChecked(profiler.isOverlayEnabled());
+
+    auto updateText = [text, profilerText] {
         text->setText(DebugCount::getDebugText());
-    });
+        profilerText->setText(Profiler::instance().getDebugText());
+    };
+    QObject::connect(timer, &QTimer::timeout, updateText);
     timer->start(300);
-    text->setText(DebugCount::getDebugText());
+    updateText();
 
     text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    profilerText->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    auto *profilerButtons = new QHBoxLayout;
+    profilerButtons->addWidget(recordTimings);
+    profilerButtons->addWidget(showOverlay);
+    profilerButtons->addStretch(1);
+    profilerButtons->addWidget(resetButton);
+    profilerButtons->addWidget(exportButton);
 
     layout->addWidget(text);
+    layout->addLayout(profilerButtons);
+    layout->addWidget(profilerText);
     layout->addWidget(copyButton, 1);
 
-    QObject::connect(copyButton, &QPushButton::clicked, this, [text] {
-        crossPlatformCopy(text->text());
+    QObject::connect(recordTimings, &QCheckBox::toggled, this,
+                     [](bool checked) {
+                         Profiler::instance().setEnabled(checked);
+                     });
+    QObject::connect(showOverlay, &QCheckBox::toggled, this, [](bool checked) {
+        Profiler::instance().setOverlayEnabled(checked);
+        getApp()->getWindows()->repaintVisibleChatWidgets();
     });
+    QObject::connect(resetButton, &QPushButton::clicked, this, [] {
+        Profiler::instance().reset();
+    });
+    QObject::connect(exportButton, &QPushButton::clicked, this, [this] {
+        auto path = QFileDialog::getSaveFileName(
+            this, u"Export trace"_s, u"chatterino-trace.json"_s,
+            u"Chrome trace (*.json)"_s);
+        if (path.isEmpty())
+        {
+            return;
+        }
+
+        QFile file(path);
+        if (!file.open(QFile::WriteOnly | QFile::Truncate))
+        {
+            qCWarning(chatterinoWidget)
+                << "Failed to open" << path << "to export the trace";
+            return;
+        }
+        file.write(Profiler::instance().toChromeTrace());
+    });
+
+    QObject::connect(copyButton, &QPushButton::clicked, this,
+                     [text, profilerText] {
+                         crossPlatformCopy(text->text() + '\n' +
+                                           profilerText->text());
+                     });
 }
 
 }  // namespace chatterino
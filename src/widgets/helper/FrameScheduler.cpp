@@ -0,0 +1,216 @@
+#include "widgets/helper/FrameScheduler.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "widgets/helper/ChannelView.hpp"
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWindow>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+constexpr qreal MIN_REFRESH_RATE = 30;
+constexpr qreal MAX_REFRESH_RATE = 240;
+constexpr qreal DEFAULT_REFRESH_RATE = 60;
+
+}  // namespace
+
+namespace chatterino {
+
+FrameScheduler::FrameScheduler()
+{
+    this->timer_.setSingleShot(true);
+    this->timer_.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&this->timer_, &QTimer::timeout, [this] {
+        this->runFrame();
+    });
+}
+
+void FrameScheduler::requestLayout(ChannelView *view)
+{
+    this->entryFor(view).layout = true;
+    this->schedule();
+}
+
+void FrameScheduler::requestUpdate(ChannelView *view)
+{
+    auto &entry = this->entryFor(view);
+    entry.fullUpdate = true;
+    entry.area = {};
+    this->schedule();
+}
+
+void FrameScheduler::requestUpdate(ChannelView *view, const QRegion &area)
+{
+    auto &entry = this->entryFor(view);
+    if (!entry.fullUpdate)
+    {
+        entry.area += area;
+    }
+    this->schedule();
+}
+
+void FrameScheduler::scrolled(ChannelView *view, int dy)
+{
+    for (auto *entries : {&this->frame_, &this->dirty_})
+    {
+        for (auto &entry : *entries)
+        {
+            if (entry.view == view)
+            {
+                entry.area.translate(0, dy);
+            }
+        }
+    }
+}
+
+int FrameScheduler::frameInterval() const
+{
+    qreal refreshRate = DEFAULT_REFRESH_RATE;
+    if (auto *screen = QGuiApplication::primaryScreen())
+    {
+        refreshRate = std::clamp(screen->refreshRate(), MIN_REFRESH_RATE,
+                                 MAX_REFRESH_RATE);
+    }
+
+    return std::max(1, static_cast<int>(std::floor(1000.0 / refreshRate)));
+}
+
+FrameScheduler::Entry &FrameScheduler::entryFor(ChannelView *view)
+{
+    assertInGuiThread();
+
+    auto it = std::find_if(this->dirty_.begin(), this->dirty_.end(),
+                           [view](const auto &entry) {
+                               return entry.view == view;
+                           });
+    if (it != this->dirty_.end())
+    {
+        return *it;
+    }
+
+    return this->dirty_.emplace_back(Entry{.view = view});
+}
+
+void FrameScheduler::schedule()
+{
+    if (this->timer_.isActive())
+    {
+        return;
+    }
+
+    // If we've been idle for at least a frame, the first request is handled
+    // right away (in the next event loop iteration), so single events don't
+    // get delayed. Everything arriving until then is part of that frame.
+    auto delay = 0;
+    if (this->sinceLastFrame_.isValid())
+    {
+        delay = std::max<int>(
+            0, this->frameInterval() -
+                   static_cast<int>(this->sinceLastFrame_.elapsed()));
+    }
+    this->timer_.start(delay);
+}
+
+void FrameScheduler::runFrame()
+{
+    this->sinceLastFrame_.start();
+
+    this->frame_ = std::exchange(this->dirty_, {});
+    auto &frame = this->frame_;
+
+    // Lay out all views first, layouts request updates themselves
+    for (auto &entry : frame)
+    {
+        if (!entry.view || !entry.layout || !entry.view->layoutScheduled_)
+        {
+            // Already laid out in the meantime (e.g. after scrolling)
+            continue;
+        }
+
+        if (!entry.view->isVisible() || isHidden(entry.view))
+        {
+            // Queued again on the next show or paint
+            entry.view->layoutScheduled_ = false;
+            entry.view->layoutQueued_ = true;
+            continue;
+        }
+
+        entry.view->performLayout();
+    }
+
+    // Merge the updates requested while laying out into this frame
+    for (auto &requested : std::exchange(this->dirty_, {}))
+    {
+        if (!requested.view)
+        {
+            continue;
+        }
+
+        if (requested.layout)
+        {
+            // Layouts requested by layouts are deferred to the next frame
+            this->dirty_.push_back(std::move(requested));
+            continue;
+        }
+
+        auto it = std::find_if(frame.begin(), frame.end(),
+                               [&](const auto &entry) {
+                                   return entry.view == requested.view;
+                               });
+        if (it == frame.end())
+        {
+            frame.push_back(std::move(requested));
+            continue;
+        }
+
+        it->fullUpdate |= requested.fullUpdate;
+        it->area += requested.area;
+    }
+
+    // Qt merges the updates of all views of a window into a single paint pass
+    for (const auto &entry : frame)
+    {
+        if (!entry.view || isHidden(entry.view))
+        {
+            // A hidden window gets a full repaint when it's exposed again
+            continue;
+        }
+
+        if (entry.fullUpdate)
+        {
+            entry.view->update();
+        }
+        else if (!entry.area.isEmpty())
+        {
+            entry.view->update(entry.area);
+        }
+    }
+
+    frame.clear();
+
+    if (!this->dirty_.empty())
+    {
+        this->schedule();
+    }
+}
+
+bool FrameScheduler::isHidden(const ChannelView *view)
+{
+    const auto *window = view->window();
+    if (window->isMinimized())
+    {
+        return true;
+    }
+
+    // A window that's fully covered by other windows isn't exposed (on
+    // platforms that support this)
+    const auto *handle = window->windowHandle();
+    return handle != nullptr && !handle->isExposed();
+}
+
+}  // namespace chatterino
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QRegion>
+#include <QTimer>
+
+#include <vector>
+
+namespace chatterino {
+
+class ChannelView;
+
+/// @brief Coalesces layouts and repaints of all ChannelViews into frames
+///
+/// Incoming messages, loaded images, the GIF timer and theme changes all ask
+/// views to lay out or repaint. Instead of doing that right away for every
+/// single event, views register themselves as dirty here. Once per display
+/// frame, all dirty views are laid out first and then repainted in one pass.
+///
+/// Views in minimized or fully covered windows are skipped. Their layout is
+/// deferred until they get shown or painted again. Views never lay out while
+/// they're being painted, since a layout can scroll the view.
+///
+/// The scheduler is owned by the WindowManager.
+class FrameScheduler
+{
+public:
+    FrameScheduler();
+
+    FrameScheduler(const FrameScheduler &) = delete;
+    FrameScheduler &operator=(const FrameScheduler &) = delete;
+
+    FrameScheduler(FrameScheduler &&) = delete;
+    FrameScheduler &operator=(FrameScheduler &&) = delete;
+
+    /// Lays out @a view in the next frame
+    void requestLayout(ChannelView *view);
+
+    /// Repaints all of @a view in the next frame
+    void requestUpdate(ChannelView *view);
+
+    /// Repaints @a area of @a view in the next frame
+    void requestUpdate(ChannelView *view, const QRegion &area);
+
+    /// Moves the pending repaints of @a view after its contents were scrolled
+    /// by @a dy pixels
+    void scrolled(ChannelView *view, int dy);
+
+    /// Returns the interval between two frames in milliseconds
+    int frameInterval() const;
+
+private:
+    struct Entry {
+        QPointer<ChannelView> view;
+        bool layout = false;
+        bool fullUpdate = false;
+        QRegion area;
+    };
+
+    Entry &entryFor(ChannelView *view);
+    void schedule();
+    void runFrame();
+
+    /// Returns true if nothing of @a view's window can be seen
+    static bool isHidden(const ChannelView *view);
+
+    std::vector<Entry> dirty_;
+    /// The entries of the frame that's currently running
+    std::vector<Entry> frame_;
+    QTimer timer_;
+    QElapsedTimer sinceLastFrame_;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,89 @@
+#include "widgets/helper/MessageRefilter.hpp"
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+namespace chatterino {
+
+MessageRefilter::MessageRefilter(
+    const std::vector<MessagePtr> &shown,
+    const LimitedQueueSnapshot<MessagePtr> &source, size_t limit)
+    : limit_(limit)
+{
+    boost::unordered_flat_map<const Message *, size_t> sourceIndices;
+    sourceIndices.reserve(source.size());
+    for (size_t i = 0; i < source.size(); i++)
+    {
+        sourceIndices.emplace(source[i].get(), i);
+    }
+
+    // The shown messages are in the same order as the source's, so
+    // merging them puts the proxy-only messages where they were shown
+    this->candidates_.reserve(shown.size() + source.size());
+    size_t nextSource = 0;
+    for (const auto &message : shown)
+    {
+        auto it = sourceIndices.find(message.get());
+        if (it == sourceIndices.end())
+        {
+            this->candidates_.push_back({.message = message, .check = false});
+            continue;
+        }
+
+        for (; nextSource <= it->second; nextSource++)
+        {
+            this->candidates_.push_back({.message = source[nextSource]});
+        }
+    }
+    for (; nextSource < source.size(); nextSource++)
+    {
+        this->candidates_.push_back({.message = source[nextSource]});
+    }
+
+    this->remaining_ = this->candidates_.size();
+}
+
+std::vector<MessagePtr> MessageRefilter::nextChunk(const Filter &filter)
+{
+    auto end = this->remaining_;
+    auto begin = end > CHUNK_SIZE ? end - CHUNK_SIZE : 0;
+    this->remaining_ = begin;
+
+    std::vector<MessagePtr> kept;
+    for (auto i = begin; i < end; i++)
+    {
+        const auto &candidate = this->candidates_[i];
+        if (!candidate.check || filter(candidate.message))
+        {
+            kept.push_back(candidate.message);
+        }
+    }
+
+    // Older messages wouldn't fit in anymore
+    this->kept_ += kept.size();
+    if (this->kept_ >= this->limit_)
+    {
+        this->remaining_ = 0;
+    }
+
+    return kept;
+}
+
+bool MessageRefilter::isDone() const
+{
+    return this->remaining_ == 0;
+}
+
+std::vector<MessagePtr> MessageRefilter::remainingShown() const
+{
+    std::vector<MessagePtr> shown;
+    for (size_t i = 0; i < this->remaining_; i++)
+    {
+        if (!this->candidates_[i].check)
+        {
+            shown.push_back(this->candidates_[i].message);
+        }
+    }
+    return shown;
+}
+
+}  // namespace chatterino
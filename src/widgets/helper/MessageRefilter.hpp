@@ -0,0 +1,69 @@
+#pragma once
+
+#include "messages/LimitedQueueSnapshot.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/// @brief Applies changed filters to the messages of a view in chunks
+///
+/// A view shows the messages of its underlying channel that passed its
+/// filters, kept in a proxy channel. The proxy also keeps messages the
+/// underlying channel already evicted, and the day change messages added by
+/// the view. These only exist in the proxy, so they're kept as they are.
+/// All messages the underlying channel still has are checked again.
+///
+/// Chunks are checked from newest to oldest, until all messages were checked
+/// or the view is full.
+class MessageRefilter
+{
+public:
+    /// Number of messages checked per chunk
+    static constexpr size_t CHUNK_SIZE = 500;
+
+    using Filter = std::function<bool(const MessagePtr &)>;
+
+    /// @param shown Messages of the proxy channel, oldest first
+    /// @param source Messages of the underlying channel
+    /// @param limit Number of messages the view can hold
+    MessageRefilter(const std::vector<MessagePtr> &shown,
+                    const LimitedQueueSnapshot<MessagePtr> &source,
+                    size_t limit);
+
+    /// Returns the messages of the next (older) chunk that are kept, oldest
+    /// first
+    std::vector<MessagePtr> nextChunk(const Filter &filter);
+
+    /// Returns true if no messages are left to check
+    bool isDone() const;
+
+    /// Returns the messages only the proxy had that weren't reached yet,
+    /// oldest first
+    ///
+    /// These have to be carried over if the filters change again before
+    /// this refilter is done.
+    std::vector<MessagePtr> remainingShown() const;
+
+private:
+    struct Candidate {
+        MessagePtr message;
+        /// False for messages that only exist in the proxy
+        bool check = true;
+    };
+
+    std::vector<Candidate> candidates_;
+    /// Candidates before this index still have to be checked
+    size_t remaining_ = 0;
+    /// Number of messages that were kept so far
+    size_t kept_ = 0;
+    size_t limit_;
+};
+
+}  // namespace chatterino
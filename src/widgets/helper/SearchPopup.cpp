@@ -2,66 +2,133 @@
 
 #include "Application.hpp"
 #include "common/Channel.hpp"
+#include "common/LinkParser.hpp"
 #include "controllers/filters/FilterSet.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/search/AuthorPredicate.hpp"
 #include "messages/search/BadgePredicate.hpp"
 #include "messages/search/ChannelPredicate.hpp"
 #include "messages/search/LinkPredicate.hpp"
 #include "messages/search/MessageFlagsPredicate.hpp"
+#include "messages/search/MessageSearchIndex.hpp"
 #include "messages/search/RegexPredicate.hpp"
 #include "messages/search/SubstringPredicate.hpp"
 #include "messages/search/SubtierPredicate.hpp"
+#include "singletons/helper/LogIndex.hpp"
+#include "singletons/helper/LoggingChannel.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/PostToThread.hpp"
 #include "widgets/helper/ChannelView.hpp"
 #include "widgets/splits/Split.hpp"
 
+#include <QCheckBox>
 #include <QHBoxLayout>
 #include <QLineEdit>
 #include <QPushButton>
+#include <QThreadPool>
 
-namespace chatterino {
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <span>
+
+namespace {
+
+/// Number of messages a worker checks before handing its results over
+constexpr size_t SEARCH_CHUNK_SIZE = 512;
+
+/// Maximum number of lines taken from the logs of each channel
+constexpr size_t LOG_RESULT_LIMIT = 1000;
 
-ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const LimitedQueueSnapshot<MessagePtr> &snapshot)
+using namespace chatterino;
+
+QThreadPool &searchPool()
 {
-    ChannelPtr channel(new Channel(channelName, Channel::Type::None));
+    return getApp()->getWindows()->getSearchPool();
+}
 
-    // Parse predicates from tags in "text"
-    auto predicates = parsePredicates(text);
+/// Makes a message from a line found in the logs. The line is formatted as
+/// written by LoggingChannel, e.g. "#channel localized login: text".
+MessagePtr makeLogMessage(const LogSearchResult &result)
+{
+    MessageBuilder builder;
+    builder.emplace<TimestampElement>(result.time.time());
+    builder.emplace<TextElement>(result.time.date().toString(Qt::ISODate),
+                                 MessageElementFlag::Text,
+                                 MessageColor::System);
 
-    // Check for every message whether it fulfills all predicates that have
-    // been registered
-    for (size_t i = 0; i < snapshot.size(); ++i)
+    for (const auto &word : result.text.split(' ', Qt::SkipEmptyParts))
     {
-        MessagePtr message = snapshot[i];
-
-        bool accept = true;
-        for (const auto &pred : predicates)
+        auto link = linkparser::parse(word);
+        if (link)
         {
-            // Discard the message as soon as one predicate fails
-            if (!pred->appliesTo(*message))
-            {
-                accept = false;
-                break;
-            }
+            builder.addLink(*link, word);
+            continue;
         }
 
-        // If all predicates match, add the message to the channel
-        if (accept)
-        {
-            auto overrideFlags = std::optional<MessageFlags>(message->flags);
-            overrideFlags->set(MessageFlag::DoNotLog);
+        builder.appendOrEmplaceText(word, MessageColor::Text);
+    }
 
-            channel->addMessage(message, MessageContext::Repost, overrideFlags);
-        }
+    QStringView text(result.text);
+    auto space = text.indexOf(u' ');
+    if (text.startsWith(u'#') && space > 0)
+    {
+        builder->channelName = text.mid(1, space - 1).toString();
+        text = text.mid(space + 1);
+    }
+
+    // Lines of chatters start with their (localized and) login name
+    auto colon = text.indexOf(u": ");
+    auto author = colon < 0 ? QStringView() : text.left(colon);
+    if (!author.isEmpty() && author.indexOf(u' ') == author.lastIndexOf(u' '))
+    {
+        auto login = author.mid(author.lastIndexOf(u' ') + 1);
+        builder->loginName = login.toString();
+        builder->displayName = builder->loginName;
+        builder->messageText = text.mid(colon + 2).toString();
+    }
+    else
+    {
+        builder->messageText = text.toString();
     }
 
-    return channel;
+    builder->searchText = result.text;
+    builder->serverReceivedTime = result.time;
+    builder->flags.set(MessageFlag::DoNotLog);
+
+    return builder.release();
 }
 
+}  // namespace
+
+namespace chatterino {
+
+struct SearchPopup::SearchJob {
+    /// Predicates that read mutable parts of messages, checked in the GUI
+    /// thread when results are delivered
+    std::vector<std::unique_ptr<MessagePredicate>> guiPredicates;
+    /// The messages to check, newest first, so the newest results are
+    /// delivered first
+    std::vector<MessagePtr> candidates;
+    size_t chunkCount = 0;
+
+    CancellationToken token;
+    std::atomic<size_t> nextChunk{0};
+
+    std::mutex mutex;
+    /// The results of each finished chunk, by chunk index (guarded by mutex)
+    std::vector<std::optional<std::vector<MessagePtr>>> results;
+
+    /// The next chunk to add to the result channel (only used in the GUI
+    /// thread)
+    size_t nextDelivered = 0;
+};
+
 SearchPopup::SearchPopup(QWidget *parent, Split *split)
     : BasePopup(
           {
@@ -82,6 +149,8 @@ SearchPopup::SearchPopup(QWidget *parent, Split *split)
     this->addShortcuts();
 }
 
+SearchPopup::~SearchPopup() = default;
+
 void SearchPopup::addShortcuts()
 {
     HotkeyController::HotkeyMap actions{
@@ -214,69 +283,307 @@ bool SearchPopup::eventFilter(QObject *object, QEvent *event)
 
 void SearchPopup::search()
 {
-    if (this->snapshot_.size() == 0)
+    auto predicates = parsePredicates(this->searchInput_->text());
+
+    QStringList terms;
+    for (const auto &predicate : predicates)
     {
-        this->snapshot_ = this->buildSnapshot();
+        auto text = predicate->requiredText();
+        if (!text.isEmpty())
+        {
+            terms.append(text);
+        }
+    }
+
+    this->resultChannel_ =
+        std::make_shared<Channel>(this->channelName_, Channel::Type::None);
+    this->channelView_->setChannel(this->resultChannel_);
+
+    if (this->searchLogs_->isChecked())
+    {
+        this->searchLogs(std::move(predicates), terms);
+        return;
     }
 
-    this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_));
+    auto job = std::make_shared<SearchJob>();
+    for (auto &predicate : predicates)
+    {
+        if (predicate->readsMutableFields())
+        {
+            job->guiPredicates.push_back(std::move(predicate));
+        }
+    }
+    job->candidates = this->collectCandidates(terms);
+    std::reverse(job->candidates.begin(), job->candidates.end());
+    job->chunkCount =
+        (job->candidates.size() + SEARCH_CHUNK_SIZE - 1) / SEARCH_CHUNK_SIZE;
+    job->results.resize(job->chunkCount);
+    job->token = CancellationToken(false);
+
+    // A new search replaces the one that's still running
+    this->searchToken_ = job->token;
+
+    auto workers = std::min<size_t>(
+        job->chunkCount,
+        static_cast<size_t>(std::max(1, searchPool().maxThreadCount())));
+    for (size_t i = 0; i < workers; i++)
+    {
+        // Predicates aren't thread-safe, so every worker gets its own
+        auto workerPredicates =
+            std::make_shared<std::vector<std::unique_ptr<MessagePredicate>>>(
+                parsePredicates(this->searchInput_->text()));
+        std::erase_if(*workerPredicates, [](const auto &predicate) {
+            return predicate->readsMutableFields();
+        });
+
+        searchPool().start([this, job, workerPredicates]() mutable {
+            runSearchWorker(this, std::move(job), *workerPredicates);
+        });
+    }
 }
 
-LimitedQueueSnapshot<MessagePtr> SearchPopup::buildSnapshot()
+void SearchPopup::runSearchWorker(
+    SearchPopup *popup, std::shared_ptr<SearchJob> job,
+    const std::vector<std::unique_ptr<MessagePredicate>> &predicates)
 {
-    // no point in filtering/sorting if it's a single channel search
-    if (this->searchChannels_.length() == 1)
+    while (!job->token.isCancelled())
     {
-        const auto channelPtr = this->searchChannels_.at(0);
-        return channelPtr.get().channel()->getMessageSnapshot();
+        auto chunk = job->nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= job->chunkCount)
+        {
+            break;
+        }
+
+        auto begin = chunk * SEARCH_CHUNK_SIZE;
+        auto end = std::min(begin + SEARCH_CHUNK_SIZE, job->candidates.size());
+
+        // Each predicate only checks the messages all previous ones accepted
+        std::span<const MessagePtr> messages(job->candidates.data() + begin,
+                                             end - begin);
+        MessageMask mask(messages.size());
+        for (const auto &predicate : predicates)
+        {
+            if (mask.none())
+            {
+                break;
+            }
+            predicate->filter(messages, mask);
+        }
+
+        std::vector<MessagePtr> results;
+        mask.forEachSet([&](size_t i) {
+            results.push_back(messages[i]);
+        });
+
+        {
+            std::lock_guard lock(job->mutex);
+            job->results[chunk] = std::move(results);
+        }
+
+        postToThread([popup, job] {
+            // The token is cancelled before the popup is destroyed
+            if (!job->token.isCancelled())
+            {
+                popup->deliverResults(*job);
+            }
+        });
     }
 
-    auto combinedSnapshot = std::vector<std::shared_ptr<const Message>>{};
+    // Make sure the job (and the messages it holds) is destroyed in the GUI
+    // thread
+    postToThread([job = std::move(job)] {});
+}
+
+void SearchPopup::deliverResults(SearchJob &job)
+{
+    std::vector<MessagePtr> results;
+    {
+        std::lock_guard lock(job.mutex);
+        while (job.nextDelivered < job.chunkCount &&
+               job.results[job.nextDelivered].has_value())
+        {
+            auto &chunk = *job.results[job.nextDelivered];
+            results.insert(results.end(),
+                           std::make_move_iterator(chunk.begin()),
+                           std::make_move_iterator(chunk.end()));
+            job.results[job.nextDelivered].reset();
+            job.nextDelivered++;
+        }
+    }
+
+    if (!job.guiPredicates.empty())
+    {
+        MessageMask mask(results.size());
+        for (const auto &predicate : job.guiPredicates)
+        {
+            predicate->filter(results, mask);
+        }
+
+        std::vector<MessagePtr> accepted;
+        mask.forEachSet([&](size_t i) {
+            accepted.push_back(std::move(results[i]));
+        });
+        results = std::move(accepted);
+    }
+
+    if (results.empty())
+    {
+        return;
+    }
+
+    // The results were collected newest first
+    std::reverse(results.begin(), results.end());
+    this->resultChannel_->addMessagesAtStart(results);
+}
+
+void SearchPopup::searchLogs(
+    std::vector<std::unique_ptr<MessagePredicate>> predicates,
+    const QStringList &terms)
+{
+    auto token = CancellationToken(false);
+    this->searchToken_ = token;
+
+    if (terms.isEmpty())
+    {
+        this->resultChannel_->addMessage(
+            makeSystemMessage("Type a word to search the logs"),
+            MessageContext::Repost);
+        return;
+    }
+
+    std::vector<std::shared_ptr<LogIndex>> indices;
+    for (const auto &view : this->searchChannels_)
+    {
+        auto channel = view.get().channel();
+        auto index = LogIndex::forDirectory(LoggingChannel::directoryFor(
+            channel->getName(), channel->getPlatform()));
+        if (std::find(indices.begin(), indices.end(), index) == indices.end())
+        {
+            indices.push_back(std::move(index));
+        }
+    }
+    this->logIndices_ = indices;
+
+    auto sharedPredicates =
+        std::make_shared<std::vector<std::unique_ptr<MessagePredicate>>>(
+            std::move(predicates));
+    searchPool().start([this, indices, terms, token, sharedPredicates] {
+        std::vector<LogSearchResult> results;
+        for (const auto &index : indices)
+        {
+            index->update(token);
+
+            auto found = index->search(terms, LOG_RESULT_LIMIT, token);
+            results.insert(results.end(), std::make_move_iterator(found.begin()),
+                           std::make_move_iterator(found.end()));
+        }
+
+        postToThread([this, token, sharedPredicates,
+                      results = std::move(results)]() mutable {
+            // The token is cancelled before the popup is destroyed
+            if (!token.isCancelled())
+            {
+                this->deliverLogResults(std::move(results), *sharedPredicates);
+            }
+        });
+    });
+}
+
+void SearchPopup::deliverLogResults(
+    std::vector<LogSearchResult> results,
+    const std::vector<std::unique_ptr<MessagePredicate>> &predicates)
+{
+    std::sort(results.begin(), results.end(), [](const auto &a, const auto &b) {
+        return a.time < b.time;
+    });
+
+    std::vector<MessagePtr> found;
+    found.reserve(results.size());
+    for (const auto &result : results)
+    {
+        found.push_back(makeLogMessage(result));
+    }
+
+    MessageMask mask(found.size());
+    for (const auto &predicate : predicates)
+    {
+        predicate->filter(found, mask);
+    }
+
+    std::vector<MessagePtr> messages;
+    mask.forEachSet([&](size_t i) {
+        messages.push_back(std::move(found[i]));
+    });
+
+    if (messages.empty())
+    {
+        this->resultChannel_->addMessage(
+            makeSystemMessage("No matching messages found in the logs"),
+            MessageContext::Repost);
+        return;
+    }
+
+    this->resultChannel_->addMessagesAtStart(messages);
+}
+
+std::vector<MessagePtr> SearchPopup::collectCandidates(const QStringList &terms)
+{
+    // no point in filtering/sorting if it's a single channel search
+    const bool isMultiChannel = this->searchChannels_.length() > 1;
+
+    std::vector<MessagePtr> candidates;
     for (auto &channel : this->searchChannels_)
     {
         ChannelView &sharedView = channel.get();
+        auto sourceChannel = sharedView.channel();
 
-        const FilterSetPtr filterSet = sharedView.getFilterSet();
-        const LimitedQueueSnapshot<MessagePtr> &snapshot =
-            sharedView.channel()->getMessageSnapshot();
+        const auto indexed = sourceChannel->searchIndex().candidates(terms);
+        const FilterSetPtr filterSet =
+            isMultiChannel ? sharedView.getFilterSet() : nullptr;
 
-        for (const auto &message : snapshot)
+        for (const auto &message : sourceChannel->getMessageSnapshot())
         {
-            if (filterSet && !filterSet->filter(message, sharedView.channel()))
+            if (indexed && !indexed->contains(message.get()))
+            {
+                continue;
+            }
+
+            if (filterSet && !filterSet->filter(message, sourceChannel))
             {
                 continue;
             }
 
-            combinedSnapshot.push_back(message);
+            candidates.push_back(message);
         }
     }
 
+    if (!isMultiChannel)
+    {
+        return candidates;
+    }
+
     // remove any duplicate messages from splits containing the same channel
-    std::sort(combinedSnapshot.begin(), combinedSnapshot.end(),
+    std::sort(candidates.begin(), candidates.end(),
               [](MessagePtr &a, MessagePtr &b) {
                   return a->id > b->id;
               });
 
     auto uniqueIterator =
-        std::unique(combinedSnapshot.begin(), combinedSnapshot.end(),
+        std::unique(candidates.begin(), candidates.end(),
                     [](MessagePtr &a, MessagePtr &b) {
                         // nullptr check prevents system messages from being dropped
                         return (a->id != nullptr) && a->id == b->id;
                     });
 
-    combinedSnapshot.erase(uniqueIterator, combinedSnapshot.end());
+    candidates.erase(uniqueIterator, candidates.end());
 
     // resort by time for presentation
-    std::sort(combinedSnapshot.begin(), combinedSnapshot.end(),
+    std::sort(candidates.begin(), candidates.end(),
               [](MessagePtr &a, MessagePtr &b) {
                   return a->serverReceivedTime < b->serverReceivedTime;
               });
 
-    auto queue = LimitedQueue<MessagePtr>(combinedSnapshot.size());
-    queue.pushFront(combinedSnapshot);
-
-    return queue.getSnapshot();
+    return candidates;
 }
 
 void SearchPopup::initLayout()
@@ -307,6 +614,18 @@ void SearchPopup::initLayout()
                 this->searchInput_->installEventFilter(this);
             }
 
+            // SEARCH LOGS
+            {
+                this->searchLogs_ = new QCheckBox("&Logs", this);
+                this->searchLogs_->setToolTip(
+                    "Search the chat logs on disk instead of the messages in "
+                    "the splits");
+                layout2->addWidget(this->searchLogs_);
+
+                QObject::connect(this->searchLogs_, &QCheckBox::toggled, this,
+                                 &SearchPopup::search);
+            }
+
             layout1->addLayout(layout2);
         }
 
@@ -1,22 +1,29 @@
 #pragma once
 
 #include "ForwardDecl.hpp"
-#include "messages/LimitedQueueSnapshot.hpp"
+#include "util/CancellationToken.hpp"
 #include "widgets/BasePopup.hpp"
 
+#include <QStringList>
+
 #include <memory>
+#include <vector>
 
+class QCheckBox;
 class QLineEdit;
 
 namespace chatterino {
 
 class Split;
 class MessagePredicate;
+class LogIndex;
+struct LogSearchResult;
 
 class SearchPopup : public BasePopup
 {
 public:
     SearchPopup(QWidget *parent, Split *split = nullptr);
+    ~SearchPopup() override;
 
     virtual void addChannel(ChannelView &channel);
     void goToMessage(const MessagePtr &message);
@@ -37,22 +44,58 @@ private:
     void initLayout();
     void search();
     void addShortcuts() override;
-    LimitedQueueSnapshot<MessagePtr> buildSnapshot();
 
     /**
-     * @brief Only retains those message from a list of messages that satisfy a
-     *        search query.
+     * @brief Collects the messages of all searched channels that might
+     *        contain all @a terms.
+     *
+     * The channels' MessageSearchIndex is used to skip messages that can't
+     * match. When searching multiple channels, their filters are applied and
+     * duplicates are removed.
+     *
+     * @param terms texts that every result has to contain
+     * @return the candidates, oldest first
+     */
+    std::vector<MessagePtr> collectCandidates(const QStringList &terms);
+
+    struct SearchJob;
+
+    /**
+     * @brief Checks chunks of the candidates of @a job until all are checked
+     *        or the job is cancelled.
      *
-     * @param text          the search query -- will be parsed for MessagePredicates
-     * @param channelName   name of the channel to be returned
-     * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
+     * This runs on the search thread pool. Results are handed to the GUI
+     * thread after every chunk.
      *
-     * @return a ChannelPtr with "channelName" and the filtered messages from
-     *         "snapshot"
+     * @param predicates only used by this worker, none of them reads mutable
+     *                   parts of messages
      */
-    static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const LimitedQueueSnapshot<MessagePtr> &snapshot);
+    static void runSearchWorker(
+        SearchPopup *popup, std::shared_ptr<SearchJob> job,
+        const std::vector<std::unique_ptr<MessagePredicate>> &predicates);
+
+    /// Adds the results of all chunks of @a job that are done (and are next
+    /// in order) to the result channel
+    void deliverResults(SearchJob &job);
+
+    /**
+     * @brief Searches the logs of all searched channels on disk.
+     *
+     * The logs are indexed by their LogIndex on the search thread pool first
+     * if anything was logged since the last search.
+     *
+     * @param predicates checked on the messages made from the matching lines
+     * @param terms texts that every result has to contain, at least one is
+     *              needed to look lines up in the index
+     */
+    void searchLogs(std::vector<std::unique_ptr<MessagePredicate>> predicates,
+                    const QStringList &terms);
+
+    /// Adds the lines found by #searchLogs that satisfy @a predicates to the
+    /// result channel
+    void deliverLogResults(
+        std::vector<LogSearchResult> results,
+        const std::vector<std::unique_ptr<MessagePredicate>> &predicates);
 
     /**
      * @brief Checks the input for tags and registers their corresponding
@@ -64,8 +107,17 @@ private:
     static std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
         const QString &input);
 
-    LimitedQueueSnapshot<MessagePtr> snapshot_;
+    /// The channel the results of the current search are added to
+    ChannelPtr resultChannel_;
+    /// Cancels the current search when it's replaced by a new one (or the
+    /// popup is closed)
+    ScopedCancellationToken searchToken_;
+    /// The indices of the logs searched last, they keep the loaded segments
+    /// in memory while the popup is open
+    std::vector<std::shared_ptr<LogIndex>> logIndices_;
+
     QLineEdit *searchInput_{};
+    QCheckBox *searchLogs_{};
     ChannelView *channelView_{};
     QString channelName_{};
     Split *split_ = nullptr;
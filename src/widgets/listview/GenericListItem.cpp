@@ -19,4 +19,9 @@ GenericListItem::GenericListItem(const QIcon &icon)
 {
 }
 
+bool GenericListItem::isSameAs(const GenericListItem & /*other*/) const
+{
+    return false;
+}
+
 }  // namespace chatterino
@@ -38,6 +38,12 @@ public:
     virtual void paint(QPainter *painter, const QRect &rect) const = 0;
     virtual QSize sizeHint(const QRect &rect) const = 0;
 
+    /**
+     * @brief   Returns true if this item shows and does the same as @a other,
+     *          so it doesn't need to be replaced when a list is updated.
+     */
+    virtual bool isSameAs(const GenericListItem &other) const;
+
 protected:
     QIcon icon_;
     static const QSize ICON_SIZE;
@@ -1,5 +1,9 @@
 #include "widgets/listview/GenericListModel.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
 namespace chatterino {
 
 GenericListModel::GenericListModel(QObject *parent)
@@ -54,6 +58,61 @@ void GenericListModel::clear()
     this->endRemoveRows();
 }
 
+void GenericListModel::replaceItems(GenericListModel &other)
+{
+    other.beginResetModel();
+    auto newItems = std::exchange(other.items_, {});
+    other.endResetModel();
+
+    auto &oldItems = this->items_;
+
+    auto isSame = [](const auto &a, const auto &b) {
+        return a->isSameAs(*b);
+    };
+
+    // Rows in [prefix, oldItems.size() - suffix) are replaced by rows in
+    // [prefix, newItems.size() - suffix)
+    auto common = std::min(oldItems.size(), newItems.size());
+    size_t prefix = 0;
+    while (prefix < common && isSame(oldItems[prefix], newItems[prefix]))
+    {
+        prefix++;
+    }
+    size_t suffix = 0;
+    while (suffix < common - prefix &&
+           isSame(oldItems[oldItems.size() - 1 - suffix],
+                  newItems[newItems.size() - 1 - suffix]))
+    {
+        suffix++;
+    }
+
+    auto removed = oldItems.size() - prefix - suffix;
+    auto inserted = newItems.size() - prefix - suffix;
+
+    if (removed > 0)
+    {
+        this->beginRemoveRows(QModelIndex(), static_cast<int>(prefix),
+                              static_cast<int>(prefix + removed - 1));
+        oldItems.erase(oldItems.begin() + static_cast<ptrdiff_t>(prefix),
+                       oldItems.begin() +
+                           static_cast<ptrdiff_t>(prefix + removed));
+        this->endRemoveRows();
+    }
+
+    if (inserted > 0)
+    {
+        this->beginInsertRows(QModelIndex(), static_cast<int>(prefix),
+                              static_cast<int>(prefix + inserted - 1));
+        oldItems.insert(
+            oldItems.begin() + static_cast<ptrdiff_t>(prefix),
+            std::make_move_iterator(newItems.begin() +
+                                    static_cast<ptrdiff_t>(prefix)),
+            std::make_move_iterator(newItems.begin() +
+                                    static_cast<ptrdiff_t>(prefix + inserted)));
+        this->endInsertRows();
+    }
+}
+
 void GenericListModel::reserve(size_t capacity)
 {
     this->items_.reserve(capacity);
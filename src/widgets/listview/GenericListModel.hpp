@@ -51,6 +51,16 @@ public:
      */
     void clear();
 
+    /**
+     * @brief   Replaces the items of this model with the items of @a other,
+     *          which is left empty. Attached views are only notified about
+     *          the rows that changed: items at the start and the end that are
+     *          the same (see GenericListItem::isSameAs) are kept.
+     *
+     * @param   other   model to take the items from
+     */
+    void replaceItems(GenericListModel &other);
+
     /**
      * @brief   Increases the capacity of the list model.
      */
@@ -70,6 +70,10 @@ void DankerinoPage::initLayout(GeneralPageView &layout)
     layout.addIntInput(
         "Low rate limit spam delay in milliseconds (non mod/vip)",
         s.twitchLowRateLimitDelay, 500, 3000, 1100);
+    layout.addIntInput("Read connections", s.twitchReadConnections, 1, 16, 1,
+                       "Joined channels are spread across this many "
+                       "connections, so a slow or lost connection only "
+                       "affects some of them. Applies when reconnecting.");
     if (s.dankerinoThreeLetterApiEasterEgg)
     {
         layout.addCheckbox("Click to disable GraphQL easter egg and "
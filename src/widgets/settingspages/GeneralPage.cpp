@@ -1270,6 +1270,10 @@ void GeneralPage::initLayout(GeneralPageView &layout)
         s.userCompletionOnlyWithAt, false,
         "When enabled, username tab-completion will only complete when using @"
         "\ne.g. pajl -> pajl | @pajl -> @pajlada");
+    layout.addIntInput(
+        "Usernames to remember for autocompletion per channel (requires "
+        "restart)",
+        s.chatterCompletionLimit, 100, 50000, 100);
 
     layout.addCheckbox("Show Twitch whispers inline", s.inlineWhispers, false,
                        "Show whispers as messages in all splits instead "
@@ -1295,6 +1299,8 @@ void GeneralPage::initLayout(GeneralPageView &layout)
                        s.scrollbackSplitLimit, 100, 100000, 100);
     layout.addIntInput("Usercard scrollback limit (requires restart)",
                        s.scrollbackUsercardLimit, 100, 100000, 100);
+    layout.addIntInput("Message drawing cache size per split (MiB)",
+                       s.messageBufferCacheSize, 8, 1024, 8);
 
     SettingWidget::dropdown("Show blocked term automod messages",
                             s.showBlockedTermAutomodMessages)
@@ -80,4 +80,11 @@ QSize InputCompletionItem::sizeHint(const QRect &rect) const
     return QSize(rect.width(), ICON_SIZE.height());
 }
 
+bool InputCompletionItem::isSameAs(const GenericListItem &other) const
+{
+    const auto *item = dynamic_cast<const InputCompletionItem *>(&other);
+    return item != nullptr && item->emote_ == this->emote_ &&
+           item->text_ == this->text_;
+}
+
 }  // namespace chatterino
@@ -22,6 +22,7 @@ public:
     void action() override;
     void paint(QPainter *painter, const QRect &rect) const override;
     QSize sizeHint(const QRect &rect) const override;
+    bool isSameAs(const GenericListItem &other) const override;
 
 private:
     EmotePtr emote_;
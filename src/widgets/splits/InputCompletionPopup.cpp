@@ -27,6 +27,14 @@ InputCompletionPopup::InputCompletionPopup(QWidget *parent)
         }
     });
     this->redrawTimer_.setInterval(33);
+
+    std::ignore = this->model_.resultsUpdated.connect([this] {
+        // Move selection to top row
+        if (this->model_.rowCount() != 0)
+        {
+            this->ui_.listView->setCurrentIndex(this->model_.index(0));
+        }
+    });
 }
 
 void InputCompletionPopup::updateCompletion(const QString &text,
@@ -41,12 +49,6 @@ void InputCompletionPopup::updateCompletion(const QString &text,
 
     assert(this->model_.hasSource());
     this->model_.updateResults(text, MAX_ENTRY_COUNT);
-
-    // Move selection to top row
-    if (this->model_.rowCount() != 0)
-    {
-        this->ui_.listView->setCurrentIndex(this->model_.index(0));
-    }
 }
 
 std::unique_ptr<completion::Source> InputCompletionPopup::getSource() const
@@ -88,7 +90,7 @@ void InputCompletionPopup::beginCompletion(CompletionKind kind,
 {
     this->currentKind_ = kind;
     this->currentChannel_ = std::move(channel);
-    this->model_.setSource(this->getSource());
+    this->model_.setSource(this->getSource(), this->currentChannel_);
 }
 
 void InputCompletionPopup::endCompletion()
@@ -96,6 +98,7 @@ void InputCompletionPopup::endCompletion()
     this->currentKind_ = std::nullopt;
     this->currentChannel_ = nullptr;
     this->model_.setSource(nullptr);
+    this->model_.clear();
 }
 
 void InputCompletionPopup::setInputAction(ActionCallback callback)
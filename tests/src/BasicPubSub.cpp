@@ -146,3 +146,32 @@ TEST(BasicPubSub, SubscriptionCycle)
     ASSERT_EQ(manager.diag.connectionsFailed, 0);
     ASSERT_EQ(manager.messagesReceived, 2);
 }
+
+TEST(BasicPubSub, PendingChanges)
+{
+    const QString host("wss://127.0.0.1:9050/liveupdates/sub-unsub");
+    MyManager manager(host);
+    manager.start();
+
+    // All of these happen before the connection is open
+    manager.sub({1, "foo"});
+    manager.sub({1, "foo"});
+    manager.sub({2, "bar"});
+    manager.unsub({2, "bar"});
+    std::this_thread::sleep_for(500ms);
+
+    ASSERT_EQ(manager.diag.connectionsOpened, 1);
+    ASSERT_EQ(manager.diag.connectionsClosed, 0);
+    ASSERT_EQ(manager.diag.connectionsFailed, 0);
+
+    // Only the subscription that's still wanted is sent, and only once
+    ASSERT_EQ(manager.messagesReceived, 1);
+    ASSERT_EQ(manager.popMessage(), QString("ack-sub-1-foo"));
+
+    manager.stop();
+
+    ASSERT_EQ(manager.diag.connectionsOpened, 1);
+    ASSERT_EQ(manager.diag.connectionsClosed, 1);
+    ASSERT_EQ(manager.diag.connectionsFailed, 0);
+    ASSERT_EQ(manager.messagesReceived, 1);
+}
@@ -4,6 +4,8 @@
 
 #include <QStringList>
 
+#include <algorithm>
+
 using namespace chatterino;
 
 TEST(ChatterSet, insert)
@@ -85,3 +87,98 @@ TEST(ChatterSet, MaxSizeLastUsed)
     EXPECT_TRUE(set.contains("pajlada"));
     EXPECT_TRUE(set.contains("Pajlada"));
 }
+
+TEST(ChatterSet, FilterByPrefix)
+{
+    ChatterSet set;
+
+    set.addRecentChatter("pajlada");
+    set.addRecentChatter("Forsen");
+    set.addRecentChatter("pajbot");
+    set.addRecentChatter("Paj");
+
+    // most recent chatters first
+    EXPECT_EQ(set.filterByPrefix("paj"),
+              (std::vector<QString>{"Paj", "pajbot", "pajlada"}));
+    EXPECT_EQ(set.filterByPrefix("PAJL"), (std::vector<QString>{"pajlada"}));
+    EXPECT_EQ(set.filterByPrefix("forsen"), (std::vector<QString>{"Forsen"}));
+    EXPECT_TRUE(set.filterByPrefix("x").empty());
+    EXPECT_EQ(set.filterByPrefix("").size(), 4);
+
+    set.addRecentChatter("PAJLADA");
+    EXPECT_EQ(set.filterByPrefix("paj"),
+              (std::vector<QString>{"PAJLADA", "Paj", "pajbot"}));
+
+    EXPECT_EQ(set.findByPrefix("pajb"),
+              (std::vector<std::pair<QString, QString>>{{"pajbot", "pajbot"}}));
+}
+
+TEST(ChatterSet, FilterByPrefixEviction)
+{
+    ChatterSet set(3);
+    EXPECT_EQ(set.limit(), 3);
+
+    set.addRecentChatter("user1");
+    set.addRecentChatter("user2");
+    set.addRecentChatter("user3");
+    set.addRecentChatter("user1");
+    set.addRecentChatter("user4");
+
+    EXPECT_FALSE(set.contains("user2"));
+    EXPECT_EQ(set.filterByPrefix("user"),
+              (std::vector<QString>{"user4", "user1", "user3"}));
+
+    set.updateOnlineChatters({"user1", "user5"});
+    EXPECT_FALSE(set.contains("user3"));
+    EXPECT_FALSE(set.contains("user4"));
+    EXPECT_TRUE(set.contains("user5"));
+
+    auto online = set.filterByPrefix("user");
+    std::sort(online.begin(), online.end());
+    EXPECT_EQ(online, (std::vector<QString>{"user1", "user5"}));
+}
+
+TEST(ChatterSet, Limit)
+{
+    EXPECT_EQ(ChatterSet().limit(), ChatterSet::CHATTER_LIMIT);
+    EXPECT_EQ(ChatterSet(0).limit(), 1);
+    EXPECT_EQ(ChatterSet(1'000'000).limit(), ChatterSet::MAX_CHATTER_LIMIT);
+
+    ChatterSet set(ChatterSet::MAX_CHATTER_LIMIT);
+    for (size_t i = 0; i < ChatterSet::MAX_CHATTER_LIMIT + 1; ++i)
+    {
+        set.addRecentChatter(QString("user%1").arg(i));
+    }
+
+    EXPECT_FALSE(set.contains("user0"));
+    EXPECT_TRUE(set.contains("user1"));
+    EXPECT_EQ(set.filterByPrefix("user4999").size(), 11);
+}
+
+TEST(ChatterSet, OnlineChattersPages)
+{
+    ChatterSet set(3);
+    set.addRecentChatter("pajlada");
+    set.addRecentChatter("offline");
+
+    set.beginOnlineChattersUpdate();
+    set.addOnlineChatters({"pajlada", "newchatter"}, 3);
+    // Pages are added while the update is still running
+    EXPECT_TRUE(set.contains("newchatter"));
+    set.addOnlineChatters({"later"}, 3);
+    set.finishOnlineChattersUpdate();
+
+    EXPECT_TRUE(set.contains("pajlada"));
+    EXPECT_TRUE(set.contains("newchatter"));
+    EXPECT_TRUE(set.contains("later"));
+    EXPECT_FALSE(set.contains("offline"));
+
+    // More chatters than the limit are online => only keep known chatters
+    set.beginOnlineChattersUpdate();
+    set.addOnlineChatters({"pajlada", "someone", "else"}, 10);
+    set.finishOnlineChattersUpdate();
+
+    EXPECT_TRUE(set.contains("pajlada"));
+    EXPECT_FALSE(set.contains("newchatter"));
+    EXPECT_FALSE(set.contains("someone"));
+}
@@ -0,0 +1,129 @@
+#include "controllers/filters/FilterCache.hpp"
+
+#include "messages/Message.hpp"
+#include "Test.hpp"
+
+#include <QUuid>
+
+#include <memory>
+
+using namespace chatterino;
+
+namespace {
+
+/// Counts the allocations that are still alive in @a live
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(size_t *live)
+        : live(live)
+    {
+    }
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &other)
+        : live(other.live)
+    {
+    }
+
+    T *allocate(size_t n)
+    {
+        ++*this->live;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T *ptr, size_t n)
+    {
+        --*this->live;
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U> &other) const
+    {
+        return this->live == other.live;
+    }
+
+    size_t *live;
+};
+
+}  // namespace
+
+TEST(FilterCache, RemembersResults)
+{
+    FilterCache cache;
+    auto filter = QUuid::createUuid();
+    auto other = QUuid::createUuid();
+    auto message = std::make_shared<const Message>();
+
+    ASSERT_EQ(cache.find(filter, message), std::nullopt);
+
+    cache.insert(filter, message, cache.generation(), true);
+    cache.insert(other, message, cache.generation(), false);
+    ASSERT_EQ(cache.size(), 2U);
+
+    ASSERT_EQ(cache.find(filter, message), true);
+    ASSERT_EQ(cache.find(other, message), false);
+    ASSERT_EQ(cache.find(filter, std::make_shared<const Message>()),
+              std::nullopt);
+}
+
+TEST(FilterCache, Invalidation)
+{
+    FilterCache cache;
+    auto filter = QUuid::createUuid();
+    auto message = std::make_shared<const Message>();
+
+    auto generation = cache.generation();
+    cache.insert(filter, message, generation, true);
+    cache.invalidate();
+    ASSERT_EQ(cache.find(filter, message), std::nullopt);
+
+    // computed before the filter changed
+    cache.insert(filter, message, generation, true);
+    ASSERT_EQ(cache.find(filter, message), std::nullopt);
+
+    cache.insert(filter, message, cache.generation(), false);
+    ASSERT_EQ(cache.find(filter, message), false);
+
+    // flags of the message changed after it was filtered
+    message->flags.set(MessageFlag::Disabled);
+    ASSERT_EQ(cache.find(filter, message), std::nullopt);
+}
+
+TEST(FilterCache, DoesntKeepMessagesAlive)
+{
+    FilterCache cache;
+    auto filter = QUuid::createUuid();
+    size_t allocations = 0;
+    auto message = std::allocate_shared<const Message>(
+        CountingAllocator<Message>(&allocations));
+    ASSERT_EQ(allocations, 1U);
+
+    cache.insert(filter, message, cache.generation(), true);
+    ASSERT_EQ(message.use_count(), 1);
+
+    // A weak reference would keep the memory of the message allocated
+    message.reset();
+    ASSERT_EQ(allocations, 0U);
+}
+
+TEST(FilterCache, DropsOlderMessages)
+{
+    FilterCache cache;
+    auto filter = QUuid::createUuid();
+    auto first = std::make_shared<const Message>();
+    cache.insert(filter, first, cache.generation(), true);
+
+    std::shared_ptr<const Message> last;
+    for (size_t i = 1; i <= FilterCache::MAX_ENTRIES; i++)
+    {
+        last = std::make_shared<const Message>();
+        cache.insert(filter, last, cache.generation(), true);
+    }
+
+    ASSERT_LT(cache.size(), FilterCache::MAX_ENTRIES);
+    ASSERT_EQ(cache.find(filter, first), std::nullopt);
+    ASSERT_EQ(cache.find(filter, last), true);
+}
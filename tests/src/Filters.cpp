@@ -15,6 +15,7 @@
 #include "providers/ffz/FfzBadges.hpp"
 #include "providers/seventv/SeventvBadges.hpp"
 #include "providers/twitch/TwitchBadge.hpp"
+#include "providers/twitch/TwitchIrcTags.hpp"
 #include "Test.hpp"
 
 #include <QColor>
@@ -286,7 +287,8 @@ TEST_F(FiltersF, TypingContextChecks)
     QString originalMessage = privmsg->content();
 
     auto [msg, alert] = MessageBuilder::makeIrcMessage(
-        &channel, privmsg, MessageParseArgs{}, originalMessage, 0);
+        &channel, privmsg, TwitchIrcTags::fromMessage(privmsg),
+        MessageParseArgs{}, originalMessage, 0);
 
     EXPECT_NE(msg.get(), nullptr);
 
@@ -297,6 +299,62 @@ TEST_F(FiltersF, TypingContextChecks)
     delete privmsg;
 }
 
+TEST_F(FiltersF, MessageContext)
+{
+    MockChannel channel("pajlada");
+
+    QByteArray message =
+        R"(@badge-info=subscriber/80;badges=broadcaster/1,subscriber/3072,partner/1;color=#CC44FF;display-name=pajlada;emote-only=1;emotes=25:0-4;first-msg=0;flags=;id=90ef1e46-8baa-4bf2-9c54-272f39d6fa11;mod=0;returning-chatter=0;room-id=11148817;subscriber=1;tmi-sent-ts=1662206235860;turbo=0;user-id=11148817;user-type= :pajlada!pajlada@pajlada.tmi.twitch.tv PRIVMSG #pajlada :ACTION Kappa)";
+
+    auto *privmsg = dynamic_cast<Communi::IrcPrivateMessage *>(
+        Communi::IrcPrivateMessage::fromData(message, nullptr));
+    ASSERT_NE(privmsg, nullptr);
+
+    auto [msg, alert] = MessageBuilder::makeIrcMessage(
+        &channel, privmsg, TwitchIrcTags::fromMessage(privmsg),
+        MessageParseArgs{}, privmsg->content(), 0);
+    ASSERT_NE(msg.get(), nullptr);
+
+    auto contextMap = buildContextMap(msg, &channel);
+    MessageContext context(*msg, &channel);
+
+    for (const auto &identifier : MESSAGE_TYPING_CONTEXT.keys())
+    {
+        auto variable = variableFromIdentifier(identifier);
+        ASSERT_TRUE(variable.has_value()) << identifier;
+        EXPECT_EQ(variableToIdentifier(*variable), identifier);
+        EXPECT_EQ(context.value(*variable), contextMap.value(identifier))
+            << identifier;
+    }
+    EXPECT_EQ(variableFromIdentifier("author.unknown"), std::nullopt);
+
+    EXPECT_EQ(context.value(Variable::AuthorSubbed), QVariant(true));
+    EXPECT_EQ(context.value(Variable::AuthorSubLength), QVariant(80));
+
+    // clang-format off
+    std::vector<QString> tests{
+        R".(author.subbed && author.sub_length > 12).",
+        R".(author.badges contains "broadcaster").",
+        R".({"pajlada", "forsen"} contains channel.name).",
+        R".(flags.action || message.length > 0).",
+        R".(message.content match ri"kappa").",
+    };
+    // clang-format on
+
+    for (const auto &input : tests)
+    {
+        auto filterResult = Filter::fromString(input);
+        auto *filter = std::get_if<Filter>(&filterResult);
+        ASSERT_NE(filter, nullptr) << input;
+
+        EXPECT_EQ(filter->execute(context), filter->execute(contextMap))
+            << input;
+        EXPECT_EQ(filter->execute(context), QVariant(true)) << input;
+    }
+
+    delete privmsg;
+}
+
 TEST_F(FiltersF, ExpressionDebug)
 {
     struct TestCase {
@@ -0,0 +1,50 @@
+#include "providers/twitch/api/HelixRatelimit.hpp"
+
+#include "common/network/NetworkResult.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+NetworkResult withHeaders(QList<QNetworkReply::RawHeaderPair> headers)
+{
+    return {NetworkResult::NetworkError::NoError, 200, {}, std::move(headers)};
+}
+
+}  // namespace
+
+TEST(HelixRatelimit, Update)
+{
+    HelixRatelimit ratelimit;
+    ASSERT_FALSE(ratelimit.state().remaining.has_value());
+
+    ratelimit.update(withHeaders({
+        {"Ratelimit-Limit", "800"},
+        {"Ratelimit-Remaining", "799"},
+        {"Ratelimit-Reset", "1700000060"},
+    }));
+
+    auto state = ratelimit.state();
+    ASSERT_EQ(state.limit, 800);
+    ASSERT_EQ(state.remaining, 799);
+    auto reset = HelixRatelimit::Clock::time_point(1700000060s);
+    ASSERT_EQ(state.reset, reset);
+
+    ASSERT_EQ(state.remainingAt(reset - 1s), 799);
+    // The bucket is full again
+    ASSERT_EQ(state.remainingAt(reset), std::nullopt);
+
+    // Responses without the headers don't change anything
+    ratelimit.update(withHeaders({{"Content-Type", "application/json"}}));
+    ASSERT_EQ(ratelimit.state().remaining, 799);
+
+    ratelimit.update(withHeaders({
+        {"Ratelimit-Remaining", "42"},
+        {"Ratelimit-Reset", "1700000061"},
+    }));
+    state = ratelimit.state();
+    ASSERT_EQ(state.limit, 800);
+    ASSERT_EQ(state.remaining, 42);
+}
@@ -0,0 +1,119 @@
+#include "providers/twitch/api/HelixScheduler.hpp"
+
+#include "common/network/NetworkResult.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+NetworkResult withRatelimit(int64_t remaining,
+                            HelixRatelimit::Clock::time_point reset)
+{
+    auto resetSeconds =
+        static_cast<qint64>(HelixRatelimit::Clock::to_time_t(reset));
+    return {
+        NetworkResult::NetworkError::NoError,
+        200,
+        {},
+        {
+            {"Ratelimit-Limit", "800"},
+            {"Ratelimit-Remaining", QByteArray::number(remaining)},
+            {"Ratelimit-Reset", QByteArray::number(resetSeconds)},
+        },
+    };
+}
+
+}  // namespace
+
+TEST(HelixScheduler, PriorityOf)
+{
+    using Type = NetworkRequestType;
+
+    ASSERT_EQ(helixPriorityOf(u"moderation/bans", Type::Post),
+              HelixPriority::Interactive);
+    ASSERT_EQ(helixPriorityOf(u"chat/messages", Type::Post),
+              HelixPriority::Interactive);
+    ASSERT_EQ(helixPriorityOf(u"eventsub/subscriptions", Type::Post),
+              HelixPriority::Normal);
+    ASSERT_EQ(helixPriorityOf(u"channels/followed", Type::Get),
+              HelixPriority::Normal);
+    ASSERT_EQ(helixPriorityOf(u"streams", Type::Get),
+              HelixPriority::Background);
+    ASSERT_EQ(helixPriorityOf(u"chat/chatters", Type::Get),
+              HelixPriority::Background);
+}
+
+TEST(HelixScheduler, MaySend)
+{
+    auto now = HelixRatelimit::Clock::now();
+    HelixRatelimit::State state{
+        .limit = 800,
+        .remaining = 300,
+        .reset = now + 30s,
+    };
+
+    ASSERT_TRUE(HelixScheduler::maySend(HelixPriority::Background, state, 0,
+                                        now));
+    // 300 - 100 points are below a quarter of the bucket
+    ASSERT_FALSE(HelixScheduler::maySend(HelixPriority::Background, state,
+                                         100, now));
+    ASSERT_TRUE(HelixScheduler::maySend(HelixPriority::Normal, state, 100,
+                                        now));
+
+    state.remaining = 1;
+    ASSERT_FALSE(HelixScheduler::maySend(HelixPriority::Normal, state, 0,
+                                         now));
+    ASSERT_TRUE(HelixScheduler::maySend(HelixPriority::Interactive, state, 0,
+                                        now));
+    ASSERT_FALSE(HelixScheduler::maySend(HelixPriority::Interactive, state,
+                                         1, now));
+
+    // The bucket was refilled
+    ASSERT_TRUE(HelixScheduler::maySend(HelixPriority::Background, state, 0,
+                                        now + 30s));
+
+    // Nothing is known before the first response
+    ASSERT_TRUE(HelixScheduler::maySend(HelixPriority::Background, {}, 100,
+                                        now));
+}
+
+TEST(HelixScheduler, HoldsBackLowPriorities)
+{
+    HelixScheduler scheduler;
+    std::vector<int> sent;
+
+    scheduler.schedule(HelixPriority::Background, [&] {
+        sent.push_back(1);
+    });
+    ASSERT_EQ(sent, std::vector<int>{1});
+
+    auto now = HelixRatelimit::Clock::now();
+    scheduler.observe(withRatelimit(30, now + 60s));
+    scheduler.released();
+
+    // The bucket is low, only interactive requests go through
+    scheduler.schedule(HelixPriority::Background, [&] {
+        sent.push_back(2);
+    });
+    scheduler.schedule(HelixPriority::Normal, [&] {
+        sent.push_back(3);
+    });
+    scheduler.schedule(HelixPriority::Interactive, [&] {
+        sent.push_back(4);
+    });
+    ASSERT_EQ(sent, (std::vector<int>{1, 4}));
+    ASSERT_EQ(scheduler.waiting(), 2U);
+
+    // Once the bucket is refilled, the normal request goes first
+    scheduler.observe(withRatelimit(799, now + 60s));
+    scheduler.released();
+    QCoreApplication::processEvents();
+    ASSERT_EQ(sent, (std::vector<int>{1, 4, 3, 2}));
+    ASSERT_EQ(scheduler.waiting(), 0U);
+}
@@ -579,3 +579,88 @@ TEST_F(InputCompletionTest, SmartTabCompletionCase)
     completion = querySmartTabCompletion("nothing", false);
     ASSERT_EQ(completion.size(), 0);
 }
+
+TEST_F(InputCompletionTest, EmoteUpdates)
+{
+    auto completion = querySmartEmoteCompletion(":peepo");
+    ASSERT_EQ(completion.size(), 0);
+
+    auto bttvEmotes = std::make_shared<EmoteMap>(
+        *this->mockApplication->bttvEmotes.emotes());
+    addEmote(*bttvEmotes, "peepoHappy");
+    this->mockApplication->bttvEmotes.setEmotes(std::move(bttvEmotes));
+
+    // the new map is indexed, the other providers are unchanged
+    completion = querySmartEmoteCompletion(":peepo");
+    ASSERT_EQ(completion.size(), 1);
+    ASSERT_EQ(completion[0].displayName, "peepoHappy");
+    ASSERT_EQ(completion[0].providerName, "Global BetterTTV");
+
+    completion = querySmartEmoteCompletion(":Chicken");
+    ASSERT_EQ(completion.size(), 1);
+    ASSERT_EQ(completion[0].displayName, "ManChicken");
+}
+
+TEST_F(InputCompletionTest, PrefixOnlyTabCompletion)
+{
+    this->mockApplication->settings.prefixOnlyEmoteCompletion = true;
+
+    auto completion = queryClassicTabCompletion("ad", false);
+    ASSERT_EQ(completion.size(), 0);  // FeelsBadMan only contains "ad"
+
+    completion = querySmartTabCompletion("Man", false);
+    ASSERT_EQ(completion.size(), 1);
+    ASSERT_EQ(completion[0], "ManChicken ");
+
+    // emotes are matched with the colon, emojis without it
+    completion = querySmartTabCompletion(":tf", false);
+    ASSERT_EQ(completion.size(), 1);
+    ASSERT_EQ(completion[0], ":tf: ");
+
+    completion = queryClassicTabCompletion(":cla", false);
+    ASSERT_EQ(completion.size(), 8);
+    ASSERT_EQ(completion[0], ":clap: ");
+    ASSERT_EQ(completion[7], ":classical_building: ");
+
+    // the popup always completes emotes containing the query
+    auto popupCompletion = querySmartEmoteCompletion(":man");
+    containsRoughly(popupCompletion, {"FeelsBadMan", "ManChicken"});
+}
+
+TEST_F(InputCompletionTest, SettingsReadOnConstruction)
+{
+    // sources are updated in the background, so settings changed afterwards
+    // don't affect them
+    this->mockApplication->settings.prefixOnlyEmoteCompletion = true;
+    EmoteSource source(this->channelPtr.get(),
+                       std::make_unique<ClassicTabEmoteStrategy>());
+    this->mockApplication->settings.prefixOnlyEmoteCompletion = false;
+
+    source.update("ad");
+    ASSERT_EQ(source.output().size(), 0);
+
+    ASSERT_EQ(queryClassicTabCompletion("ad", false).size(), 1);
+}
+
+TEST_F(InputCompletionTest, EmoteIncrementalQueries)
+{
+    // queries that extend the previous one only look at its candidates
+    EmoteSource source(this->channelPtr.get(),
+                       std::make_unique<SmartEmoteStrategy>());
+    for (const auto &query : QStringList{":", ":c", ":cl", ":cla", ":clap",
+                                         ":clapp", ":c", ":ca", ":Cat"})
+    {
+        source.update(query);
+
+        auto expected = querySmartEmoteCompletion(query);
+        ASSERT_EQ(source.output().size(), expected.size()) << query;
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(source.output()[i].displayName, expected[i].displayName)
+                << query;
+            ASSERT_EQ(source.output()[i].providerName,
+                      expected[i].providerName)
+                << query;
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include "util/JsonFrame.hpp"
+
+#include "Test.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <string>
+
+using namespace chatterino;
+
+TEST(JsonFrame, Fields)
+{
+    std::string payload =
+        R"({"type":"MESSAGE","op":7,"big":12345678901234,"data":)"
+        R"({"topic":"a.b","message":"{\"x\":\"\\u00e4\\n\"}"}})";
+    JsonFrame json(payload);
+    ASSERT_TRUE(json.isValid());
+
+    const auto &root = json.root();
+    ASSERT_EQ(JsonFrame::string(root, "type"), "MESSAGE");
+    ASSERT_EQ(JsonFrame::qString(root, "type"), QStringLiteral("MESSAGE"));
+    ASSERT_EQ(JsonFrame::integer(root, "op"), 7);
+    ASSERT_EQ(JsonFrame::integer(root, "big"), 12345678901234);
+
+    // Missing or mismatched fields
+    ASSERT_EQ(JsonFrame::member(root, "missing"), nullptr);
+    ASSERT_TRUE(JsonFrame::string(root, "op").empty());
+    ASSERT_TRUE(JsonFrame::qString(root, "missing").isEmpty());
+    ASSERT_EQ(JsonFrame::integer(root, "type", -1), -1);
+    ASSERT_TRUE(JsonFrame::toQt(root, "type").isEmpty());
+
+    // Strings are unescaped, so the inner message is JSON
+    const auto *data = JsonFrame::member(root, "data");
+    ASSERT_NE(data, nullptr);
+    auto message = JsonFrame::string(*data, "message");
+    auto inner = QJsonDocument::fromJson(
+        QByteArray(message.data(), static_cast<qsizetype>(message.size())));
+    ASSERT_EQ(inner.object().value("x").toString(),
+              QStringLiteral("\u00e4\n"));
+}
+
+TEST(JsonFrame, Invalid)
+{
+    for (std::string payload : {"", "{", "[1, 2]", "\"string\"", "{]"})
+    {
+        JsonFrame json(payload);
+        ASSERT_FALSE(json.isValid()) << payload;
+    }
+}
+
+TEST(JsonFrame, MatchesQJsonDocument)
+{
+    const QByteArray input =
+        R"({"a":null,"b":true,"c":false,"d":-3,"e":1.5,"f":"text",)"
+        R"("g":[1,"two",{"three":3}],"h":{"i":{"j":[]}},"k":18446744073709551615})";
+
+    std::string payload = input.toStdString();
+    JsonFrame json(payload);
+    ASSERT_TRUE(json.isValid());
+
+    auto expected = QJsonDocument::fromJson(input).object();
+    ASSERT_EQ(JsonFrame::toQt(json.root()).toObject(), expected);
+}
@@ -0,0 +1,75 @@
+#include "controllers/twitch/LiveController.hpp"
+
+#include "Test.hpp"
+
+using namespace chatterino;
+
+TEST(LiveController, RefreshInterval)
+{
+    const auto now =
+        QDateTime::fromString("2025-03-01T18:00:00Z", Qt::ISODate);
+
+    // Live channels are refreshed often, even if EventSub tells us about them
+    ASSERT_EQ(TwitchLiveController::refreshInterval(
+                  {
+                      .live = true,
+                      .hasStreamEvents = true,
+                      .trackedSince = now.addDays(-1),
+                      .lastLive = now,
+                  },
+                  now),
+              TwitchLiveController::REFRESH_INTERVAL);
+
+    // Offline channels with stream events aren't polled
+    ASSERT_EQ(TwitchLiveController::refreshInterval(
+                  {
+                      .hasStreamEvents = true,
+                      .trackedSince = now.addDays(-1),
+                  },
+                  now),
+              std::nullopt);
+
+    // Recently offline
+    ASSERT_EQ(TwitchLiveController::refreshInterval(
+                  {
+                      .trackedSince = now.addDays(-1),
+                      .lastLive = now.addSecs(-10 * 60),
+                      .lastStarted = now.addSecs(-5 * 60 * 60),
+                  },
+                  now),
+              TwitchLiveController::REFRESH_INTERVAL);
+
+    // Offline for a while
+    ASSERT_EQ(TwitchLiveController::refreshInterval(
+                  {
+                      .trackedSince = now.addDays(-1),
+                      .lastLive = now.addSecs(-2 * 60 * 60),
+                      .lastStarted = now.addSecs(-5 * 60 * 60),
+                  },
+                  now),
+              TwitchLiveController::OFFLINE_REFRESH_INTERVAL);
+
+    // Never seen live
+    ASSERT_EQ(TwitchLiveController::refreshInterval(
+                  {
+                      .trackedSince = now.addSecs(-60 * 60),
+                  },
+                  now),
+              TwitchLiveController::OFFLINE_REFRESH_INTERVAL);
+    ASSERT_EQ(TwitchLiveController::refreshInterval(
+                  {
+                      .trackedSince = now.addDays(-1),
+                  },
+                  now),
+              TwitchLiveController::LONG_OFFLINE_REFRESH_INTERVAL);
+
+    // The last stream started at about this time yesterday
+    ASSERT_EQ(TwitchLiveController::refreshInterval(
+                  {
+                      .trackedSince = now.addDays(-2),
+                      .lastLive = now.addSecs(-20 * 60 * 60),
+                      .lastStarted = now.addDays(-1).addSecs(10 * 60),
+                  },
+                  now),
+              TwitchLiveController::REFRESH_INTERVAL);
+}
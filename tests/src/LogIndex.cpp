@@ -0,0 +1,128 @@
+#include "singletons/helper/LogIndex.hpp"
+
+#include "Test.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+void appendLog(const QTemporaryDir &dir, const QString &name,
+               const QByteArray &contents)
+{
+    QFile file(dir.filePath(name));
+    ASSERT_TRUE(file.open(QIODevice::Append));
+    file.write(contents);
+}
+
+QStringList texts(const std::vector<LogSearchResult> &results)
+{
+    QStringList texts;
+    for (const auto &result : results)
+    {
+        texts.append(result.text);
+    }
+    return texts;
+}
+
+}  // namespace
+
+TEST(LogIndex, Tokenize)
+{
+    ASSERT_EQ(LogIndex::tokenize(u"forsen: Hello, World! a b_c"),
+              (std::vector<QString>{"forsen", "hello", "world", "b_c"}));
+    ASSERT_EQ(LogIndex::tokenize(QString("a ") + QString(40, u'x')),
+              (std::vector<QString>{QString(LogIndex::MAX_TOKEN_LENGTH, u'x')}));
+    ASSERT_TRUE(LogIndex::tokenize(u"! ? a").empty());
+}
+
+TEST(LogIndex, Search)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    appendLog(dir, "forsen-2024-01-01.log",
+              "# Start logging at 2024-01-01 10:00:00 UTC\n"
+              "[10:00:01] forsen: hello chat\n"
+              "[10:00:02] pajlada: Kappa 123\n"
+              "[10:00:03] forsen: kappa hello\n");
+    // stream logs contain the same lines as the daily logs
+    appendLog(dir, "forsen-123456.log", "[10:00:01] forsen: hello chat\n");
+
+    CancellationToken token(false);
+    LogIndex index(dir.path());
+    index.update(token);
+    ASSERT_EQ(index.segmentCount(), 1U);
+
+    auto results = index.search({"hello"}, 10, token);
+    ASSERT_EQ(texts(results),
+              (QStringList{"forsen: kappa hello", "forsen: hello chat"}));
+    ASSERT_EQ(results[0].time,
+              QDateTime(QDate(2024, 1, 1), QTime(10, 0, 3)));
+
+    // words are matched as prefixes, all words have to match
+    ASSERT_EQ(texts(index.search({"KAP", "hel"}, 10, token)),
+              (QStringList{"forsen: kappa hello"}));
+    ASSERT_EQ(texts(index.search({"kappa"}, 1, token)),
+              (QStringList{"forsen: kappa hello"}));
+    ASSERT_TRUE(index.search({"doesnotexist"}, 10, token).empty());
+    ASSERT_TRUE(index.search({"a"}, 10, token).empty());
+
+    // a line that's still being written isn't indexed yet
+    appendLog(dir, "forsen-2024-01-02.log",
+              "[11:00:00] pajlada: hello again\n[11:00:01] forsen: hel");
+    index.update(token);
+    ASSERT_EQ(index.segmentCount(), 2U);
+    ASSERT_EQ(texts(index.search({"hello"}, 1, token)),
+              (QStringList{"pajlada: hello again"}));
+
+    appendLog(dir, "forsen-2024-01-02.log", "lo world\n");
+    index.update(token);
+    ASSERT_EQ(index.segmentCount(), 3U);
+    ASSERT_EQ(texts(index.search({"world"}, 10, token)),
+              (QStringList{"forsen: hello world"}));
+
+    // nothing new to index
+    index.update(token);
+    ASSERT_EQ(index.segmentCount(), 3U);
+
+    // the index is persisted next to the logs
+    LogIndex reopened(dir.path());
+    ASSERT_EQ(reopened.segmentCount(), 3U);
+    ASSERT_EQ(texts(reopened.search({"hello"}, 10, token)).size(), 4);
+
+    token.cancel();
+    ASSERT_TRUE(reopened.search({"hello"}, 10, token).empty());
+}
+
+TEST(LogIndex, IncompleteUpdate)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    appendLog(dir, "forsen-2024-01-01.log", "[10:00:01] forsen: hello chat\n");
+
+    // a cancelled update doesn't index anything
+    LogIndex index(dir.path());
+    index.update(CancellationToken(true));
+    ASSERT_EQ(index.segmentCount(), 0U);
+
+    // the index directory can't be created
+    {
+        QFile blocker(dir.filePath(".index"));
+        ASSERT_TRUE(blocker.open(QIODevice::WriteOnly));
+    }
+    CancellationToken token(false);
+    index.update(token);
+    ASSERT_EQ(index.segmentCount(), 0U);
+
+    // the lines are indexed once the segment can be written
+    ASSERT_TRUE(QFile::remove(dir.filePath(".index")));
+    index.update(token);
+    ASSERT_EQ(index.segmentCount(), 1U);
+    ASSERT_EQ(texts(index.search({"hello"}, 10, token)),
+              (QStringList{"forsen: hello chat"}));
+}
@@ -0,0 +1,115 @@
+#include "messages/layouts/MessageBufferAtlas.hpp"
+
+#include "Test.hpp"
+
+#include <tuple>
+
+using namespace chatterino;
+
+namespace {
+
+constexpr int WIDTH = 100;
+constexpr int VIEWPORT_HEIGHT = 200;
+constexpr int64_t PAGE_BYTES =
+    int64_t{WIDTH} * MessageBufferAtlas::PAGE_HEIGHT * 4;
+
+}  // namespace
+
+TEST(MessageBufferAtlas, AllocatesFromSamePage)
+{
+    MessageBufferAtlas atlas;
+    atlas.setGeometry(WIDTH, VIEWPORT_HEIGHT, 1);
+
+    auto a = atlas.allocate(20);
+    auto b = atlas.allocate(30);
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+
+    ASSERT_EQ(a->page, b->page);
+    ASSERT_EQ(a->y, 0);
+    ASSERT_EQ(b->y, 20);
+    ASSERT_EQ(atlas.pageCount(), 1);
+
+    ASSERT_TRUE(atlas.isValid(*a));
+    ASSERT_TRUE(atlas.isValid(*b));
+    ASSERT_EQ(atlas.sourceRect(*b), QRectF(0, 20, WIDTH, 30));
+}
+
+TEST(MessageBufferAtlas, RejectsTallMessages)
+{
+    MessageBufferAtlas atlas;
+    atlas.setGeometry(WIDTH, VIEWPORT_HEIGHT, 1);
+
+    ASSERT_FALSE(atlas.allocate(MessageBufferAtlas::PAGE_HEIGHT + 1));
+    ASSERT_FALSE(atlas.allocate(0));
+    ASSERT_TRUE(atlas.allocate(MessageBufferAtlas::PAGE_HEIGHT));
+}
+
+TEST(MessageBufferAtlas, RecyclesLeastRecentlyUsedPage)
+{
+    MessageBufferAtlas atlas;
+    atlas.setGeometry(WIDTH, VIEWPORT_HEIGHT, 1);
+    atlas.setMaxBytes(PAGE_BYTES * 3);
+    ASSERT_EQ(atlas.maxPages(), 3);
+
+    constexpr int height = MessageBufferAtlas::PAGE_HEIGHT;
+    auto first = *atlas.allocate(height);
+    auto second = *atlas.allocate(height);
+    auto third = *atlas.allocate(height);
+    ASSERT_EQ(atlas.pageCount(), 3);
+
+    // the first page is now the most recently used one
+    atlas.use(first);
+
+    auto fourth = *atlas.allocate(height);
+    ASSERT_EQ(atlas.pageCount(), 3);
+    ASSERT_EQ(fourth.page, second.page);
+
+    ASSERT_TRUE(atlas.isValid(first));
+    ASSERT_FALSE(atlas.isValid(second));
+    ASSERT_TRUE(atlas.isValid(third));
+    ASSERT_TRUE(atlas.isValid(fourth));
+}
+
+TEST(MessageBufferAtlas, KeepsOneScreenOfPages)
+{
+    MessageBufferAtlas atlas;
+    atlas.setGeometry(WIDTH, MessageBufferAtlas::PAGE_HEIGHT * 3, 1);
+    atlas.setMaxBytes(0);
+
+    ASSERT_EQ(atlas.maxPages(), 5);
+}
+
+TEST(MessageBufferAtlas, GeometryChangeInvalidates)
+{
+    MessageBufferAtlas atlas;
+    atlas.setGeometry(WIDTH, VIEWPORT_HEIGHT, 1);
+
+    auto slot = *atlas.allocate(20);
+    ASSERT_TRUE(atlas.isValid(slot));
+
+    // only the viewport changed
+    atlas.setGeometry(WIDTH, VIEWPORT_HEIGHT * 2, 1);
+    ASSERT_TRUE(atlas.isValid(slot));
+
+    atlas.setGeometry(WIDTH, VIEWPORT_HEIGHT * 2, 2);
+    ASSERT_FALSE(atlas.isValid(slot));
+    ASSERT_EQ(atlas.pageCount(), 0);
+
+    auto hiDpiSlot = *atlas.allocate(20);
+    ASSERT_EQ(atlas.sourceRect(hiDpiSlot), QRectF(0, 0, WIDTH * 2, 40));
+}
+
+TEST(MessageBufferAtlas, SlotsAreUniqueAcrossAtlases)
+{
+    MessageBufferAtlas a;
+    MessageBufferAtlas b;
+    a.setGeometry(WIDTH, VIEWPORT_HEIGHT, 1);
+    b.setGeometry(WIDTH, VIEWPORT_HEIGHT, 1);
+
+    auto slot = *a.allocate(20);
+    std::ignore = b.allocate(20);
+
+    ASSERT_TRUE(a.isValid(slot));
+    ASSERT_FALSE(b.isValid(slot));
+}
@@ -0,0 +1,155 @@
+#include "messages/Message.hpp"
+#include "messages/search/AuthorPredicate.hpp"
+#include "messages/search/BadgePredicate.hpp"
+#include "messages/search/ChannelPredicate.hpp"
+#include "messages/search/MessageFlagsPredicate.hpp"
+#include "messages/search/SubtierPredicate.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+#include "Test.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+std::vector<MessagePtr> makeMessages(size_t count)
+{
+    const QStringList names{"forsen", "pajlada", "Nymn", "zneix"};
+    const QStringList channels{"forsen", "pajlada"};
+    const std::vector<Badge> badges{
+        {"moderator", "1"},
+        {"subscriber", "3012"},
+        {"subscriber", "6"},
+        {"vip", "1"},
+    };
+
+    std::vector<MessagePtr> messages;
+    for (size_t i = 0; i < count; i++)
+    {
+        auto message = std::make_shared<Message>();
+        message->loginName = names[static_cast<qsizetype>(i % 4)].toLower();
+        // Some authors use a localized name
+        message->displayName = i % 7 == 0
+                                   ? QStringLiteral("Localized")
+                                   : names[static_cast<qsizetype>(i % 4)];
+        message->channelName = channels[static_cast<qsizetype>(i % 3 % 2)];
+        if (i % 5 != 0)
+        {
+            message->badges.push_back(badges[i % badges.size()]);
+        }
+        if (i % 11 == 0)
+        {
+            message->flags.set(MessageFlag::System);
+        }
+        if (i % 13 == 0)
+        {
+            message->flags.set(MessageFlag::Timeout);
+        }
+        messages.push_back(std::move(message));
+    }
+    return messages;
+}
+
+/// Checks that filtering a batch gives the same result as calling appliesTo
+/// for every message
+void checkBatch(MessagePredicate &predicate,
+                const std::vector<MessagePtr> &messages)
+{
+    MessageMask mask(messages.size());
+    predicate.filter(messages, mask);
+
+    size_t accepted = 0;
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        ASSERT_EQ(mask.test(i), predicate.appliesTo(*messages[i])) << i;
+        accepted += mask.test(i) ? 1 : 0;
+    }
+    ASSERT_GT(accepted, 0U);
+    ASSERT_LT(accepted, messages.size());
+}
+
+}  // namespace
+
+TEST(MessageMask, Bits)
+{
+    MessageMask mask(130);
+    ASSERT_EQ(mask.size(), 130U);
+    ASSERT_TRUE(mask.test(0));
+    ASSERT_TRUE(mask.test(129));
+
+    mask.reset(0);
+    mask.reset(64);
+    mask.reset(129);
+
+    std::vector<size_t> set;
+    mask.forEachSet([&](size_t i) {
+        set.push_back(i);
+    });
+    ASSERT_EQ(set.size(), 127U);
+    ASSERT_EQ(set.front(), 1U);
+    ASSERT_EQ(set.back(), 128U);
+    ASSERT_FALSE(mask.none());
+
+    for (auto i : set)
+    {
+        mask.reset(i);
+    }
+    ASSERT_TRUE(mask.none());
+    ASSERT_TRUE(MessageMask(0).none());
+}
+
+TEST(MessagePredicates, BatchMatchesSingle)
+{
+    auto messages = makeMessages(300);
+
+    for (bool negate : {false, true})
+    {
+        AuthorPredicate author("FORSEN,nymn", negate);
+        checkBatch(author, messages);
+
+        BadgePredicate badge("mod,VIP", negate);
+        checkBatch(badge, messages);
+
+        ChannelPredicate channel("Pajlada", negate);
+        checkBatch(channel, messages);
+
+        SubtierPredicate subtier("3", negate);
+        checkBatch(subtier, messages);
+
+        MessageFlagsPredicate system("system", negate);
+        checkBatch(system, messages);
+
+        MessageFlagsPredicate timeout("system,timeout", negate);
+        checkBatch(timeout, messages);
+    }
+}
+
+TEST(MessagePredicates, BatchSkipsRejected)
+{
+    auto messages = makeMessages(100);
+
+    AuthorPredicate author("forsen", false);
+    ChannelPredicate channel("forsen", false);
+
+    MessageMask mask(messages.size());
+    author.filter(messages, mask);
+    channel.filter(messages, mask);
+
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        ASSERT_EQ(mask.test(i), author.appliesTo(*messages[i]) &&
+                                    channel.appliesTo(*messages[i]))
+            << i;
+    }
+}
+
+TEST(MessagePredicates, MutableFields)
+{
+    // Flags can change after a message was added, so they're checked in the
+    // GUI thread
+    ASSERT_TRUE(MessageFlagsPredicate("system", false).readsMutableFields());
+    ASSERT_FALSE(AuthorPredicate("forsen", false).readsMutableFields());
+    ASSERT_FALSE(BadgePredicate("mod", false).readsMutableFields());
+}
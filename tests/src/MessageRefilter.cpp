@@ -0,0 +1,162 @@
+#include "widgets/helper/MessageRefilter.hpp"
+
+#include "messages/LimitedQueue.hpp"
+#include "messages/Message.hpp"
+#include "Test.hpp"
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+std::vector<MessagePtr> makeMessages(size_t count)
+{
+    std::vector<MessagePtr> messages;
+    for (size_t i = 0; i < count; i++)
+    {
+        messages.push_back(std::make_shared<const Message>());
+    }
+    return messages;
+}
+
+LimitedQueueSnapshot<MessagePtr> makeSource(
+    const std::vector<MessagePtr> &messages, size_t limit)
+{
+    LimitedQueue<MessagePtr> queue(limit);
+    for (const auto &message : messages)
+    {
+        queue.pushBack(message);
+    }
+    return queue.getSnapshot();
+}
+
+/// Runs all chunks like ChannelView does, adding older chunks at the start
+std::vector<MessagePtr> refilterAll(MessageRefilter &refilter,
+                                    const MessageRefilter::Filter &filter)
+{
+    std::vector<MessagePtr> result;
+    while (!refilter.isDone())
+    {
+        auto chunk = refilter.nextChunk(filter);
+        result.insert(result.begin(), chunk.begin(), chunk.end());
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(MessageRefilter, KeepsMessagesOnlyShownInTheProxy)
+{
+    auto messages = makeMessages(5);
+    auto dayChange = std::make_shared<const Message>();
+
+    // The source evicted the first two messages
+    auto source = makeSource(messages, 3);
+    ASSERT_EQ(source.size(), 3U);
+
+    // The old filters excluded messages[3]
+    std::vector<MessagePtr> shown{
+        messages[0], dayChange, messages[1], messages[2], messages[4],
+    };
+
+    MessageRefilter refilter(shown, source, 1000);
+    auto result = refilterAll(refilter, [&](const MessagePtr &message) {
+        return message != messages[2];
+    });
+
+    std::vector<MessagePtr> expected{
+        messages[0], dayChange, messages[1], messages[3], messages[4],
+    };
+    ASSERT_EQ(result, expected);
+}
+
+TEST(MessageRefilter, KeepsProxyMessagesBetweenSourceMessages)
+{
+    auto messages = makeMessages(4);
+    auto dayChange = std::make_shared<const Message>();
+    auto source = makeSource(messages, 10);
+
+    // The old filters excluded messages[1]
+    std::vector<MessagePtr> shown{
+        messages[0], messages[2], dayChange, messages[3],
+    };
+
+    MessageRefilter refilter(shown, source, 1000);
+    auto result = refilterAll(refilter, [](const MessagePtr &) {
+        return true;
+    });
+
+    std::vector<MessagePtr> expected{
+        messages[0], messages[1], messages[2], dayChange, messages[3],
+    };
+    ASSERT_EQ(result, expected);
+}
+
+TEST(MessageRefilter, ChecksNewestChunkFirst)
+{
+    auto messages = makeMessages(1200);
+    auto source = makeSource(messages, 2000);
+
+    MessageRefilter refilter({}, source, 2000);
+    size_t checked = 0;
+    auto filter = [&](const MessagePtr &) {
+        checked++;
+        return true;
+    };
+
+    auto chunk = refilter.nextChunk(filter);
+    ASSERT_EQ(checked, MessageRefilter::CHUNK_SIZE);
+    ASSERT_EQ(chunk.size(), MessageRefilter::CHUNK_SIZE);
+    ASSERT_EQ(chunk.front(), messages[1200 - MessageRefilter::CHUNK_SIZE]);
+    ASSERT_EQ(chunk.back(), messages.back());
+    ASSERT_FALSE(refilter.isDone());
+
+    chunk = refilter.nextChunk(filter);
+    ASSERT_EQ(chunk.size(), MessageRefilter::CHUNK_SIZE);
+    ASSERT_FALSE(refilter.isDone());
+
+    chunk = refilter.nextChunk(filter);
+    ASSERT_EQ(chunk.size(), 200U);
+    ASSERT_EQ(chunk.front(), messages.front());
+    ASSERT_TRUE(refilter.isDone());
+    ASSERT_EQ(checked, 1200U);
+}
+
+TEST(MessageRefilter, StopsWhenFull)
+{
+    auto messages = makeMessages(1200);
+    auto source = makeSource(messages, 2000);
+
+    MessageRefilter refilter({}, source, 600);
+    auto result = refilterAll(refilter, [](const MessagePtr &) {
+        return true;
+    });
+
+    // The second chunk filled the view, the third one wasn't checked
+    ASSERT_EQ(result.size(), 2 * MessageRefilter::CHUNK_SIZE);
+    ASSERT_EQ(result.back(), messages.back());
+}
+
+TEST(MessageRefilter, RemainingShown)
+{
+    auto messages = makeMessages(MessageRefilter::CHUNK_SIZE + 2);
+    auto evicted = std::make_shared<const Message>();
+    auto source = makeSource(messages, 1000);
+
+    std::vector<MessagePtr> shown{evicted, messages[0]};
+    MessageRefilter refilter(shown, source, 1000);
+    ASSERT_EQ(refilter.remainingShown(), std::vector<MessagePtr>{evicted});
+
+    refilter.nextChunk([](const MessagePtr &) {
+        return false;
+    });
+    ASSERT_EQ(refilter.remainingShown(), std::vector<MessagePtr>{evicted});
+
+    auto chunk = refilter.nextChunk([](const MessagePtr &) {
+        return false;
+    });
+    ASSERT_EQ(chunk, std::vector<MessagePtr>{evicted});
+    ASSERT_TRUE(refilter.isDone());
+    ASSERT_TRUE(refilter.remainingShown().empty());
+}
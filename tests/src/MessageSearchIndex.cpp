@@ -0,0 +1,134 @@
+#include "messages/search/MessageSearchIndex.hpp"
+
+#include "common/Literals.hpp"
+#include "messages/LimitedQueue.hpp"
+#include "messages/Message.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+MessagePtr makeMessage(const QString &searchText)
+{
+    auto message = std::make_shared<Message>();
+    message->searchText = searchText;
+    return message;
+}
+
+}  // namespace
+
+TEST(MessageSearchIndex, Candidates)
+{
+    MessageSearchIndex index;
+    auto forsen = makeMessage("forsen: Forsen is live!");
+    auto pajlada = makeMessage("pajlada: hello chat");
+    auto both = makeMessage("pajlada: FORSEN");
+    index.add(forsen);
+    index.add(pajlada);
+    index.add(both);
+    ASSERT_EQ(index.size(), 3U);
+
+    auto candidates = index.candidates({"forsen"});
+    ASSERT_TRUE(candidates.has_value());
+    ASSERT_EQ(candidates->size(), 2U);
+    ASSERT_TRUE(candidates->contains(forsen.get()));
+    ASSERT_TRUE(candidates->contains(both.get()));
+
+    candidates = index.candidates({"Forsen", "pajlada"});
+    ASSERT_TRUE(candidates.has_value());
+    ASSERT_EQ(candidates->size(), 1U);
+    ASSERT_TRUE(candidates->contains(both.get()));
+
+    candidates = index.candidates({"kappa"});
+    ASSERT_TRUE(candidates.has_value());
+    ASSERT_TRUE(candidates->empty());
+
+    // too short to narrow down the messages
+    ASSERT_FALSE(index.candidates({"fo"}).has_value());
+    ASSERT_FALSE(index.candidates({}).has_value());
+
+    // short terms are ignored if there are longer ones
+    candidates = index.candidates({"he", "hello"});
+    ASSERT_TRUE(candidates.has_value());
+    ASSERT_EQ(candidates->size(), 1U);
+    ASSERT_TRUE(candidates->contains(pajlada.get()));
+}
+
+TEST(MessageSearchIndex, Remove)
+{
+    MessageSearchIndex index;
+    auto first = makeMessage("first message");
+    auto second = makeMessage("second message");
+    index.add(first);
+    index.add(second);
+
+    index.remove(first);
+    ASSERT_EQ(index.size(), 1U);
+    auto candidates = index.candidates({"message"});
+    ASSERT_TRUE(candidates.has_value());
+    ASSERT_EQ(candidates->size(), 1U);
+    ASSERT_TRUE(candidates->contains(second.get()));
+
+    // messages added twice are kept until they're removed twice
+    index.add(second);
+    index.remove(second);
+    ASSERT_EQ(index.size(), 1U);
+    index.remove(second);
+    ASSERT_EQ(index.size(), 0U);
+    candidates = index.candidates({"message"});
+    ASSERT_TRUE(candidates.has_value());
+    ASSERT_TRUE(candidates->empty());
+}
+
+TEST(MessageSearchIndex, Compaction)
+{
+    MessageSearchIndex index;
+    std::vector<MessagePtr> messages;
+    for (int i = 0; i < 1000; i++)
+    {
+        messages.push_back(
+            makeMessage(u"message number %1 with some text"_s.arg(i)));
+        index.add(messages.back());
+    }
+
+    // Removing most messages compacts the postings at some point
+    for (int i = 0; i < 990; i++)
+    {
+        index.remove(messages[i]);
+    }
+    ASSERT_EQ(index.size(), 10U);
+
+    auto candidates = index.candidates({"some text"});
+    ASSERT_TRUE(candidates.has_value());
+    ASSERT_EQ(candidates->size(), 10U);
+    for (int i = 990; i < 1000; i++)
+    {
+        ASSERT_TRUE(candidates->contains(messages[i].get()));
+    }
+
+    candidates = index.candidates({"number 999"});
+    ASSERT_TRUE(candidates.has_value());
+    ASSERT_EQ(candidates->size(), 1U);
+}
+
+TEST(MessageSearchIndex, Rebuild)
+{
+    LimitedQueue<MessagePtr> queue(2);
+    MessagePtr deleted;
+    queue.pushBack(makeMessage("old message"), deleted);
+    queue.pushBack(makeMessage("new message"), deleted);
+
+    MessageSearchIndex index;
+    index.add(makeMessage("unrelated message"));
+    index.rebuild(queue.getSnapshot());
+    ASSERT_EQ(index.size(), 2U);
+
+    auto candidates = index.candidates({"unrelated"});
+    ASSERT_TRUE(candidates.has_value());
+    ASSERT_TRUE(candidates->empty());
+
+    index.clear();
+    ASSERT_EQ(index.size(), 0U);
+}
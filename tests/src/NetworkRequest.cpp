@@ -232,6 +232,43 @@ TEST(NetworkRequest, FinallyCallbackOnTimeout)
     EXPECT_TRUE(NetworkManager::workerThread->isRunning());
 }
 
+TEST(NetworkRequest, ReleasedOnTimeout)
+{
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+
+    RequestWaiter waiter;
+
+    // Requests without a response are released too
+    NetworkRequest(getDelayURL(5))
+        .timeout(1000)
+        .released([&] {
+            waiter.requestDone();
+        })
+        .execute();
+
+    waiter.waitForRequest();
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+}
+
+TEST(NetworkRequest, NotReleasedIfNotSent)
+{
+    bool released = false;
+    std::function<void()> send;
+
+    NetworkRequest(getStatusURL(200))
+        .gate([&](auto fn) {
+            send = std::move(fn);
+        })
+        .released([&] {
+            released = true;
+        })
+        .execute();
+
+    // Dropping the gate's function destroys the request without sending it
+    send = {};
+    EXPECT_FALSE(released);
+}
+
 /// Ensure timeouts don't expire early just because their request took a bit longer to actually fire
 ///
 /// We need to ensure all requests are "executed" before we start waiting for them
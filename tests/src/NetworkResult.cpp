@@ -55,3 +55,17 @@ TEST(NetworkResult, InvalidError)
     checkResult({static_cast<Error>(-1), 42, {}}, static_cast<Error>(-1), 42,
                 "unknown error (status: 42, error: -1)");
 }
+
+TEST(NetworkResult, RawHeader)
+{
+    NetworkResult res(Error::NoError, 200, {},
+                      {
+                          {"Content-Type", "application/json"},
+                          {"Ratelimit-Remaining", "799"},
+                      });
+
+    ASSERT_EQ(res.rawHeader("Content-Type"), "application/json");
+    // Header names are case-insensitive
+    ASSERT_EQ(res.rawHeader("ratelimit-remaining"), "799");
+    ASSERT_TRUE(res.rawHeader("Ratelimit-Reset").isEmpty());
+}
@@ -0,0 +1,110 @@
+#include "debug/Profiler.hpp"
+
+#include "Test.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+TEST(Profiler, Buckets)
+{
+    ASSERT_EQ(Profiler::bucketFor(0), 0);
+    ASSERT_EQ(Profiler::bucketFor(1), 1);
+    ASSERT_EQ(Profiler::bucketFor(2), 2);
+    ASSERT_EQ(Profiler::bucketFor(3), 3);
+    ASSERT_EQ(Profiler::bucketFor(4), 4);
+    ASSERT_EQ(Profiler::bucketFor(5), 4);
+    ASSERT_EQ(Profiler::bucketFor(6), 5);
+    ASSERT_EQ(Profiler::bucketFor(7), 5);
+    ASSERT_EQ(Profiler::bucketFor(8), 6);
+    ASSERT_EQ(Profiler::bucketFor(UINT64_MAX), Profiler::BUCKET_COUNT - 1);
+
+    for (size_t bucket = 0; bucket < Profiler::BUCKET_COUNT; bucket++)
+    {
+        auto lower = Profiler::bucketLowerBound(bucket);
+        ASSERT_EQ(Profiler::bucketFor(lower), bucket);
+        if (bucket > 0)
+        {
+            ASSERT_EQ(Profiler::bucketFor(lower - 1), bucket - 1);
+        }
+    }
+}
+
+TEST(Profiler, Summary)
+{
+    auto &profiler = Profiler::instance();
+    profiler.reset();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 99; i++)
+    {
+        profiler.record(ProfileScope::Paint, start, 1ms);
+    }
+    profiler.record(ProfileScope::Paint, start, 50ms);
+
+    auto summary = profiler.summary(ProfileScope::Paint);
+    ASSERT_EQ(summary.count, 100);
+    ASSERT_EQ(summary.maxNs, 50'000'000);
+    ASSERT_EQ(summary.totalNs, 149'000'000);
+
+    // percentiles are rounded up to the end of their bucket
+    ASSERT_GE(summary.p50Ns, 1'000'000);
+    ASSERT_LT(summary.p50Ns, 1'500'000);
+    ASSERT_EQ(summary.p90Ns, summary.p50Ns);
+    ASSERT_EQ(summary.p99Ns, summary.p50Ns);
+
+    ASSERT_EQ(profiler.summary(ProfileScope::ViewLayout).count, 0);
+
+    profiler.reset();
+    ASSERT_EQ(profiler.summary(ProfileScope::Paint).count, 0);
+}
+
+TEST(Profiler, ChromeTrace)
+{
+    auto &profiler = Profiler::instance();
+    profiler.reset();
+
+    auto start = std::chrono::steady_clock::now();
+    profiler.record(ProfileScope::FilterEvaluation, start, 2us);
+    profiler.record(ProfileScope::HighlightCheck, start + 5us, 3us);
+
+    auto doc = QJsonDocument::fromJson(profiler.toChromeTrace());
+    auto events = doc.object()["traceEvents"].toArray();
+    ASSERT_EQ(events.size(), 2);
+
+    auto first = events[0].toObject();
+    ASSERT_EQ(first["name"].toString(), "filter evaluation");
+    ASSERT_EQ(first["ph"].toString(), "X");
+    ASSERT_DOUBLE_EQ(first["dur"].toDouble(), 2.0);
+
+    auto second = events[1].toObject();
+    ASSERT_EQ(second["name"].toString(), "highlight check");
+    ASSERT_NEAR(second["ts"].toDouble() - first["ts"].toDouble(), 5.0, 0.001);
+
+    profiler.reset();
+}
+
+TEST(Profiler, GuardOnlyRecordsWhenEnabled)
+{
+    auto &profiler = Profiler::instance();
+    profiler.reset();
+
+    int64_t elapsed = -1;
+    {
+        ProfileGuard guard(ProfileScope::BufferUpdate, &elapsed);
+    }
+    ASSERT_GE(elapsed, 0);
+    ASSERT_EQ(profiler.summary(ProfileScope::BufferUpdate).count, 0);
+
+    profiler.setEnabled(true);
+    {
+        ProfileGuard guard(ProfileScope::BufferUpdate);
+    }
+    profiler.setEnabled(false);
+    ASSERT_EQ(profiler.summary(ProfileScope::BufferUpdate).count, 1);
+
+    profiler.reset();
+}
@@ -45,3 +45,30 @@ TEST(RatelimitBucket, BatchTwoParts)
 
     EXPECT_EQ(n, 6);
 }
+
+TEST(RatelimitBucket, SendFirst)
+{
+    const int cooldown = 100;
+    QStringList sent;
+    auto cb = [&sent](QString msg) {
+        sent.append(msg);
+    };
+    auto bucket = std::make_unique<RatelimitBucket>(1, cooldown, cb, nullptr);
+    bucket->send("1");
+    bucket->send("2");
+    bucket->send("3");
+    // Already queued, so this doesn't add another entry
+    bucket->send("2");
+    bucket->sendFirst("3");
+    bucket->sendFirst("4");
+    EXPECT_EQ(sent, QStringList{"1"});
+
+    for (int i = 0; i < 10 && sent.size() < 4; i++)
+    {
+        QCoreApplication::processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds{cooldown});
+        QCoreApplication::processEvents();
+    }
+
+    EXPECT_EQ(sent, (QStringList{"1", "4", "3", "2"}));
+}
@@ -0,0 +1,80 @@
+#include "util/SpscQueue.hpp"
+
+#include "Test.hpp"
+
+#include <QString>
+
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+TEST(SpscQueue, Bounded)
+{
+    SpscQueue<QString> queue(3);
+    ASSERT_EQ(queue.capacity(), 4);
+
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(queue.tryPush(QString::number(i)));
+    }
+    ASSERT_EQ(queue.size(), 4);
+
+    QString rejected = "rejected";
+    ASSERT_FALSE(queue.tryPush(std::move(rejected)));
+    // A rejected value isn't moved from
+    ASSERT_EQ(rejected, "rejected");
+
+    ASSERT_EQ(queue.tryPop(), "0");
+    ASSERT_TRUE(queue.tryPush("4"));
+
+    for (int i = 1; i <= 4; i++)
+    {
+        ASSERT_EQ(queue.tryPop(), QString::number(i));
+    }
+    ASSERT_FALSE(queue.tryPop().has_value());
+    ASSERT_EQ(queue.size(), 0);
+}
+
+TEST(SpscQueue, Threads)
+{
+    constexpr int count = 100000;
+    SpscQueue<int> queue(64);
+
+    std::thread producer([&] {
+        for (int i = 0; i < count;)
+        {
+            if (queue.tryPush(int{i}))
+            {
+                i++;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<int> received;
+    received.reserve(count);
+    while (received.size() < static_cast<size_t>(count))
+    {
+        if (auto value = queue.tryPop())
+        {
+            received.push_back(*value);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    ASSERT_EQ(queue.size(), 0);
+
+    // Everything arrives exactly once and in order
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(received[i], i);
+    }
+}
@@ -144,11 +144,13 @@ TEST(TwitchIrc, BadgeInfoParsing)
         auto *privmsg =
             Communi::IrcPrivateMessage::fromData(test.input, nullptr);
 
-        auto outputBadgeInfo = parseBadgeInfoTag(privmsg->tags());
+        auto tags = TwitchIrcTags::fromMessage(privmsg);
+
+        auto outputBadgeInfo = parseBadgeInfoTag(tags);
         EXPECT_EQ(outputBadgeInfo, test.expectedBadgeInfo)
             << "Input for badgeInfo " << test.input << " failed";
 
-        auto outputBadges = parseBadgeTag(privmsg->tags());
+        auto outputBadges = parseBadgeTag(tags);
         EXPECT_EQ(outputBadges, test.expectedBadges)
             << "Input for badges " << test.input << " failed";
 
@@ -326,7 +328,8 @@ TEST_F(TestTwitchIrc, ParseTwitchEmotes)
 
         // TODO: Add tests with replies
         auto actualTwitchEmotes =
-            parseTwitchEmotes(privmsg->tags(), originalMessage, 0);
+            parseTwitchEmotes(TwitchIrcTags::fromMessage(privmsg),
+                              originalMessage, 0);
 
         EXPECT_EQ(actualTwitchEmotes, test.expectedTwitchEmotes)
             << "Input for twitch emotes " << test.input << " failed";
@@ -334,3 +337,47 @@ TEST_F(TestTwitchIrc, ParseTwitchEmotes)
         delete privmsg;
     }
 }
+
+TEST(TwitchIrc, Tags)
+{
+    using Tag = TwitchIrcTags::Tag;
+
+    auto tags = TwitchIrcTags::fromLine(
+        uR"(@badge-info=;badges=vip/1;color=;display-name=Some\sName;emote-only=1;flags;reply-parent-msg-body=a\:b\\c\s;room-id=11148817;room-id=1 :pajlada!pajlada@pajlada.tmi.twitch.tv PRIVMSG #pajlada :@x=y)");
+
+    ASSERT_TRUE(tags.has(Tag::Badges));
+    ASSERT_EQ(tags.value(Tag::Badges), u"vip/1");
+
+    // Empty values are set
+    ASSERT_TRUE(tags.has(Tag::BadgeInfo));
+    ASSERT_TRUE(tags.value(Tag::BadgeInfo).isEmpty());
+    ASSERT_TRUE(tags.has(Tag::Color));
+    ASSERT_TRUE(tags.has(u"flags"));
+    ASSERT_TRUE(tags.value(u"flags").isEmpty());
+
+    ASSERT_FALSE(tags.has(Tag::Emotes));
+    ASSERT_TRUE(tags.value(Tag::Emotes).isNull());
+    ASSERT_FALSE(tags.has(u"x"));
+
+    // Tags without a slot
+    ASSERT_TRUE(tags.has(u"emote-only"));
+    ASSERT_EQ(tags.value(u"emote-only"), u"1");
+
+    // The last value wins
+    ASSERT_EQ(tags.value(Tag::RoomId), u"1");
+    ASSERT_EQ(tags.value(u"room-id"), u"1");
+
+    // Values are unescaped on request
+    ASSERT_EQ(tags.value(Tag::DisplayName), uR"(Some\sName)");
+    ASSERT_EQ(tags.unescaped(Tag::DisplayName), u"Some Name");
+    ASSERT_EQ(tags.unescaped(Tag::ReplyParentMsgBody), uR"(a;b\c )");
+    ASSERT_EQ(TwitchIrcTags::unescape(uR"(a\b\)"), u"ab");
+
+    bool ok = false;
+    ASSERT_EQ(tags.integer(Tag::RoomId, &ok), 1);
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(tags.integer(Tag::Emotes, &ok), 0);
+    ASSERT_FALSE(ok);
+
+    ASSERT_FALSE(TwitchIrcTags::fromLine(u":a!a@a PRIVMSG #a :b").has(u"a"));
+}
@@ -0,0 +1,103 @@
+#include "providers/twitch/TwitchUsersCache.hpp"
+
+#include "Test.hpp"
+
+#include <QTemporaryDir>
+
+using namespace chatterino;
+using namespace chatterino::twitchusers::detail;
+
+namespace {
+
+CachedUser makeUser(const QString &id, const QDateTime &resolvedAt)
+{
+    return {
+        .id = id,
+        .login = "user" + id,
+        .displayName = "User" + id,
+        .resolvedAt = resolvedAt,
+    };
+}
+
+}  // namespace
+
+TEST(TwitchUsersCache, RoundTrip)
+{
+    const auto now = QDateTime::fromString("2025-03-01T18:00:00Z", Qt::ISODate);
+
+    auto users =
+        parseUserCache(serializeUserCache({makeUser("1", now.addDays(-1))}),
+                       now);
+    ASSERT_EQ(users.size(), 1);
+    ASSERT_EQ(users[0].id, "1");
+    ASSERT_EQ(users[0].login, "user1");
+    ASSERT_EQ(users[0].displayName, "User1");
+    ASSERT_EQ(users[0].resolvedAt, now.addDays(-1));
+}
+
+TEST(TwitchUsersCache, Expiry)
+{
+    const auto now = QDateTime::fromString("2025-03-01T18:00:00Z", Qt::ISODate);
+
+    // Users that weren't resolved for 30 days are dropped
+    auto users = parseUserCache(serializeUserCache({
+                                    makeUser("1", now.addDays(-29)),
+                                    makeUser("2", now.addDays(-30)),
+                                }),
+                                now);
+    ASSERT_EQ(users.size(), 1);
+    ASSERT_EQ(users[0].id, "1");
+}
+
+TEST(TwitchUsersCache, MaxUsers)
+{
+    const auto now = QDateTime::fromString("2025-03-01T18:00:00Z", Qt::ISODate);
+
+    std::vector<CachedUser> users;
+    for (size_t i = 0; i < MAX_CACHED_USERS + 10; i++)
+    {
+        // The first users were resolved the longest time ago
+        users.emplace_back(makeUser(
+            QString::number(i),
+            now.addSecs(static_cast<qint64>(i) -
+                        static_cast<qint64>(MAX_CACHED_USERS) - 10)));
+    }
+
+    auto parsed = parseUserCache(serializeUserCache(users), now);
+    ASSERT_EQ(parsed.size(), MAX_CACHED_USERS);
+    for (const auto &user : parsed)
+    {
+        ASSERT_GE(user.id.toInt(), 10);
+    }
+}
+
+TEST(TwitchUsersCache, Invalid)
+{
+    const auto now = QDateTime::fromString("2025-03-01T18:00:00Z", Qt::ISODate);
+
+    ASSERT_TRUE(parseUserCache("", now).empty());
+    ASSERT_TRUE(parseUserCache("{", now).empty());
+    ASSERT_TRUE(parseUserCache(R"({"version":0,"users":[]})", now).empty());
+
+    // Users without an ID or login are skipped
+    auto noLogin = makeUser("1", now);
+    noLogin.login.clear();
+    ASSERT_TRUE(
+        parseUserCache(serializeUserCache({makeUser("", now), noLogin}), now)
+            .empty());
+}
+
+TEST(TwitchUsersCache, File)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("twitch-users.json");
+
+    ASSERT_TRUE(loadUserCache(path).empty());
+
+    auto now = QDateTime::currentDateTimeUtc();
+    saveUserCache(path, {makeUser("1", now), makeUser("2", now)});
+
+    auto users = loadUserCache(path);
+    ASSERT_EQ(users.size(), 2);
+}
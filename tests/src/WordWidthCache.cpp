@@ -0,0 +1,58 @@
+#include "messages/layouts/WordWidthCache.hpp"
+
+#include "singletons/Fonts.hpp"
+#include "Test.hpp"
+
+#include <QFont>
+#include <QFontMetrics>
+
+using namespace chatterino;
+
+TEST(WordWidthCache, MeasuresSynchronously)
+{
+    WordWidthCache cache;
+    QFont font;
+    QFontMetrics metrics(font);
+
+    ASSERT_FALSE(cache.find(FontStyle::ChatMedium, 1, "forsen"));
+
+    auto width = cache.width(FontStyle::ChatMedium, 1, metrics, "forsen");
+    ASSERT_EQ(width, metrics.horizontalAdvance("forsen"));
+    ASSERT_EQ(cache.find(FontStyle::ChatMedium, 1, "forsen"), width);
+
+    // different scales and styles are cached separately
+    ASSERT_FALSE(cache.find(FontStyle::ChatMedium, 2, "forsen"));
+    ASSERT_FALSE(cache.find(FontStyle::ChatMediumBold, 1, "forsen"));
+}
+
+TEST(WordWidthCache, MeasuresAsync)
+{
+    WordWidthCache cache;
+    QFont font;
+    QFontMetrics metrics(font);
+
+    std::vector<WordWidthCache::Batch> batches{{
+        .style = FontStyle::ChatMedium,
+        .font = font,
+        .words = {"pajaW", "Kappa", "forsenE"},
+    }};
+    cache.measureAsync(1, std::move(batches), {});
+    cache.waitForDone();
+
+    for (const auto *word : {"pajaW", "Kappa", "forsenE"})
+    {
+        ASSERT_EQ(cache.find(FontStyle::ChatMedium, 1, word),
+                  metrics.horizontalAdvance(word));
+    }
+}
+
+TEST(WordWidthCache, Clear)
+{
+    WordWidthCache cache;
+    QFont font;
+    QFontMetrics metrics(font);
+
+    cache.width(FontStyle::ChatMedium, 1, metrics, "forsen");
+    cache.clear();
+    ASSERT_FALSE(cache.find(FontStyle::ChatMedium, 1, "forsen"));
+}